@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_ASYNC_PIPELINE_H
+#define GRPPI_ASYNC_PIPELINE_H
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "grppi/common/async_pipeline.h"
+#include "grppi/common/configuration.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/patterns.h"
+
+namespace grppi {
+
+/**
+\addtogroup stream_patterns
+@{
+\defgroup async_pipeline_pattern Asynchronous pipeline pattern
+\brief Interface for applying the \ref md_async-pipeline.
+@{
+*/
+
+/**
+\brief Start a \ref md_pipeline that runs in the background until it is
+closed, and return a handle to push items into it.
+The type of the pushed items is deduced from the first stage, which cannot be
+a generic lambda. Up to GRPPI_QUEUE_SIZE pushed items may wait to enter the
+pipeline.
+\tparam Execution Execution type.
+\tparam Transformer Callable type for the first stage.
+\tparam Transformers Callable types for the other stages.
+\param ex Execution policy object. It must outlive the returned handle.
+\param transform_op First stage of the pipeline.
+\param transform_ops Other stages of the pipeline.
+\return A grppi::async_pipeline handle.
+*/
+template <typename Execution, typename Transformer, typename ... Transformers,
+          requires_execution_supported<std::decay_t<Execution>> = 0>
+auto make_async_pipeline(
+    const Execution & ex,
+    Transformer && transform_op,
+    Transformers && ... transform_ops)
+{
+  static_assert(supports_pipeline<std::decay_t<Execution>>(),
+      "pipeline pattern is not supported by execution type");
+  using input_type = internal::stage_input_t<Transformer>;
+  using output_type = typename internal::chain_output<input_type,
+      std::tuple<std::decay_t<Transformer>,
+          std::decay_t<Transformers>...>>::type;
+  static_assert(std::is_void_v<output_type> || !(
+      ((is_filter<Transformer> || is_reduce<Transformer> ||
+        is_time_reduce<Transformer> || is_flat_map<Transformer> ||
+        is_batch<Transformer> || is_split<Transformer> ||
+        is_join<Transformer> || is_keyed<Transformer>) || ... ||
+       (is_filter<Transformers> || is_reduce<Transformers> ||
+        is_time_reduce<Transformers> || is_flat_map<Transformers> ||
+        is_batch<Transformers> || is_split<Transformers> ||
+        is_join<Transformers> || is_keyed<Transformers>))),
+      "Futures of an async pipeline need one output per item");
+
+  return async_pipeline<input_type, output_type>{ex,
+      configuration<>{}.queue_size(),
+      std::forward<Transformer>(transform_op),
+      std::forward<Transformers>(transform_ops)...};
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_ACCUMULATE_H
+#define GRPPI_COMMON_ACCUMULATE_H
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Combine a value into an accumulator.
+Three forms of combiner are supported:
+  - A combiner returning a new value `Acc(const Acc &, const T &)`. The result
+  is assigned to the accumulator.
+  - An in-place combiner `void(Acc &, const T &)` (or `void(Acc &, Acc &&)`
+  for partial results). The accumulator is updated without copies.
+  - An in-place combiner returning a reference to the accumulator
+  `Acc &(Acc &, const T &)`. The result is only assigned if the combiner
+  returns a reference to a different object.
+*/
+template <typename Combiner, typename Acc, typename T>
+void combine_into(Combiner && combine_op, Acc & acc, T && x)
+{
+  using result_type = decltype(combine_op(acc, std::forward<T>(x)));
+  if constexpr (std::is_void<result_type>::value) {
+    combine_op(acc, std::forward<T>(x));
+  }
+  else if constexpr (std::is_same<result_type, Acc &>::value) {
+    auto & result = combine_op(acc, std::forward<T>(x));
+    if (&result != &acc) { acc = result; }
+  }
+  else {
+    acc = combine_op(acc, std::forward<T>(x));
+  }
+}
+
+/**
+\brief Combine a partial result into an accumulator.
+The partial result is moved into the combiner, unless it only accepts
+lvalues.
+*/
+template <typename Combiner, typename Acc, typename T>
+void combine_partial(Combiner && combine_op, Acc & acc, T & partial)
+{
+  if constexpr (std::is_invocable<Combiner &, Acc &, T &&>::value) {
+    combine_into(combine_op, acc, std::move(partial));
+  }
+  else {
+    combine_into(combine_op, acc, partial);
+  }
+}
+
+/**
+\brief Combine a sequence of partial results into an accumulator.
+\return The accumulated value.
+*/
+template <typename Iterator, typename Acc, typename Combiner>
+Acc combine_partials(Iterator first, Iterator last, Acc acc,
+    Combiner && combine_op)
+{
+  for (; first != last; ++first) {
+    combine_partial(combine_op, acc, *first);
+  }
+  return acc;
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
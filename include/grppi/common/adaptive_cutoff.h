@@ -0,0 +1,266 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_ADAPTIVE_CUTOFF_H
+#define GRPPI_COMMON_ADAPTIVE_CUTOFF_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace grppi {
+
+namespace internal {
+
+template <typename T, typename = void>
+struct has_size : std::false_type {};
+
+template <typename T>
+struct has_size<T, std::void_t<decltype(std::declval<const T&>().size())>> 
+  : std::true_type {};
+
+/**
+\brief Default estimator for the size of a divide/conquer problem.
+Problems with a size() member use it. Arithmetic problems are their own size.
+*/
+struct default_size_estimator {
+  template <typename Problem>
+  std::size_t operator()(const Problem & problem) const
+  {
+    if constexpr (has_size<Problem>::value) {
+      return static_cast<std::size_t>(problem.size());
+    }
+    else {
+      static_assert(std::is_arithmetic<Problem>::value,
+          "A size estimator is needed for problems without a size() member");
+      return problem > Problem{} ? static_cast<std::size_t>(problem) : 0;
+    }
+  }
+};
+
+}
+
+/**
+\brief Granularity controller for an adaptive divide/conquer.
+The controller samples the time needed to solve problems sequentially and the
+overhead of spawning tasks in the execution policy. From those samples it 
+learns a problem size (the cutoff) below which problems are solved with 
+sequential recursion instead of being divided into parallel tasks.
+The same controller may be reused for several runs, so that each run starts 
+with what was learned in the previous ones.
+\tparam SizeEstimator Callable type estimating the size of a problem.
+*/
+template <typename SizeEstimator = internal::default_size_estimator>
+class adaptive_cutoff {
+public:
+
+  /**
+  \brief Construct a controller.
+  \param size_op Size estimator for problems.
+  \param overhead_factor Minimum ratio between the sequential work of a task
+  and the task overhead.
+  */
+  explicit adaptive_cutoff(SizeEstimator size_op = SizeEstimator{}, 
+                           double overhead_factor = 10.0) :
+    size_op_{std::move(size_op)}, overhead_factor_{overhead_factor}
+  {}
+
+  adaptive_cutoff(const adaptive_cutoff &) = delete;
+  adaptive_cutoff & operator=(const adaptive_cutoff &) = delete;
+
+  /**
+  \brief Get the learned cutoff.
+  Problems whose size is not greater than the cutoff are solved sequentially. 
+  A value of 0 means that nothing has been learned yet.
+  */
+  std::size_t cutoff() const noexcept
+  {
+    const auto sampled_size = sampled_size_.load(std::memory_order_relaxed);
+    const auto sampled_ns = sampled_ns_.load(std::memory_order_relaxed);
+    if (sampled_size == 0 || sampled_ns == 0) return 0;
+    const double cost = static_cast<double>(sampled_ns) / sampled_size;
+    const double size = overhead_factor_ * 
+        overhead_ns_.load(std::memory_order_relaxed) / cost;
+    const auto limit = limit_.load(std::memory_order_relaxed);
+    return size >= limit ? limit : std::max<std::size_t>(1, static_cast<std::size_t>(size));
+  }
+
+  /// Get the measured overhead of spawning and joining a task.
+  std::chrono::nanoseconds task_overhead() const noexcept
+  {
+    return std::chrono::nanoseconds{overhead_ns_.load(std::memory_order_relaxed)};
+  }
+
+  /// Get the estimated sequential solve time per unit of problem size.
+  std::chrono::duration<double,std::nano> unit_cost() const noexcept
+  {
+    const auto sampled_size = sampled_size_.load(std::memory_order_relaxed);
+    if (sampled_size == 0) return std::chrono::duration<double,std::nano>{0};
+    return std::chrono::duration<double,std::nano>{
+        static_cast<double>(sampled_ns_.load(std::memory_order_relaxed)) / 
+        sampled_size};
+  }
+
+  /// Get the number of sequential solves sampled so far.
+  std::size_t samples() const noexcept 
+  { 
+    return samples_.load(std::memory_order_relaxed); 
+  }
+
+  /// Estimate the size of a problem.
+  template <typename Problem>
+  std::size_t size(const Problem & problem) const 
+  { 
+    return size_op_(problem); 
+  }
+
+  /// Record the time needed to sequentially solve a problem of a given size.
+  void record(std::size_t size, std::chrono::nanoseconds time) noexcept
+  {
+    sampled_size_.fetch_add(size, std::memory_order_relaxed);
+    sampled_ns_.fetch_add(std::max<long long>(time.count(),1), 
+        std::memory_order_relaxed);
+    samples_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Check if the task overhead has already been measured.
+  bool has_task_overhead() const noexcept 
+  { 
+    return overhead_ns_.load(std::memory_order_relaxed) > 0;
+  }
+
+  /// Set the measured overhead of spawning and joining a task.
+  void set_task_overhead(std::chrono::nanoseconds overhead) noexcept
+  {
+    overhead_ns_.store(std::max<long long>(overhead.count(),1), 
+        std::memory_order_relaxed);
+  }
+
+  /**
+  \brief Set an upper bound for the cutoff.
+  The bound keeps enough parallel tasks for every worker when the tasks 
+  overhead is large compared to the whole problem.
+  */
+  void set_limit(std::size_t limit) noexcept 
+  { 
+    limit_.store(std::max<std::size_t>(limit,1), std::memory_order_relaxed);
+  }
+
+private:
+  SizeEstimator size_op_;
+  double overhead_factor_;
+  std::atomic<long long> overhead_ns_{0};
+  std::atomic<unsigned long long> sampled_ns_{0};
+  std::atomic<unsigned long long> sampled_size_{0};
+  std::atomic<std::size_t> samples_{0};
+  std::atomic<std::size_t> limit_{std::numeric_limits<std::size_t>::max()};
+};
+
+/**
+\brief Make a granularity controller for an adaptive divide/conquer.
+\param size_op Size estimator for problems.
+\param overhead_factor Minimum ratio between the sequential work of a task
+and the task overhead.
+*/
+template <typename SizeEstimator>
+auto make_adaptive_cutoff(SizeEstimator && size_op, double overhead_factor = 10.0)
+{
+  return adaptive_cutoff<std::decay_t<SizeEstimator>>{
+      std::forward<SizeEstimator>(size_op), overhead_factor};
+}
+
+namespace internal {
+
+/**
+\brief Measure the overhead of spawning and joining a task in an execution.
+The overhead is taken as the best time of a few runs of a divide/conquer 
+with two empty subproblems.
+*/
+template <typename Execution>
+std::chrono::nanoseconds divide_conquer_overhead(const Execution & ex)
+{
+  using namespace std::chrono;
+  constexpr int overhead_runs = 3;
+  auto best = nanoseconds::max();
+  for (int i=0; i<overhead_runs; ++i) {
+    const auto start = steady_clock::now();
+    ex.divide_conquer(0,
+        [](int) { return std::vector<int>{1,1}; },
+        [](int x) { return x>0; },
+        [](int x) { return x; },
+        [](int x, int y) { return x+y; });
+    best = std::min(best, duration_cast<nanoseconds>(steady_clock::now() - start));
+  }
+  return best;
+}
+
+/**
+\brief Divide/conquer with a learned granularity.
+Problems not greater than the current cutoff are seen as elemental by the
+execution policy, and solved with sequential recursion. Every sequential
+solve is timed and sampled by the cutoff controller, so that the cutoff is
+refined while the problem is being solved.
+\param seq Sequential execution policy used for the recursion below the
+cutoff.
+*/
+template <typename Execution, typename Sequential, typename Input, 
+          typename Divider, typename Predicate, typename Solver, 
+          typename Combiner, typename SizeEstimator>
+auto adaptive_divide_conquer(
+    const Execution & ex,
+    const Sequential & seq,
+    Input && input,
+    Divider && divide_op,
+    Predicate && predicate_op,
+    Solver && solve_op,
+    Combiner && combine_op,
+    adaptive_cutoff<SizeEstimator> & cutoff)
+{
+  using namespace std::chrono;
+  if (!cutoff.has_task_overhead()) {
+    cutoff.set_task_overhead(divide_conquer_overhead(ex));
+  }
+  const std::size_t tasks = 4 * std::max(ex.concurrency_degree(), 1);
+  cutoff.set_limit(cutoff.size(input) / tasks);
+
+  return ex.divide_conquer(std::forward<Input>(input),
+      divide_op,
+      [&](const auto & problem) {
+        return predicate_op(problem) || cutoff.size(problem) <= cutoff.cutoff();
+      },
+      [&](auto && problem) {
+        const auto size = cutoff.size(problem);
+        const auto start = steady_clock::now();
+        auto result = predicate_op(problem) ?
+            solve_op(std::forward<decltype(problem)>(problem)) :
+            seq.divide_conquer(std::forward<decltype(problem)>(problem),
+                divide_op, predicate_op, solve_op, combine_op);
+        cutoff.record(size, 
+            duration_cast<nanoseconds>(steady_clock::now() - start));
+        return result;
+      },
+      combine_op);
+}
+
+}
+
+}
+
+#endif
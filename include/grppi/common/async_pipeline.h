@@ -0,0 +1,217 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_ASYNC_PIPELINE_H
+#define GRPPI_COMMON_ASYNC_PIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "optional.h"
+
+namespace grppi {
+
+namespace internal {
+
+template <typename Execution>
+auto is_ordered_execution(const Execution & ex, int)
+    -> decltype(ex.is_ordered())
+{
+  return ex.is_ordered();
+}
+
+template <typename Execution>
+bool is_ordered_execution(const Execution &, long) { return true; }
+
+}
+
+/**
+\brief Handle to a pipeline running in the background.
+External threads push items into the pipeline, which keeps its stage threads
+running until it is closed.
+
+When the last stage produces a value, every push returns a future for the
+output of the item. Futures are fulfilled in push order, so that every item
+must produce exactly one output and the execution policy must be ordered.
+When the last stage is a consumer, it acts as the callback for the results.
+\tparam Input Type of the items pushed into the pipeline.
+\tparam Output Type of the outputs of the last stage, or void.
+*/
+template <typename Input, typename Output>
+class async_pipeline {
+public:
+
+  using input_type = Input;
+  using output_type = Output;
+
+  /// Result of a push: a future for the output, or whether it was accepted.
+  using push_result = std::conditional_t<std::is_void_v<Output>,
+      bool, std::future<Output>>;
+
+  /**
+  \brief Starts a pipeline in the background.
+  \param ex Execution policy object. It must outlive the pipeline.
+  \param capacity Maximum number of pushed items waiting to enter the
+  pipeline.
+  \param stages Stages of the pipeline.
+  \throw std::invalid_argument if futures are requested on an execution
+  policy that is not ordered.
+  */
+  template <typename Execution, typename ... Stages>
+  async_pipeline(const Execution & ex, int capacity, Stages && ... stages) :
+    capacity_{static_cast<std::size_t>(capacity > 0 ? capacity : 1)}
+  {
+    if (!std::is_void_v<Output> && !internal::is_ordered_execution(ex,0)) {
+      throw std::invalid_argument{
+          "Futures of an async pipeline need an ordered execution"};
+    }
+    runner_ = std::thread{
+      [this, &ex, stages = std::make_tuple(std::forward<Stages>(stages)...)]
+      () mutable {
+        std::apply([&](auto && ... s) { run(ex, std::move(s)...); },
+            std::move(stages));
+      }};
+  }
+
+  async_pipeline(const async_pipeline &) = delete;
+  async_pipeline & operator=(const async_pipeline &) = delete;
+
+  /**
+  \brief Closes the pipeline and waits until it is drained.
+  */
+  ~async_pipeline() { close(); }
+
+  /**
+  \brief Pushes an item, waiting while the pipeline is full.
+  \param item Data item.
+  \return A future for the output of the item, which is not valid if the
+  pipeline was closed. For a pipeline ending in a consumer, whether the item
+  was accepted.
+  */
+  push_result push(Input item) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    not_full_.wait(lock, [this] {
+      return closed_ || items_.size() < capacity_; });
+    if (closed_) { return {}; }
+    return enqueue(std::move(item));
+  }
+
+  /**
+  \brief Pushes an item only if the pipeline is not full.
+  \param item Data item.
+  \return A future for the output of the item, which is not valid if the
+  item was rejected. For a pipeline ending in a consumer, whether the item
+  was accepted.
+  */
+  push_result try_push(Input item) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    if (closed_ || items_.size() >= capacity_) { return {}; }
+    return enqueue(std::move(item));
+  }
+
+  /**
+  \brief Stops accepting items and waits until every pushed item has gone
+  through the pipeline.
+  */
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+    std::call_once(drained_, [this] { runner_.join(); });
+  }
+
+  /**
+  \brief Checks if the pipeline was closed.
+  */
+  bool is_closed() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return closed_;
+  }
+
+private:
+
+  template <typename Execution, typename ... Stages>
+  void run(const Execution & ex, Stages && ... stages) {
+    auto generator = [this]() { return next(); };
+    if constexpr (std::is_void_v<Output>) {
+      ex.pipeline(generator, std::forward<Stages>(stages)...);
+    }
+    else {
+      ex.pipeline(generator, std::forward<Stages>(stages)...,
+          [this](Output out) { fulfill(std::move(out)); });
+    }
+  }
+
+  push_result enqueue(Input && item) {
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+    if constexpr (std::is_void_v<Output>) {
+      return true;
+    }
+    else {
+      promises_.emplace_back();
+      return promises_.back().get_future();
+    }
+  }
+
+  grppi::optional<Input> next() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) { return {}; }
+    grppi::optional<Input> item{std::move(items_.front())};
+    items_.pop_front();
+    not_full_.notify_one();
+    return item;
+  }
+
+  template <typename T>
+  void fulfill(T && out) {
+    std::promise<Output> promise;
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      promise = std::move(promises_.front());
+      promises_.pop_front();
+    }
+    promise.set_value(std::forward<T>(out));
+  }
+
+private:
+  std::size_t capacity_;
+
+  mutable std::mutex mutex_{};
+  std::condition_variable not_full_{};
+  std::condition_variable not_empty_{};
+  std::deque<Input> items_{};
+  std::deque<std::promise<Output>> promises_{};
+  bool closed_ = false;
+
+  std::once_flag drained_{};
+  std::thread runner_{};
+};
+
+}
+
+#endif
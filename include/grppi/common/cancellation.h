@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_CANCELLATION_H
+#define GRPPI_COMMON_CANCELLATION_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace grppi {
+
+/**
+\brief A shared flag used to request that a computation stops.
+Copies of a token share the same state. Any copy may cancel the
+computation and every copy observes the cancellation.
+*/
+class cancellation_token {
+public:
+
+  /// Construct a non cancelled token.
+  cancellation_token() :
+    cancelled_{std::make_shared<std::atomic<bool>>(false)}
+  {}
+
+  /// Request the cancellation.
+  void cancel() const noexcept { 
+    cancelled_->store(true, std::memory_order_release); 
+  }
+
+  /// Check if cancellation was requested.
+  bool is_cancelled() const noexcept { 
+    return cancelled_->load(std::memory_order_acquire); 
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+/**
+\brief Generator adapter stopping the generation of items once a
+cancellation token has been cancelled.
+\tparam Generator Callable type of the adapted generator.
+*/
+template <typename Generator>
+class cancellable_generator {
+public:
+
+  using result_type = decltype(std::declval<Generator&>()());
+
+  cancellable_generator(cancellation_token token, Generator generate_op) :
+    token_{std::move(token)}, generate_op_{std::move(generate_op)}
+  {}
+
+  /**
+  \brief Generate the next item.
+  \return The item generated by the adapted generator, or an empty value if 
+  the token was cancelled.
+  */
+  result_type operator()() {
+    if (token_.is_cancelled()) { return {}; }
+    return generate_op_();
+  }
+
+private:
+  cancellation_token token_;
+  Generator generate_op_;
+};
+
+/**
+\brief Adapt a generator of a pipeline so that no more items are generated
+once a token is cancelled.
+\param token Cancellation token to be observed.
+\param generate_op Generator operation.
+*/
+template <typename Generator>
+auto cancellable(cancellation_token token, Generator && generate_op)
+{
+  return cancellable_generator<std::decay_t<Generator>>{
+      std::move(token), std::forward<Generator>(generate_op)};
+}
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_COMPACTION_H
+#define GRPPI_COMMON_COMPACTION_H
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Copy the elements satisfying a predicate keeping their relative order.
+The sequence is split into one chunk per worker and processed in three steps:
+  1. Every chunk evaluates the predicate on its elements, keeping a flag per
+  element, and counts the elements to be kept.
+  2. An exclusive scan of the counts gives the output position of every chunk.
+  3. Every chunk writes its kept elements starting at its output position.
+
+Steps 1 and 3 are run with the map pattern of the execution policy. The
+predicate is evaluated once per element.
+\return The number of elements written.
+*/
+template <typename Execution, typename InputIterator, typename OutputIterator,
+    typename Predicate>
+std::size_t copy_if(const Execution & ex, InputIterator first, 
+    std::size_t sequence_size, OutputIterator first_out,
+    Predicate && predicate_op)
+{
+  if (sequence_size == 0) { return 0; }
+
+  const auto num_chunks = std::min(sequence_size, static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree())));
+  const auto chunk_size = sequence_size / num_chunks;
+  auto chunk_bounds = [&](std::size_t c) {
+    const auto lo = c * chunk_size;
+    const auto hi = (c == num_chunks - 1) ? sequence_size : lo + chunk_size;
+    return std::make_pair(lo, hi);
+  };
+
+  std::vector<unsigned char> keep(sequence_size);
+  std::vector<std::size_t> chunks(num_chunks);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  std::vector<std::size_t> offsets(num_chunks);
+
+  ex.map(std::make_tuple(chunks.begin()), offsets.begin(), num_chunks,
+    [&](std::size_t c) {
+      const auto [lo, hi] = chunk_bounds(c);
+      std::size_t count = 0;
+      auto it = std::next(first, lo);
+      for (auto i = lo; i < hi; ++i, ++it) {
+        keep[i] = predicate_op(*it) ? 1 : 0;
+        count += keep[i];
+      }
+      return count;
+    });
+
+  const auto last_count = offsets.back();
+  std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 
+      std::size_t{0});
+  const auto total = offsets.back() + last_count;
+
+  // Chunk ids are written back to its own sequence, as map is only used
+  // for its side effects.
+  ex.map(std::make_tuple(chunks.begin()), chunks.begin(), num_chunks,
+    [&](std::size_t c) {
+      const auto [lo, hi] = chunk_bounds(c);
+      auto it = std::next(first, lo);
+      auto out = std::next(first_out, offsets[c]);
+      for (auto i = lo; i < hi; ++i, ++it) {
+        if (keep[i]) { *out++ = *it; }
+      }
+      return c;
+    });
+
+  return total;
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -70,6 +70,22 @@ constexpr bool supports_stencil() { return false; }
 template <typename E>
 constexpr bool supports_divide_conquer() { return false; }
 
+/**
+\brief Determines if an execution policy supports the in place 
+divide-conquer pattern.
+\note This must be specialized by every execution policy supporting the pattern.
+*/
+template <typename E>
+constexpr bool supports_inplace_divide_conquer() { return false; }
+
+/**
+\brief Determines if an execution policy supports the memoized 
+divide-conquer pattern.
+\note This must be specialized by every execution policy supporting the pattern.
+*/
+template <typename E>
+constexpr bool supports_memoized_divide_conquer() { return false; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note This must be specialized by every execution policy supporting the pattern.
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_FLAT_MAP_PATTERN_H
+#define GRPPI_COMMON_FLAT_MAP_PATTERN_H
+
+#include <chrono>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "meta.h"
+
+namespace grppi {
+
+/**
+\brief Output sink of a flat map stage.
+A sink is a lightweight reference to the callable that sends an item to the
+next stage of a pipeline. It is only valid during the call to the stage.
+\tparam T Type of the items sent through the sink.
+*/
+template <typename T>
+class sink {
+public:
+
+  using value_type = T;
+
+  /**
+  \brief Constructs a sink referring to a callable.
+  \param f Callable taking every item sent through the sink.
+  */
+  template <typename F,
+            std::enable_if_t<!std::is_same<std::decay_t<F>,sink>::value,int> = 0>
+  sink(F & f) noexcept :
+    target_{const_cast<void*>(static_cast<const void*>(&f))},
+    push_{[](void * p, T && item) { (*static_cast<F*>(p))(std::move(item)); }}
+  {}
+
+  /**
+  \brief Sends an item to the next stage.
+  \param item Data item.
+  */
+  void operator()(T item) const { push_(target_, std::move(item)); }
+
+private:
+  void * target_;
+  void (*push_)(void *, T &&);
+};
+
+namespace internal {
+
+template <typename F>
+struct flat_map_sink;
+
+template <typename R, typename A, typename S>
+struct flat_map_sink<R(*)(A,S)> { using type = std::decay_t<S>; };
+
+template <typename R, typename C, typename A, typename S>
+struct flat_map_sink<R(C::*)(A,S)> { using type = std::decay_t<S>; };
+
+template <typename R, typename C, typename A, typename S>
+struct flat_map_sink<R(C::*)(A,S) const> { using type = std::decay_t<S>; };
+
+template <typename F, typename = void>
+struct flat_map_sink_of : flat_map_sink<std::decay_t<F>> {};
+
+template <typename F>
+struct flat_map_sink_of<F, std::void_t<decltype(&std::decay_t<F>::operator())>> :
+  flat_map_sink<decltype(&std::decay_t<F>::operator())> {};
+
+}
+
+/**
+\brief Representation of a flat map pattern.
+Represents a stage producing zero or more outputs for every input item.
+The transformer takes an item and a \ref sink, through which it sends its
+outputs.
+\tparam Transformer Callable type taking an item and a sink.
+*/
+template <typename Transformer>
+class flat_map_t {
+public:
+
+  using input_type = std::decay_t<meta::input_type<Transformer>>;
+  using sink_type = typename internal::flat_map_sink_of<Transformer>::type;
+  using output_type = typename sink_type::value_type;
+
+  /**
+  \brief Constructs a flat map.
+  \param transform_op Transformer taking an item and a sink.
+  */
+  flat_map_t(Transformer transform_op) :
+    transform_op_{std::move(transform_op)}
+  {}
+
+  /**
+  \brief Applies the transformer to an item.
+  \param item Data item.
+  \param emit Callable taking every output of the item.
+  */
+  template <typename Emit>
+  void operator()(const input_type & item, Emit && emit) {
+    sink_type out{emit};
+    transform_op_(item, out);
+  }
+
+private:
+  Transformer transform_op_;
+};
+
+/**
+\brief Representation of a batching pattern.
+Represents a stage grouping consecutive items into batches. A batch is
+emitted when it has the given number of items, or when a timeout has elapsed
+since its first item arrived. A partial batch is also emitted at the end of
+the stream.
+\tparam T Type of the items.
+*/
+template <typename T>
+class batch_t {
+public:
+
+  using clock_type = std::chrono::steady_clock;
+  using input_type = T;
+  using output_type = std::vector<T>;
+
+  /**
+  \brief Constructs a batching stage.
+  \param n Maximum number of items in a batch.
+  \param timeout Maximum time a batch waits for more items. Zero disables
+  the timeout.
+  */
+  batch_t(int n, clock_type::duration timeout) :
+    size_{n>0 ? n : 1}, timeout_{timeout}
+  {}
+
+  /**
+  \brief Maximum number of items in a batch.
+  */
+  int size() const noexcept { return size_; }
+
+  /**
+  \brief Maximum time a batch waits for more items.
+  */
+  clock_type::duration timeout() const noexcept { return timeout_; }
+
+  /**
+  \brief Adds an item to the current batch.
+  \param item Data item.
+  */
+  template <typename Item>
+  void add_item(Item && item) {
+    if (items_.empty()) {
+      items_.reserve(size_);
+      start_ = clock_type::now();
+    }
+    items_.push_back(std::forward<Item>(item));
+  }
+
+  /**
+  \brief Checks if the current batch is full.
+  */
+  bool full() const noexcept {
+    return static_cast<int>(items_.size()) >= size_;
+  }
+
+  /**
+  \brief Checks if the current batch has to be emitted at a given time.
+  \param now Time point at which the batch is checked.
+  */
+  bool batch_ready(clock_type::time_point now = clock_type::now()) const {
+    if (items_.empty()) { return false; }
+    return full() || (timeout_ > clock_type::duration::zero() &&
+        now >= deadline());
+  }
+
+  /**
+  \brief Time at which the current batch expires.
+  \pre The current batch is not empty.
+  */
+  clock_type::time_point deadline() const noexcept {
+    return start_ + timeout_;
+  }
+
+  /**
+  \brief Checks if the current batch is empty.
+  */
+  bool empty() const noexcept { return items_.empty(); }
+
+  /**
+  \brief Takes the current batch, leaving a new empty batch.
+  \return The items of the batch.
+  */
+  output_type take_batch() {
+    output_type out;
+    out.swap(items_);
+    return out;
+  }
+
+private:
+  int size_;
+  clock_type::duration timeout_;
+  output_type items_{};
+  clock_type::time_point start_{};
+};
+
+namespace internal {
+
+template<typename T>
+struct is_flat_map : std::false_type {};
+
+template<typename T>
+struct is_flat_map<flat_map_t<T>> : std::true_type {};
+
+template<typename T>
+struct is_batch : std::false_type {};
+
+template<typename T>
+struct is_batch<batch_t<T>> : std::true_type {};
+
+}
+
+template <typename T>
+static constexpr bool is_flat_map = internal::is_flat_map<std::decay_t<T>>();
+
+template <typename T>
+using requires_flat_map = typename std::enable_if_t<is_flat_map<T>, int>;
+
+template <typename T>
+static constexpr bool is_batch = internal::is_batch<std::decay_t<T>>();
+
+template <typename T>
+using requires_batch = typename std::enable_if_t<is_batch<T>, int>;
+
+}
+
+#endif
@@ -0,0 +1,504 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_GRAPH_PATTERN_H
+#define GRPPI_COMMON_GRAPH_PATTERN_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "meta.h"
+#include "optional.h"
+#include "context.h"
+#include "farm_pattern.h"
+#include "filter_pattern.h"
+#include "pipeline_pattern.h"
+#include "reduce_pattern.h"
+#include "time_reduce_pattern.h"
+#include "keyed_pattern.h"
+#include "flat_map_pattern.h"
+#include "iteration_pattern.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Type of the items produced by a stream stage.
+\tparam Input Type of the items consumed by the stage.
+\tparam Stage Type of the stage.
+*/
+template <typename Input, typename Stage, typename = void>
+struct stage_output {
+  using type = std::decay_t<std::invoke_result_t<Stage &, Input &>>;
+};
+
+template <typename Input, typename Stage>
+using stage_output_t =
+    typename stage_output<std::decay_t<Input>, std::decay_t<Stage>>::type;
+
+/**
+\brief Type of the items consumed by a stream stage.
+The type is deduced from the first callable of the stage, which cannot be a
+generic lambda.
+\tparam Stage Type of the stage.
+*/
+template <typename Stage, typename = void>
+struct stage_input {
+  using type = std::decay_t<meta::input_type<Stage>>;
+};
+
+template <typename Stage>
+using stage_input_t = typename stage_input<std::decay_t<Stage>>::type;
+
+/**
+\brief Router of a split sending every item to all its branches.
+*/
+struct broadcast_router {};
+
+/**
+\brief Key of a join pairing the outputs at the same position of every
+branch.
+*/
+struct sequence_key {};
+
+/**
+\brief Buffer of the outputs of two branches waiting for their pair.
+Outputs with the same key are paired in arrival order.
+\tparam Key Type of the key.
+\tparam Left Type of the outputs of the first branch.
+\tparam Right Type of the outputs of the second branch.
+*/
+template <typename Key, typename Left, typename Right>
+class join_buffer {
+public:
+
+  using pair_type = std::pair<Left,Right>;
+
+  /**
+  \brief Adds an output of the first branch.
+  \return The pair formed with the oldest output of the second branch
+  with the same key, if any.
+  */
+  grppi::optional<pair_type> add_left(const Key & key, Left && item) {
+    auto it = pending_.find(key);
+    if (it == pending_.end() || it->second.right.empty()) {
+      pending_[key].left.push_back(std::move(item));
+      return {};
+    }
+    pair_type result{std::move(item), std::move(it->second.right.front())};
+    it->second.right.pop_front();
+    if (it->second.right.empty()) { pending_.erase(it); }
+    return result;
+  }
+
+  /**
+  \brief Adds an output of the second branch.
+  \return The pair formed with the oldest output of the first branch
+  with the same key, if any.
+  */
+  grppi::optional<pair_type> add_right(const Key & key, Right && item) {
+    auto it = pending_.find(key);
+    if (it == pending_.end() || it->second.left.empty()) {
+      pending_[key].right.push_back(std::move(item));
+      return {};
+    }
+    pair_type result{std::move(it->second.left.front()), std::move(item)};
+    it->second.left.pop_front();
+    if (it->second.left.empty()) { pending_.erase(it); }
+    return result;
+  }
+
+  /**
+  \brief Discards every unpaired output.
+  */
+  void clear() { pending_.clear(); }
+
+private:
+  struct entry {
+    std::deque<Left> left;
+    std::deque<Right> right;
+  };
+
+  std::unordered_map<Key,entry> pending_;
+};
+
+}
+
+/**
+\brief Representation of a split pattern.
+Represents a stage that sends every item to one of its branches, or to all
+of them when it is a broadcast. Branches are streaming stages that run
+concurrently. Their outputs are merged into a single stream by interleaving
+them in arrival order, while keeping the order of the outputs of every
+branch. When the split is the last stage, its branches are consumers.
+\tparam Router Callable type selecting the branch of an item. It returns
+either a boolean, selecting the first branch when true and the second one
+when false, or the index of the branch.
+\tparam Branches Types of the branches.
+*/
+template <typename Router, typename ... Branches>
+class split_t {
+public:
+
+  using branches_type = std::tuple<Branches...>;
+
+  /**
+  \brief Type of the merged stream for a given input type.
+  Every branch must produce items of this type.
+  */
+  template <typename Input>
+  using output_type = internal::stage_output_t<Input,
+      std::tuple_element_t<0,branches_type>>;
+
+  /**
+  \brief Indicates if every item is sent to all the branches.
+  */
+  static constexpr bool is_broadcast =
+      std::is_same_v<Router, internal::broadcast_router>;
+
+  /**
+  \brief Constructs a split.
+  \param router Router selecting the branch of every item.
+  \param branches Branches of the split.
+  */
+  split_t(Router router, Branches ... branches) :
+    router_{std::move(router)}, branches_{std::move(branches)...}
+  {}
+
+  /**
+  \brief Number of branches.
+  */
+  static constexpr std::size_t size() noexcept {
+    return sizeof...(Branches);
+  }
+
+  /**
+  \brief Gets the branch of an item.
+  \pre The split is not a broadcast. Items are routed by a single thread.
+  \param item Data item.
+  \return The index of the selected branch.
+  */
+  template <typename T>
+  std::size_t route(const T & item) {
+    static_assert(!is_broadcast, "A broadcast sends items to every branch");
+    if constexpr (std::is_same_v<
+        std::decay_t<std::invoke_result_t<Router &, const T &>>, bool>)
+    {
+      static_assert(sizeof...(Branches) == 2,
+          "A split by predicate needs two branches");
+      return router_(item) ? 0 : 1;
+    }
+    else {
+      return static_cast<std::size_t>(router_(item)) % size();
+    }
+  }
+
+  /**
+  \brief Gets the branches.
+  */
+  branches_type & branches() noexcept { return branches_; }
+
+  /**
+  \brief Applies an operation to a branch selected at run time.
+  \param i Index of the branch.
+  \param op Operation taking the branch.
+  */
+  template <typename F>
+  void apply_to(std::size_t i, F && op) {
+    apply_to(i, op, std::index_sequence_for<Branches...>{});
+  }
+
+  /**
+  \brief Applies an operation to every branch.
+  \param op Operation taking a branch.
+  */
+  template <typename F>
+  void for_each(F && op) {
+    std::apply([&](auto & ... branch) { (op(branch), ...); }, branches_);
+  }
+
+private:
+  template <typename F, std::size_t ... I>
+  void apply_to(std::size_t i, F & op, std::index_sequence<I...>) {
+    ((i == I ? (op(std::get<I>(branches_)), 0) : 0), ...);
+  }
+
+  Router router_;
+  branches_type branches_;
+};
+
+/**
+\brief Representation of a join pattern.
+Represents a stage that sends every item to its two branches, which run
+concurrently, and pairs their outputs. Outputs are either paired by
+position, so that the n-th output of each branch form a pair, or by key, so
+that outputs with the same key form a pair in arrival order. Outputs
+without a pair at the end of the stream are discarded.
+\tparam Key Callable type returning the key of an output, or
+internal::sequence_key for pairing by position.
+\tparam Left Type of the first branch.
+\tparam Right Type of the second branch.
+*/
+template <typename Key, typename Left, typename Right>
+class join_t {
+public:
+
+  using input_type = internal::stage_input_t<Left>;
+  using left_type = internal::stage_output_t<input_type,Left>;
+  using right_type = internal::stage_output_t<input_type,Right>;
+  using output_type = std::pair<left_type,right_type>;
+
+  /**
+  \brief Indicates if outputs are paired by position.
+  */
+  static constexpr bool by_sequence =
+      std::is_same_v<Key, internal::sequence_key>;
+
+private:
+  template <typename K, bool = by_sequence>
+  struct key_of { using type = long; };
+
+  template <typename K>
+  struct key_of<K,false> {
+    using type = std::decay_t<std::invoke_result_t<K &, const left_type &>>;
+  };
+
+public:
+
+  using key_type = typename key_of<Key>::type;
+
+  /**
+  \brief Constructs a join.
+  \param key_op Key extractor for the outputs of both branches.
+  \param left First branch.
+  \param right Second branch.
+  */
+  join_t(Key key_op, Left left, Right right) :
+    key_op_{std::move(key_op)},
+    left_{std::move(left)}, right_{std::move(right)}
+  {}
+
+  /**
+  \brief Gets the first branch.
+  */
+  Left & left() noexcept { return left_; }
+
+  /**
+  \brief Gets the second branch.
+  */
+  Right & right() noexcept { return right_; }
+
+  /**
+  \brief Adds an output of the first branch.
+  \pre Calls are not concurrent.
+  \param seq Position of the output in the first branch.
+  \param item Output of the first branch.
+  \return A pair if the output completes one.
+  */
+  grppi::optional<output_type> add_left(long seq, left_type item) {
+    if constexpr (by_sequence) {
+      return buffer_.add_left(seq, std::move(item));
+    }
+    else {
+      auto key = key_op_(item);
+      return buffer_.add_left(key, std::move(item));
+    }
+  }
+
+  /**
+  \brief Adds the next output of the first branch.
+  \pre Calls are not concurrent.
+  */
+  grppi::optional<output_type> add_left(left_type item) {
+    return add_left(left_count_++, std::move(item));
+  }
+
+  /**
+  \brief Adds an output of the second branch.
+  \pre Calls are not concurrent.
+  \param seq Position of the output in the second branch.
+  \param item Output of the second branch.
+  \return A pair if the output completes one.
+  */
+  grppi::optional<output_type> add_right(long seq, right_type item) {
+    if constexpr (by_sequence) {
+      return buffer_.add_right(seq, std::move(item));
+    }
+    else {
+      auto key = key_op_(item);
+      return buffer_.add_right(key, std::move(item));
+    }
+  }
+
+  /**
+  \brief Adds the next output of the second branch.
+  \pre Calls are not concurrent.
+  */
+  grppi::optional<output_type> add_right(right_type item) {
+    return add_right(right_count_++, std::move(item));
+  }
+
+  /**
+  \brief Discards unpaired outputs at the end of the stream.
+  */
+  void clear() {
+    buffer_.clear();
+    left_count_ = 0;
+    right_count_ = 0;
+  }
+
+private:
+  Key key_op_;
+  Left left_;
+  Right right_;
+
+  internal::join_buffer<key_type,left_type,right_type> buffer_{};
+  long left_count_ = 0;
+  long right_count_ = 0;
+};
+
+/**
+\brief Router sending items to the branches of a split in turn.
+*/
+class round_robin_t {
+public:
+  template <typename T>
+  std::size_t operator()(const T &) noexcept { return next_++; }
+
+private:
+  std::size_t next_ = 0;
+};
+
+namespace internal {
+
+template<typename T>
+struct is_split : std::false_type {};
+
+template<typename R, typename ... B>
+struct is_split<split_t<R,B...>> : std::true_type {};
+
+template<typename T>
+struct is_join : std::false_type {};
+
+template<typename K, typename L, typename R>
+struct is_join<join_t<K,L,R>> : std::true_type {};
+
+} // namespace internal
+
+template <typename T>
+static constexpr bool is_split = internal::is_split<std::decay_t<T>>();
+
+template <typename T>
+using requires_split = typename std::enable_if_t<is_split<T>, int>;
+
+template <typename T>
+static constexpr bool is_join = internal::is_join<std::decay_t<T>>();
+
+template <typename T>
+using requires_join = typename std::enable_if_t<is_join<T>, int>;
+
+namespace internal {
+
+template <typename Input, typename Stages>
+struct chain_output;
+
+template <typename Input>
+struct chain_output<Input, std::tuple<>> {
+  using type = Input;
+};
+
+template <typename Input, typename Stage, typename ... Stages>
+struct chain_output<Input, std::tuple<Stage,Stages...>> :
+  chain_output<stage_output_t<Input,Stage>, std::tuple<Stages...>>
+{};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage,
+    std::enable_if_t<grppi::is_farm<Stage> || grppi::is_context<Stage>>>
+{
+  using type = stage_output_t<Input, typename Stage::transformer_type>;
+};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage, std::enable_if_t<grppi::is_filter<Stage>>> {
+  using type = Input;
+};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage, std::enable_if_t<
+    grppi::is_reduce<Stage> || grppi::is_time_reduce<Stage>>>
+{
+  using type = std::decay_t<typename Stage::result_type>;
+};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage, std::enable_if_t<
+    grppi::is_keyed<Stage> || grppi::is_flat_map<Stage> ||
+    grppi::is_batch<Stage> || grppi::is_iteration<Stage> ||
+    grppi::is_join<Stage>>>
+{
+  using type = std::decay_t<typename Stage::output_type>;
+};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage, std::enable_if_t<grppi::is_pipeline<Stage>>> :
+  chain_output<Input, typename Stage::transformers_type>
+{};
+
+template <typename Input, typename Stage>
+struct stage_output<Input, Stage, std::enable_if_t<grppi::is_split<Stage>>> {
+  using type = typename Stage::template output_type<Input>;
+};
+
+template <typename Stage>
+struct stage_input<Stage,
+    std::enable_if_t<grppi::is_farm<Stage> || grppi::is_context<Stage>>>
+{
+  using type = stage_input_t<typename Stage::transformer_type>;
+};
+
+template <typename Stage>
+struct stage_input<Stage, std::enable_if_t<
+    grppi::is_filter<Stage> || grppi::is_reduce<Stage> ||
+    grppi::is_time_reduce<Stage> || grppi::is_keyed<Stage> ||
+    grppi::is_flat_map<Stage> || grppi::is_batch<Stage> ||
+    grppi::is_iteration<Stage> || grppi::is_join<Stage>>>
+{
+  using type = std::decay_t<typename Stage::input_type>;
+};
+
+template <typename Stage>
+struct stage_input<Stage, std::enable_if_t<grppi::is_pipeline<Stage>>> {
+  using type = stage_input_t<
+      std::tuple_element_t<0, typename Stage::transformers_type>>;
+};
+
+template <typename Stage>
+struct stage_input<Stage, std::enable_if_t<grppi::is_split<Stage>>> {
+  using type = stage_input_t<
+      std::tuple_element_t<0, typename Stage::branches_type>>;
+};
+
+}
+
+}
+
+#endif
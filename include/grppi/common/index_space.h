@@ -0,0 +1,233 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_INDEX_SPACE_H
+#define GRPPI_COMMON_INDEX_SPACE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace grppi {
+
+/**
+\brief A multi-dimensional space of indices.
+The space is the cartesian product of the half-open intervals 
+`[begin(d),end(d))` for every dimension `d`. 
+Indices are visited in row-major order (the last dimension varies fastest).
+\tparam N Number of dimensions.
+*/
+template <std::size_t N>
+class index_space {
+public:
+  static_assert(N > 0, "An index space needs at least one dimension");
+
+  /// Number of dimensions.
+  static constexpr std::size_t rank = N;
+
+  /**
+  \brief Construct a space from its lower and upper bounds.
+  \param first Lower bounds (inclusive).
+  \param last Upper bounds (exclusive).
+  */
+  constexpr index_space(const std::array<std::size_t,N> & first, 
+                        const std::array<std::size_t,N> & last) noexcept :
+    first_{first}, last_{last}
+  {}
+
+  /**
+  \brief Construct a space starting at the origin.
+  \param last Upper bounds (exclusive).
+  */
+  constexpr explicit index_space(const std::array<std::size_t,N> & last) noexcept :
+    first_{}, last_{last}
+  {}
+
+  /// Get the lower bound of a dimension.
+  constexpr std::size_t begin(std::size_t d) const noexcept { return first_[d]; }
+
+  /// Get the upper bound of a dimension.
+  constexpr std::size_t end(std::size_t d) const noexcept { return last_[d]; }
+
+  /// Get the number of indices in a dimension.
+  constexpr std::size_t extent(std::size_t d) const noexcept 
+  { 
+    return last_[d] > first_[d] ? last_[d] - first_[d] : 0; 
+  }
+
+  /// Get the total number of indices in the space.
+  constexpr std::size_t size() const noexcept
+  {
+    std::size_t result = 1;
+    for (std::size_t d = 0; d < N; ++d) { result *= extent(d); }
+    return result;
+  }
+
+  /// Check if the space has no indices.
+  constexpr bool empty() const noexcept { return size() == 0; }
+
+  /// Get the lower bounds.
+  constexpr const std::array<std::size_t,N> & first() const noexcept 
+  { 
+    return first_; 
+  }
+
+  /// Get the upper bounds.
+  constexpr const std::array<std::size_t,N> & last() const noexcept 
+  { 
+    return last_; 
+  }
+
+  /**
+  \brief Apply an operation to every index in the space.
+  \param op Callable object taking `N` indices.
+  */
+  template <typename Operation>
+  void for_each(Operation && op) const
+  {
+    std::array<std::size_t,N> index{};
+    for_each_impl<0>(op, index);
+  }
+
+private:
+  template <std::size_t D, typename Operation>
+  void for_each_impl(Operation & op, std::array<std::size_t,N> & index) const
+  {
+    for (index[D] = first_[D]; index[D] < last_[D]; ++index[D]) {
+      if constexpr (D + 1 == N) { std::apply(op, index); }
+      else { for_each_impl<D+1>(op, index); }
+    }
+  }
+
+  std::array<std::size_t,N> first_;
+  std::array<std::size_t,N> last_;
+};
+
+/**
+\brief A tile is a rectangular part of an index space.
+*/
+template <std::size_t N>
+using tile = index_space<N>;
+
+/**
+\brief Make an index space starting at the origin.
+\param extents Number of indices in every dimension.
+*/
+template <typename ... Extents>
+constexpr auto make_index_space(Extents ... extents) noexcept
+{
+  return index_space<sizeof...(Extents)>{
+      std::array<std::size_t,sizeof...(Extents)>{
+          static_cast<std::size_t>(extents)...}};
+}
+
+/**
+\brief Scheduling policy for the tiles of an index space.
+*/
+enum class tile_schedule {
+  /// Every worker processes a contiguous block of tiles fixed in advance.
+  static_schedule,
+  /// Workers take the next unprocessed tile when they become idle.
+  dynamic_schedule
+};
+
+/**
+\brief Tiling of an index space.
+\tparam N Number of dimensions.
+*/
+template <std::size_t N>
+struct tiling {
+  /// Number of indices of a tile in every dimension (0 for the whole extent).
+  std::array<std::size_t,N> shape;
+  /// Scheduling policy for tiles.
+  tile_schedule schedule;
+};
+
+/**
+\brief Make a tiling whose tiles are statically distributed among workers.
+\param shape Number of indices of a tile in every dimension.
+*/
+template <typename ... Sizes>
+constexpr auto static_tiles(Sizes ... shape) noexcept
+{
+  return tiling<sizeof...(Sizes)>{
+      {static_cast<std::size_t>(shape)...}, tile_schedule::static_schedule};
+}
+
+/**
+\brief Make a tiling whose tiles are dynamically distributed among workers.
+\param shape Number of indices of a tile in every dimension.
+*/
+template <typename ... Sizes>
+constexpr auto dynamic_tiles(Sizes ... shape) noexcept
+{
+  return tiling<sizeof...(Sizes)>{
+      {static_cast<std::size_t>(shape)...}, tile_schedule::dynamic_schedule};
+}
+
+namespace internal {
+
+/**
+\brief Tiles of an index space, numbered in row-major order.
+*/
+template <std::size_t N>
+class tile_grid {
+public:
+  tile_grid(const index_space<N> & space, 
+            const std::array<std::size_t,N> & shape) noexcept :
+    space_{space}
+  {
+    for (std::size_t d = 0; d < N; ++d) {
+      const auto extent = space.extent(d);
+      shape_[d] = (shape[d] == 0 || shape[d] > extent) ? extent : shape[d];
+      counts_[d] = shape_[d] == 0 ? 0 : (extent + shape_[d] - 1) / shape_[d];
+    }
+  }
+
+  /// Get the number of tiles.
+  std::size_t size() const noexcept
+  {
+    std::size_t result = 1;
+    for (auto c : counts_) { result *= c; }
+    return result;
+  }
+
+  /// Get a tile from its number.
+  tile<N> operator[](std::size_t t) const noexcept
+  {
+    std::array<std::size_t,N> first, last;
+    for (std::size_t d = N; d-- > 0;) {
+      const auto pos = t % counts_[d];
+      t /= counts_[d];
+      first[d] = space_.begin(d) + pos * shape_[d];
+      last[d] = std::min(first[d] + shape_[d], space_.end(d));
+    }
+    return {first, last};
+  }
+
+private:
+  index_space<N> space_;
+  std::array<std::size_t,N> shape_{};
+  std::array<std::size_t,N> counts_{};
+};
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
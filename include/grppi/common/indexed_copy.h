@@ -0,0 +1,168 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_INDEXED_COPY_H
+#define GRPPI_COMMON_INDEXED_COPY_H
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace grppi {
+
+namespace internal {
+
+/// Maximum number of elements in a block of an indexed copy.
+constexpr std::size_t indexed_block_size = 4096;
+
+/// Number of elements ahead of the current one that are prefetched.
+constexpr std::size_t prefetch_distance = 16;
+
+/**
+\brief Hint that the element pointed by an iterator will be read soon.
+\note Only contiguous iterators with a compiler supporting prefetch builtins 
+emit a prefetch instruction.
+*/
+template <typename Iterator>
+inline void prefetch_read(Iterator it) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (std::is_pointer<Iterator>::value) {
+    __builtin_prefetch(it, 0, 1);
+  }
+  else if constexpr (std::is_same<typename std::iterator_traits<Iterator>::iterator_category,
+      std::random_access_iterator_tag>::value && 
+      std::is_lvalue_reference<decltype(*it)>::value) {
+    __builtin_prefetch(std::addressof(*it), 0, 1);
+  }
+#endif
+}
+
+/**
+\brief Hint that the element pointed by an iterator will be written soon.
+*/
+template <typename Iterator>
+inline void prefetch_write(Iterator it) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (std::is_pointer<Iterator>::value) {
+    __builtin_prefetch(it, 1, 1);
+  }
+  else if constexpr (std::is_same<typename std::iterator_traits<Iterator>::iterator_category,
+      std::random_access_iterator_tag>::value && 
+      std::is_lvalue_reference<decltype(*it)>::value) {
+    __builtin_prefetch(std::addressof(*it), 1, 1);
+  }
+#endif
+}
+
+/**
+\brief Apply an operation to consecutive blocks of a sequence.
+Blocks are processed with the map pattern of the execution policy, so that
+every worker processes a set of consecutive blocks.
+\param block_op Callable object taking the bounds `[lo,hi)` of a block.
+*/
+template <typename Execution, typename BlockOperation>
+void for_each_block(const Execution & ex, std::size_t sequence_size,
+    BlockOperation && block_op)
+{
+  if (sequence_size == 0) { return; }
+  const auto degree = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+  const auto block_size = std::min(indexed_block_size, 
+      (sequence_size + degree - 1) / degree);
+  const auto num_blocks = (sequence_size + block_size - 1) / block_size;
+  std::vector<std::size_t> blocks(num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+
+  // Block ids are written back to its own sequence, as map is only used
+  // for its side effects.
+  ex.map(std::make_tuple(blocks.begin()), blocks.begin(), num_blocks,
+    [&](std::size_t block) {
+      const auto lo = block * block_size;
+      block_op(lo, std::min(lo + block_size, sequence_size));
+      return block;
+    });
+}
+
+/**
+\brief Gather elements of a source sequence by index.
+`first_out[i] = source[first_index[i]]` for every `i`. Work is split by 
+destination, so that every worker writes consecutive elements, and source
+elements are prefetched ahead of their use.
+*/
+template <typename Execution, typename IndexIterator, typename SourceIterator,
+    typename OutputIterator>
+void gather(const Execution & ex, IndexIterator first_index, 
+    std::size_t sequence_size, SourceIterator source, 
+    OutputIterator first_out)
+{
+  for_each_block(ex, sequence_size, [&](std::size_t lo, std::size_t hi) {
+    auto idx = std::next(first_index, lo);
+    auto ahead = idx;
+    const auto ahead_end = std::min(lo + prefetch_distance, hi);
+    for (auto i = lo; i < ahead_end; ++i, ++ahead) {
+      prefetch_read(std::next(source, *ahead));
+    }
+    auto out = std::next(first_out, lo);
+    for (auto i = lo; i < hi; ++i, ++idx, ++out) {
+      if (i + prefetch_distance < hi) { 
+        prefetch_read(std::next(source, *ahead)); 
+        ++ahead;
+      }
+      *out = *std::next(source, *idx);
+    }
+  });
+}
+
+/**
+\brief Scatter elements of a sequence to positions given by index.
+`dest[first_index[i]] = first[i]` for every `i`. Work is split by source, so
+that every worker reads consecutive elements, and destination elements are
+prefetched for writing ahead of their use.
+*/
+template <typename Execution, typename InputIterator, typename IndexIterator,
+    typename OutputIterator>
+void scatter(const Execution & ex, InputIterator first, 
+    std::size_t sequence_size, IndexIterator first_index, 
+    OutputIterator dest)
+{
+  for_each_block(ex, sequence_size, [&](std::size_t lo, std::size_t hi) {
+    auto idx = std::next(first_index, lo);
+    auto ahead = idx;
+    const auto ahead_end = std::min(lo + prefetch_distance, hi);
+    for (auto i = lo; i < ahead_end; ++i, ++ahead) {
+      prefetch_write(std::next(dest, *ahead));
+    }
+    auto in = std::next(first, lo);
+    for (auto i = lo; i < hi; ++i, ++idx, ++in) {
+      if (i + prefetch_distance < hi) { 
+        prefetch_write(std::next(dest, *ahead)); 
+        ++ahead;
+      }
+      *std::next(dest, *idx) = *in;
+    }
+  });
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_INPLACE_DIVIDE_CONQUER_H
+#define GRPPI_COMMON_INPLACE_DIVIDE_CONQUER_H
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "accumulate.h"
+
+namespace grppi {
+
+namespace internal {
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T,N>> : std::true_type {};
+
+/**
+\brief Solve a problem with divide/conquer without allocating memory.
+Subproblems are returned by the divider in a std::array with a fixed number
+of elements. Results of subproblems are kept in a std::array local to the
+current level and combined in place into the result of the first
+subproblem.
+
+When the solver returns void, problems are assumed to be solved in place and
+the combiner is invoked with the problem and the array of subproblems, once
+every subproblem has been solved.
+
+\param fork Callable object `fork(n, task)` invoking `task(i)` for every
+`i` in `[0,n)`, possibly in parallel, and waiting for their completion. 
+The number of subproblems `n` is given as a `std::integral_constant`, so
+that policies may keep per-level state in fixed size arrays.
+This is the only point where execution policies differ.
+*/
+template <typename Problem, typename Divider, typename Predicate,
+    typename Solver, typename Combiner, typename Fork>
+auto inplace_divide_conquer(const Problem & problem,
+    Divider & divide_op, Predicate & predicate_op, Solver & solve_op,
+    Combiner & combine_op, Fork & fork)
+{
+  using result_type = std::decay_t<decltype(solve_op(problem))>;
+  using subproblems_type = std::decay_t<decltype(divide_op(problem))>;
+  static_assert(is_std_array<subproblems_type>::value,
+      "In place divide/conquer requires a divider returning a std::array");
+  constexpr std::size_t arity = std::tuple_size<subproblems_type>::value;
+  using arity_type = std::integral_constant<std::size_t, arity>;
+
+  if (predicate_op(problem)) { return solve_op(problem); }
+  const subproblems_type subproblems = divide_op(problem);
+
+  if constexpr (std::is_void<result_type>::value) {
+    auto task = [&](std::size_t i) {
+      inplace_divide_conquer(subproblems[i], divide_op, predicate_op, 
+          solve_op, combine_op, fork);
+    };
+    fork(arity_type{}, task);
+    combine_op(problem, subproblems);
+  }
+  else {
+    std::array<result_type, arity> partials;
+    auto task = [&](std::size_t i) {
+      partials[i] = inplace_divide_conquer(subproblems[i], divide_op, 
+          predicate_op, solve_op, combine_op, fork);
+    };
+    fork(arity_type{}, task);
+    for (std::size_t i = 1; i < arity; ++i) {
+      combine_partial(combine_op, partials[0], partials[i]);
+    }
+    return std::move(partials[0]);
+  }
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -16,22 +16,45 @@
 #ifndef GRPPI_COMMON_ITERATION_PATTERN_H
 #define GRPPI_COMMON_ITERATION_PATTERN_H
 
+#include <tuple>
 #include <type_traits>
 #include "meta.h"
+#include "pipeline_pattern.h"
 
 namespace grppi {
 
+namespace internal {
+
+template <typename Transformer, bool = grppi::is_pipeline<Transformer>>
+struct iteration_input {
+  using type = meta::input_type<Transformer>;
+};
+
+// A pipeline body takes the input of its first stage
+template <typename Transformer>
+struct iteration_input<Transformer, true> {
+  using type = meta::input_type<std::decay_t<std::tuple_element_t<0,
+      typename std::decay_t<Transformer>::transformers_type>>>;
+};
+
+}
+
 /**
 \brief Representation of iteration pattern.
 Represents a iteration that can be used as a stage on a pipeline.
+Every item is transformed until the predicate holds. The body of the
+iteration may be either a transformer or a pipeline, whose stages are applied
+in sequence. Items may be iterated by a number of replicas, each one looping
+locally on its items.
+\tparam Transformer Callable type or pipeline for the iteration body.
 \tparam Predicate Callable type for the iteration predicate.
 */
 template <typename Transformer, typename Predicate>
 class iteration_t {
 public:
 
-  using input_type = meta::input_type<Transformer>;
-  using output_type = meta::output_type<Transformer>;
+  using input_type = typename internal::iteration_input<Transformer>::type;
+  using output_type = std::invoke_result_t<Transformer,input_type>;
 
   /**
   \brief Constructs a iteration with a predicate.
@@ -66,9 +89,21 @@ public:
     return transform(item);
   }
 
+  /**
+  \brief Number of replicas iterating items.
+  */
+  int cardinality() const noexcept { return cardinality_; }
+
+  /**
+  \brief Sets the number of replicas iterating items.
+  \param n Number of replicas.
+  */
+  void set_cardinality(int n) noexcept { cardinality_ = n; }
+
 private:
   Transformer transform_;
   Predicate predicate_;
+  int cardinality_ = 1;
 };
 
 namespace internal {
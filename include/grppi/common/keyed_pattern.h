@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_KEYED_PATTERN_H
+#define GRPPI_COMMON_KEYED_PATTERN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "meta.h"
+#include "optional.h"
+#include "reduce_pattern.h"
+
+namespace grppi {
+
+namespace internal {
+
+template <typename Stage, typename Input, bool = grppi::is_reduce<Stage>>
+struct keyed_output {
+  using type = std::decay_t<std::invoke_result_t<Stage&, const Input &>>;
+};
+
+template <typename Stage, typename Input>
+struct keyed_output<Stage, Input, true> {
+  using type = typename Stage::input_type;
+};
+
+}
+
+/**
+\brief Representation of a keyed farm pattern.
+Represents a stage whose items are partitioned by key. Items are routed to
+a fixed replica, or shard, by the hash of their key. Every shard owns the
+state of its keys, which is a copy of the stage made the first time the key
+is seen, so that the state of a key is never shared between replicas.
+
+The stage may be either a transformer, which may keep per key state in its
+data members, or a stream reduction, whose windows are then formed by the
+items of each key.
+\tparam KeyExtractor Callable type returning the key of an item.
+\tparam Stage Type of the stage applied to the items of every key.
+*/
+template <typename KeyExtractor, typename Stage>
+class keyed_t {
+public:
+
+  using input_type = std::decay_t<meta::input_type<KeyExtractor>>;
+  using key_type = std::decay_t<
+      std::invoke_result_t<KeyExtractor, const input_type &>>;
+  using output_type = typename internal::keyed_output<Stage,input_type>::type;
+
+  /**
+  \brief Constructs a keyed farm.
+  \param n Number of replicas.
+  \param key_op Key extractor.
+  \param stage Stage applied to the items of every key.
+  */
+  keyed_t(int n, KeyExtractor key_op, Stage stage) :
+    key_op_{std::move(key_op)}, stage_{std::move(stage)},
+    shards_(static_cast<std::size_t>(std::max(n,1)))
+  {}
+
+  /**
+  \brief Number of replicas.
+  */
+  int cardinality() const noexcept {
+    return static_cast<int>(shards_.size());
+  }
+
+  /**
+  \brief Get the shard owning the key of an item.
+  \param item Data item.
+  \return The index of the replica in charge of the item.
+  */
+  std::size_t shard(const input_type & item) const {
+    return std::hash<key_type>{}(key_op_(item)) % shards_.size();
+  }
+
+  /**
+  \brief Applies the stage to an item with the state of its key.
+  \pre The calling thread is the only one accessing shard `s`.
+  \param s Shard owning the key of the item.
+  \param item Data item.
+  \return The output for the item, if any. A reduction only produces an output
+  when a window of the key is completed.
+  */
+  grppi::optional<output_type> operator()(std::size_t s,
+      const input_type & item)
+  {
+    auto & states = shards_[s].states;
+    auto & state = states.try_emplace(key_op_(item), stage_).first->second;
+    if constexpr (is_reduce<Stage>) {
+      state.add_item(item);
+      if (!state.reduction_needed()) { return {}; }
+      return state.reduce_window(*this);
+    }
+    else {
+      return state(item);
+    }
+  }
+
+private:
+  // Shards are modified concurrently by different replicas
+  struct alignas(64) shard_type {
+    std::unordered_map<key_type,Stage> states;
+  };
+
+  KeyExtractor key_op_;
+  Stage stage_;
+  std::vector<shard_type> shards_;
+};
+
+namespace internal {
+
+template<typename T>
+struct is_keyed : std::false_type {};
+
+template<typename K, typename S>
+struct is_keyed<keyed_t<K,S>> : std::true_type {};
+
+} // namespace internal
+
+template <typename T>
+static constexpr bool is_keyed = internal::is_keyed<std::decay_t<T>>();
+
+template <typename T>
+using requires_keyed = typename std::enable_if_t<is_keyed<T>, int>;
+
+}
+
+#endif
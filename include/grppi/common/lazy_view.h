@@ -0,0 +1,325 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_LAZY_VIEW_H
+#define GRPPI_COMMON_LAZY_VIEW_H
+
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "range_concept.h"
+#include "zip_view.h"
+#include "optional.h"
+
+namespace grppi {
+
+namespace internal {
+
+/// Element-wise transformation stage in a lazy view.
+template <typename Transformer>
+struct map_stage {
+  Transformer transform_op;
+};
+
+/// Element selection stage in a lazy view.
+template <typename Predicate>
+struct filter_stage {
+  Predicate predicate_op;
+};
+
+template <typename T>
+struct is_filter_stage : std::false_type {};
+
+template <typename P>
+struct is_filter_stage<filter_stage<P>> : std::true_type {};
+
+/**
+\brief Result of a fused stage chain containing filters.
+An empty value means that the element was discarded by some filter.
+\note This is a distinct type (not an optional) so that it is never confused
+with a value produced by the user operations.
+*/
+template <typename T>
+struct filtered_item {
+  grppi::optional<T> value{};
+};
+
+template <typename T>
+struct is_filtered_item : std::false_type {};
+
+template <typename T>
+struct is_filtered_item<filtered_item<T>> : std::true_type {};
+
+/**
+\brief Applies stages [I,N) of a chain to a set of values.
+The first stage may receive multiple values (one per input sequence in a zip).
+Every other stage receives the single value produced by the previous one.
+\tparam Filtered Whether the chain contains any filter stage. In that case
+the result is wrapped in a filtered_item.
+*/
+template <bool Filtered, std::size_t I, typename Stages, typename ... Args>
+decltype(auto) apply_stages(const Stages & stages, Args && ... args)
+{
+  if constexpr (I == std::tuple_size<Stages>::value) {
+    static_assert(sizeof...(Args) == 1,
+        "Lazy view over multiple sequences needs a map stage");
+    using value_type = std::decay_t<std::tuple_element_t<0,std::tuple<Args...>>>;
+    if constexpr (Filtered) {
+      return filtered_item<value_type>{value_type(std::forward<Args>(args)...)};
+    }
+    else {
+      return value_type(std::forward<Args>(args)...);
+    }
+  }
+  else {
+    const auto & stage = std::get<I>(stages);
+    using stage_type = std::decay_t<decltype(stage)>;
+    if constexpr (is_filter_stage<stage_type>::value) {
+      static_assert(sizeof...(Args) == 1,
+          "Lazy view over multiple sequences needs a map stage before filtering");
+      using result_type = decltype(
+          apply_stages<Filtered,I+1>(stages, std::forward<Args>(args)...));
+      if (!stage.predicate_op(args...)) { return result_type{}; }
+      return apply_stages<Filtered,I+1>(stages, std::forward<Args>(args)...);
+    }
+    else {
+      return apply_stages<Filtered,I+1>(stages,
+          stage.transform_op(std::forward<Args>(args)...));
+    }
+  }
+}
+
+/**
+\brief Callable object applying all the stages of a lazy view to an element.
+*/
+template <bool Filtered, typename ... Stages>
+class fused_transformer {
+public:
+  fused_transformer(std::tuple<Stages...> stages) : stages_{std::move(stages)} {}
+
+  template <typename ... Args>
+  auto operator()(Args && ... args) const
+  {
+    return apply_stages<Filtered,0>(stages_, std::forward<Args>(args)...);
+  }
+
+private:
+  std::tuple<Stages...> stages_;
+};
+
+/**
+\brief Combiner adapter skipping the elements discarded by filter stages.
+Combinations of two partial results are forwarded to the wrapped combiner.
+In-place combiners keep being in-place combiners once adapted.
+*/
+template <typename Combiner>
+class filtered_combiner {
+public:
+  filtered_combiner(Combiner combine_op) : combine_op_{std::move(combine_op)} {}
+
+  template <typename Acc, typename T>
+  decltype(auto) operator()(Acc && acc, const filtered_item<T> & item) const
+  {
+    using result_type = decltype(combine_op_(std::forward<Acc>(acc), *item.value));
+    if constexpr (std::is_void<result_type>::value) {
+      if (item.value) { combine_op_(std::forward<Acc>(acc), *item.value); }
+    }
+    else if constexpr (std::is_lvalue_reference<result_type>::value) {
+      if (!item.value) { return static_cast<result_type>(acc); }
+      return combine_op_(std::forward<Acc>(acc), *item.value);
+    }
+    else {
+      if (!item.value) { return std::decay_t<Acc>(std::forward<Acc>(acc)); }
+      return std::decay_t<Acc>(combine_op_(std::forward<Acc>(acc), *item.value));
+    }
+  }
+
+  template <typename Acc, typename T,
+      std::enable_if_t<!is_filtered_item<std::decay_t<T>>::value, int> = 0>
+  decltype(auto) operator()(Acc && acc, T && value) const
+  {
+    return combine_op_(std::forward<Acc>(acc), std::forward<T>(value));
+  }
+
+private:
+  Combiner combine_op_;
+};
+
+} // namespace internal
+
+/**
+\brief A lazy view applying a chain of map and filter stages over one or more
+sequences.
+A lazy view does not store any intermediate result. Stages are only applied
+when the view is consumed by a terminal data pattern (map, reduce or
+map_reduce), fusing the whole chain into a single pass over the input data.
+\tparam Iterators Tuple type with iterators to the input sequences.
+\tparam Stages Stage types applied to every element.
+*/
+template <typename Iterators, typename ... Stages>
+class lazy_view {
+public:
+
+  /// Whether the view contains any filter stage.
+  static constexpr bool has_filter =
+      std::disjunction<internal::is_filter_stage<Stages>...>::value;
+
+  /**
+  \brief Construct from a tuple of iterators, a size and a stages chain.
+  */
+  lazy_view(Iterators firsts, std::size_t size, std::tuple<Stages...> stages) :
+    firsts_{firsts}, size_{size}, stages_{std::move(stages)}
+  {}
+
+  /**
+  \brief Get a new view adding a transformation stage.
+  \param transform_op Transformation applied to every element.
+  */
+  template <typename Transformer>
+  auto map(Transformer && transform_op) const
+  {
+    using stage_type = internal::map_stage<std::decay_t<Transformer>>;
+    return lazy_view<Iterators,Stages...,stage_type>{firsts_, size_,
+        std::tuple_cat(stages_,
+            std::make_tuple(stage_type{std::forward<Transformer>(transform_op)}))};
+  }
+
+  /**
+  \brief Get a new view adding a filtering stage.
+  \param predicate_op Predicate that every kept element satisfies.
+  */
+  template <typename Predicate>
+  auto filter(Predicate && predicate_op) const
+  {
+    using stage_type = internal::filter_stage<std::decay_t<Predicate>>;
+    return lazy_view<Iterators,Stages...,stage_type>{firsts_, size_,
+        std::tuple_cat(stages_,
+            std::make_tuple(stage_type{std::forward<Predicate>(predicate_op)}))};
+  }
+
+  /**
+  \brief Get a tuple with the iterators to the input sequences.
+  */
+  Iterators begin() const noexcept { return firsts_; }
+
+  /**
+  \brief Get the number of elements in the input sequences.
+  \note When the view has filters the number of elements reaching a terminal
+  operation may be smaller.
+  */
+  std::size_t size() const noexcept { return size_; }
+
+  /**
+  \brief Get a callable object applying every stage in the view.
+  */
+  auto transformer() const
+  {
+    return internal::fused_transformer<has_filter,Stages...>{stages_};
+  }
+
+  /**
+  \brief Get a callable object applying every stage in the view followed by
+  an additional transformation.
+  */
+  template <typename Transformer>
+  auto transformer(Transformer && transform_op) const
+  {
+    using stage_type = internal::map_stage<std::decay_t<Transformer>>;
+    return internal::fused_transformer<has_filter,Stages...,stage_type>{
+        std::tuple_cat(stages_,
+            std::make_tuple(stage_type{std::forward<Transformer>(transform_op)}))};
+  }
+
+  /**
+  \brief Adapt a combiner so that it skips elements discarded by filters.
+  */
+  template <typename Combiner>
+  auto combiner(Combiner && combine_op) const
+  {
+    if constexpr (has_filter) {
+      return internal::filtered_combiner<std::decay_t<Combiner>>{
+          std::forward<Combiner>(combine_op)};
+    }
+    else {
+      return std::forward<Combiner>(combine_op);
+    }
+  }
+
+private:
+  Iterators firsts_;
+  std::size_t size_;
+  std::tuple<Stages...> stages_;
+};
+
+namespace internal {
+
+template <typename T>
+struct is_lazy_view : std::false_type {};
+
+template <typename I, typename ... S>
+struct is_lazy_view<lazy_view<I,S...>> : std::true_type {};
+
+}
+
+template <typename T>
+constexpr bool is_lazy_view = internal::is_lazy_view<std::decay_t<T>>::value;
+
+template <typename T>
+using requires_lazy_view = std::enable_if_t<is_lazy_view<T>, int>;
+
+/**
+\brief Factory function for a lazy view over a range.
+\tparam R Range type.
+\param r Reference to the range.
+*/
+template <typename R,
+    meta::requires_<range_concept, R> = 0>
+auto lazy(R & r)
+{
+  using iterators_type = std::tuple<decltype(r.begin())>;
+  return lazy_view<iterators_type>{iterators_type{r.begin()},
+      static_cast<std::size_t>(r.size()), {}};
+}
+
+/**
+\brief Factory function for a lazy view over multiple ranges.
+\tparam Rs Ranges types.
+\param rs Zip view with the ranges.
+*/
+template <typename ... Rs>
+auto lazy(zip_view<Rs...> rs)
+{
+  using iterators_type = decltype(rs.begin());
+  return lazy_view<iterators_type>{rs.begin(),
+      static_cast<std::size_t>(rs.size()), {}};
+}
+
+/**
+\brief Factory function for a lazy view over multiple arrays.
+\tparam N Size of arrays.
+\tparam Ts Arrays element types.
+\param as Zip view with the arrays.
+*/
+template <std::size_t N, typename ... Ts>
+auto lazy(zip_view_arrays<N, Ts...> as)
+{
+  using iterators_type = decltype(as.begin());
+  return lazy_view<iterators_type>{as.begin(), N, {}};
+}
+
+}
+
+#endif
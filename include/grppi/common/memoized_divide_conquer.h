@@ -0,0 +1,198 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_MEMOIZED_DIVIDE_CONQUER_H
+#define GRPPI_COMMON_MEMOIZED_DIVIDE_CONQUER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "accumulate.h"
+#include "optional.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Concurrent hash map split into independently locked shards.
+Entries are never erased while the map is alive, and references to them
+remain valid when other entries are inserted.
+\tparam Key Type of keys.
+\tparam Entry Type of entries. It must be default constructible.
+\tparam Hash Hash function for keys.
+*/
+template <typename Key, typename Entry, typename Hash = std::hash<Key>>
+class sharded_map {
+public:
+
+  /**
+  \brief Construct an empty map.
+  \param min_shards Minimum number of shards. It is rounded up to a power of 2.
+  */
+  explicit sharded_map(std::size_t min_shards) 
+  {
+    while (num_shards_ < min_shards) { 
+      num_shards_ *= 2; 
+      shard_bits_++;
+    }
+    shards_ = std::make_unique<shard[]>(num_shards_);
+  }
+
+  /**
+  \brief Find the entry for a key, inserting a default one if not found.
+  \return A pair with a reference to the entry and a flag signaling if the 
+  entry was inserted.
+  */
+  std::pair<Entry &, bool> find_or_insert(const Key & key)
+  {
+    auto & s = shards_[shard_index(key)];
+    std::lock_guard<std::mutex> lock{s.mutex};
+    auto result = s.entries.try_emplace(key);
+    return {result.first->second, result.second};
+  }
+
+  /// Get the number of entries in the map.
+  std::size_t size() const 
+  {
+    std::size_t total = 0;
+    for (std::size_t i=0; i<num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock{shards_[i].mutex};
+      total += shards_[i].entries.size();
+    }
+    return total;
+  }
+
+private:
+  struct shard {
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, Hash> entries;
+  };
+
+  std::size_t shard_index(const Key & key) const
+  {
+    if (shard_bits_ == 0) return 0;
+    // Fibonacci hashing spreads keys with similar hashes among shards.
+    const std::uint64_t h = hash_(key) * UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<std::size_t>(h >> (64 - shard_bits_));
+  }
+
+  std::size_t num_shards_ = 1;
+  int shard_bits_ = 0;
+  std::unique_ptr<shard[]> shards_;
+  Hash hash_{};
+};
+
+/**
+\brief Memoization table with in-flight deduplication based on futures.
+The first worker looking for a key computes its result. Any other worker 
+looking for the same key blocks until the result is available.
+\note Blocking is only safe when every worker is a dedicated thread.
+*/
+template <typename Key, typename Result>
+class future_memo {
+public:
+
+  explicit future_memo(std::size_t min_shards) : entries_{min_shards} {}
+
+  /**
+  \brief Get the result for a key, computing it if needed.
+  \param key Key of the problem.
+  \param compute_op Callable object computing the result.
+  */
+  template <typename Compute>
+  Result get_or_compute(const Key & key, Compute && compute_op)
+  {
+    auto found = entries_.find_or_insert(key);
+    auto & e = found.first;
+    if (!found.second) { return e.future.get(); }
+    try {
+      Result result = compute_op();
+      e.promise.set_value(result);
+      return result;
+    }
+    catch (...) {
+      e.promise.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  /// Get the number of memoized problems.
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  struct entry {
+    std::promise<Result> promise;
+    std::shared_future<Result> future{promise.get_future().share()};
+  };
+
+  sharded_map<Key, entry> entries_;
+};
+
+/**
+\brief Solve a problem with divide/conquer, memoizing the result of every
+(sub)problem.
+Problems with the same key are solved only once, even when they are reached
+concurrently by several workers.
+\param key_op Key extractor for problems.
+\param memo Memoization table `get_or_compute(key, compute)`.
+\param fork Callable object `fork(n, task)` invoking `task(i)` for every `i`
+in `[0,n)`, possibly in parallel, and waiting for their completion.
+*/
+template <typename Problem, typename KeyExtractor, typename Divider, 
+    typename Predicate, typename Solver, typename Combiner, 
+    typename Memo, typename Fork>
+auto memoized_divide_conquer(const Problem & problem, KeyExtractor & key_op,
+    Divider & divide_op, Predicate & predicate_op, Solver & solve_op,
+    Combiner & combine_op, Memo & memo, Fork & fork)
+  -> std::decay_t<decltype(solve_op(problem))>
+{
+  using result_type = std::decay_t<decltype(solve_op(problem))>;
+  return memo.get_or_compute(key_op(problem), [&]() -> result_type {
+    if (predicate_op(problem)) { return solve_op(problem); }
+    const auto subproblems = divide_op(problem);
+    const auto first = std::begin(subproblems);
+    const std::size_t n = std::distance(first, std::end(subproblems));
+    // A problem that cannot be divided is solved directly
+    if (n == 0) { return solve_op(problem); }
+    // Results need not be default constructible
+    std::vector<grppi::optional<result_type>> partials(n);
+    fork(n, [&](std::size_t i) {
+      partials[i].emplace(memoized_divide_conquer(*std::next(first,i), key_op,
+          divide_op, predicate_op, solve_op, combine_op, memo, fork));
+    });
+    result_type result{std::move(*partials[0])};
+    for (std::size_t i=1; i<n; ++i) {
+      combine_partial(combine_op, result, *partials[i]);
+    }
+    return result;
+  });
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -24,7 +24,11 @@
 #include "filter_pattern.h"
 #include "pipeline_pattern.h"
 #include "reduce_pattern.h"
+#include "time_reduce_pattern.h"
+#include "keyed_pattern.h"
+#include "flat_map_pattern.h"
 #include "iteration_pattern.h"
+#include "graph_pattern.h"
 #include "context.h"
 
 namespace grppi{
@@ -77,6 +81,12 @@ constexpr bool is_no_pattern =
   !is_filter<T> && 
   !is_pipeline<T> &&
   !is_reduce<T> &&
+  !is_time_reduce<T> &&
+  !is_keyed<T> &&
+  !is_flat_map<T> &&
+  !is_batch<T> &&
+  !is_split<T> &&
+  !is_join<T> &&
   !is_iteration<T>&&
   !is_context<T>;
 
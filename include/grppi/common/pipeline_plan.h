@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_PIPELINE_PLAN_H
+#define GRPPI_COMMON_PIPELINE_PLAN_H
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace grppi {
+
+namespace internal {
+
+template <typename Execution>
+auto enable_thread_cache(Execution & ex, int)
+    -> decltype(ex.enable_thread_cache())
+{
+  ex.enable_thread_cache();
+}
+
+template <typename Execution>
+void enable_thread_cache(Execution &, long) {}
+
+}
+
+/**
+\brief Representation of a pipeline that is built once and run many times.
+The plan keeps its own copy of the execution policy, which reuses the threads
+of previous runs when the policy supports it, and a copy of the stages. Every
+run uses fresh copies of the stages, so that no state is kept between runs.
+
+A policy that cannot be copied, as grppi::dynamic_execution, is kept by
+reference and must outlive the plan. It only reuses threads if the policy it
+wraps already does.
+\tparam Execution Execution policy type.
+\tparam Stages Types of the stages.
+*/
+template <typename Execution, typename ... Stages>
+class pipeline_plan {
+public:
+
+  /**
+  \brief Builds a plan.
+  \param ex Execution policy object.
+  \param stages Stages of the pipeline.
+  */
+  pipeline_plan(const Execution & ex, Stages ... stages) :
+    execution_{ex}, stages_{std::move(stages)...}
+  {
+    internal::enable_thread_cache(execution_, 0);
+  }
+
+  /**
+  \brief Runs the pipeline on a data stream.
+  Several runs of a plan may take place at the same time.
+  \tparam Generator Callable type for the stream generator.
+  \param generate_op Generator operation.
+  */
+  template <typename Generator>
+  void run(Generator && generate_op) const {
+    auto stages = stages_;
+    std::apply([&](auto && ... s) {
+      execution_.pipeline(std::forward<Generator>(generate_op),
+          std::move(s)...);
+    }, std::move(stages));
+  }
+
+  /**
+  \brief Get the execution policy used by the runs.
+  */
+  const Execution & execution() const noexcept { return execution_; }
+
+private:
+  using execution_type = std::conditional_t<
+      std::is_copy_constructible_v<Execution>, Execution, const Execution &>;
+
+  execution_type execution_;
+  std::tuple<Stages...> stages_;
+};
+
+}
+
+#endif
@@ -16,6 +16,10 @@
 #ifndef GRPPI_COMMON_REDUCE_PATTERN_H
 #define GRPPI_COMMON_REDUCE_PATTERN_H
 
+#include <algorithm>
+#include <type_traits>
+
+#include "window_aggregator.h"
 
 namespace grppi{
 
@@ -41,11 +45,13 @@ public:
   */
   reduce_t(int wsize, int offset, Identity id, Combiner && combine_op) :
     window_size_{wsize}, offset_{offset}, 
-    identity_{id}, combiner_{combine_op}
+    identity_{id}, combiner_{combine_op},
+    window_{id, combiner_, static_cast<std::size_t>(std::max(wsize,0)),
+        offset < wsize}
   {}
 
   /**
-  \brief Add an item to the reduction buffer.
+  \brief Add an item to the reduction window.
   If there are remaining items before reaching the next window start the
   item is discarded.
   \param item to be added.
@@ -55,7 +61,7 @@ public:
       remaining--;
     }
     else {
-      items.push_back(std::forward<Identity>(item));
+      window_.push(std::forward<Identity>(item));
     }
   }
 
@@ -64,16 +70,16 @@ public:
       remaining--;
     }
     else {
-      items.push_back(item);
+      window_.push(Identity{item});
     }
   }
 
   /**
-  \pre items.size() < static_cast<int>(std::numeric_limits<int>::max())
   \brief Check if a reduction can be performed.
   */
   bool reduction_needed() const {
-    return !items.empty() && (static_cast<int>(items.size()) >= window_size_);
+    return window_.size() > 0 &&
+        window_.size() >= static_cast<std::size_t>(window_size_);
   }
 
   /**
@@ -94,19 +100,42 @@ public:
   */
   int offset() const { return offset_; }
 
+  /**
+  \brief Get the identity value.
+  \return The identity value of the reduction object.
+  */
+  Identity identity() const { return identity_; }
+
+  /**
+  \brief Get the number of replicas reducing windows.
+  \return The number of replicas. A value of 1 means that windows are
+  reduced incrementally by the stage itself.
+  */
+  int cardinality() const { return cardinality_; }
+
+  /**
+  \brief Set the number of replicas reducing windows.
+  Backends supporting it hand every completed window to one of the replicas,
+  which reduces it from scratch. Other backends reduce windows incrementally.
+  \param n Number of replicas.
+  */
+  void set_cardinality(int n) { cardinality_ = n; }
+
   /**
   \brief Reduce values from a window.
+  The reduction of the window is kept up to date as items are added, so that
+  only the items leaving the window are processed here.
   \return The result of the reduction.
   */
   template <typename E>
-  auto reduce_window(const E & e) {
-    auto red = e.reduce(items.begin(), items.size(), identity_, combiner_);
-    if (offset_ > window_size_) {
+  auto reduce_window(const E &) {
+    auto red = window_.value();
+    if (offset_ >= window_size_) {
       remaining = offset_ - window_size_;
-      items.clear();
+      window_.clear();
     }
     else {
-      items.erase(items.begin(), std::next(items.begin(), offset_));
+      for (int i=0; i<offset_; ++i) { window_.pop(); }
     }
     return red;
   }
@@ -122,8 +151,9 @@ private:
   Identity identity_;
   Combiner combiner_;
 
-  std::vector<Identity> items{};
+  internal::window_aggregator<Identity, std::decay_t<Combiner>> window_;
   int remaining = 0;
+  int cardinality_ = 1;
 };
 
 namespace internal {
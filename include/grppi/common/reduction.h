@@ -0,0 +1,250 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_REDUCTION_H
+#define GRPPI_COMMON_REDUCTION_H
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace grppi {
+
+namespace internal {
+
+/// Transformer used by reductions that combine elements without transforming.
+struct no_transform {
+  template <typename T>
+  decltype(auto) operator()(T && x) const { return std::forward<T>(x); }
+};
+
+}
+
+/**
+\brief Representation of one of the reductions performed by a multiple
+reduction.
+\tparam Identity Type of the identity value (and the result).
+\tparam Transformer Callable type applied to every element before combining.
+\tparam Combiner Callable type for the combination operation.
+*/
+template <typename Identity, typename Transformer, typename Combiner>
+class reduction_op {
+public:
+
+  using result_type = Identity;
+
+  reduction_op(Identity identity, Transformer transform_op, Combiner combine_op) :
+    identity_{std::move(identity)},
+    transform_op_{std::move(transform_op)},
+    combine_op_{std::move(combine_op)}
+  {}
+
+  /// Get the identity value.
+  const Identity & identity() const noexcept { return identity_; }
+
+  /// Combine an accumulator with an element of the input sequence.
+  template <typename T>
+  void accumulate(Identity & acc, T && x) const
+  {
+    acc = combine_op_(acc, transform_op_(std::forward<T>(x)));
+  }
+
+  /// Combine two partial results.
+  Identity combine(const Identity & lhs, const Identity & rhs) const
+  {
+    return combine_op_(lhs, rhs);
+  }
+
+private:
+  Identity identity_;
+  Transformer transform_op_;
+  Combiner combine_op_;
+};
+
+namespace internal {
+
+template <typename T>
+struct is_reduction_op : std::false_type {};
+
+template <typename I, typename T, typename C>
+struct is_reduction_op<reduction_op<I,T,C>> : std::true_type {};
+
+}
+
+template <typename T>
+constexpr bool is_reduction_op = internal::is_reduction_op<std::decay_t<T>>::value;
+
+template <typename ... Ts>
+using requires_reduction_ops =
+  std::enable_if_t<(sizeof...(Ts)>0) && (is_reduction_op<Ts> && ...), int>;
+
+template <typename T>
+using requires_no_reduction_op = std::enable_if_t<!is_reduction_op<T>, int>;
+
+/**
+\brief Build a reduction to be used in a multiple reduction.
+\param identity Identity value for the combination.
+\param combine_op Combination operation. It must be able to combine an
+accumulator both with an element and with another accumulator.
+*/
+template <typename Identity, typename Combiner>
+auto reduction(Identity && identity, Combiner && combine_op)
+{
+  return reduction_op<std::decay_t<Identity>, internal::no_transform,
+      std::decay_t<Combiner>>{
+    std::forward<Identity>(identity), {}, std::forward<Combiner>(combine_op)};
+}
+
+/**
+\brief Build a reduction to be used in a multiple reduction, transforming
+every element before combining it.
+\param identity Identity value for the combination.
+\param transform_op Transformation applied to every element.
+\param combine_op Combination operation.
+*/
+template <typename Identity, typename Transformer, typename Combiner>
+auto reduction(Identity && identity, Transformer && transform_op,
+    Combiner && combine_op)
+{
+  return reduction_op<std::decay_t<Identity>, std::decay_t<Transformer>,
+      std::decay_t<Combiner>>{
+    std::forward<Identity>(identity),
+    std::forward<Transformer>(transform_op),
+    std::forward<Combiner>(combine_op)};
+}
+
+namespace internal {
+
+template <typename ... Reductions, std::size_t ... I>
+auto reduction_identities(const std::tuple<Reductions...> & ops,
+    std::index_sequence<I...>)
+{
+  return std::make_tuple(std::get<I>(ops).identity()...);
+}
+
+template <typename Accumulators, typename ... Reductions, typename T,
+    std::size_t ... I>
+void reduction_accumulate(Accumulators & accs,
+    const std::tuple<Reductions...> & ops, const T & x,
+    std::index_sequence<I...>)
+{
+  (std::get<I>(ops).accumulate(std::get<I>(accs), x), ...);
+}
+
+template <typename Accumulators, typename ... Reductions, std::size_t ... I>
+Accumulators reduction_combine(const Accumulators & lhs,
+    const Accumulators & rhs,
+    const std::tuple<Reductions...> & ops,
+    std::index_sequence<I...>)
+{
+  return Accumulators{std::get<I>(ops).combine(std::get<I>(lhs), std::get<I>(rhs))...};
+}
+
+/**
+\brief Sequentially reduce a chunk with multiple reductions in a single pass.
+Accumulators are kept in a struct-of-accumulators (a tuple) local to the
+calling worker.
+When every result is arithmetic and the input iterator is random access the
+chunk is split into several contiguous lanes that are traversed in an
+interleaved way. Lanes have independent dependency chains, allowing the
+compiler to pipeline and vectorize the loop. Lanes are combined in order,
+so only associativity of the combiners is required.
+*/
+template <typename InputIterator, typename ... Reductions>
+auto reduce_chunk(InputIterator first, std::size_t size,
+    const std::tuple<Reductions...> & ops)
+{
+  constexpr auto indices = std::index_sequence_for<Reductions...>{};
+  using accumulators_type =
+      std::tuple<typename Reductions::result_type...>;
+  using category =
+      typename std::iterator_traits<InputIterator>::iterator_category;
+
+  accumulators_type result = reduction_identities(ops, indices);
+
+  if constexpr (std::is_base_of<std::random_access_iterator_tag, category>::value &&
+      (std::is_arithmetic<typename Reductions::result_type>::value && ...))
+  {
+    constexpr std::size_t lanes = 4;
+    const std::size_t lane_size = size / lanes;
+    accumulators_type partials[lanes];
+    for (auto & p : partials) { p = reduction_identities(ops, indices); }
+
+    for (std::size_t i = 0; i < lane_size; ++i) {
+      for (std::size_t l = 0; l < lanes; ++l) {
+        reduction_accumulate(partials[l], ops, first[l*lane_size + i], indices);
+      }
+    }
+
+    for (auto & p : partials) {
+      result = reduction_combine(result, p, ops, indices);
+    }
+    for (std::size_t i = lanes * lane_size; i < size; ++i) {
+      reduction_accumulate(result, ops, first[i], indices);
+    }
+  }
+  else {
+    for (std::size_t i = 0; i < size; ++i) {
+      reduction_accumulate(result, ops, *first++, indices);
+    }
+  }
+  return result;
+}
+
+/**
+\brief Apply multiple reductions to a sequence in a single pass.
+The sequence is split into one chunk per worker of the execution policy.
+Each chunk is reduced with reduce_chunk() and the per-chunk tuples of
+results are combined by the map/reduce pattern of the execution policy.
+*/
+template <typename Execution, typename InputIterator, typename ... Reductions>
+auto multi_reduce(const Execution & ex, InputIterator first,
+    std::size_t sequence_size, const std::tuple<Reductions...> & ops)
+{
+  constexpr auto indices = std::index_sequence_for<Reductions...>{};
+  using accumulators_type =
+      std::tuple<typename Reductions::result_type...>;
+
+  const auto degree = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+  const auto num_chunks = std::min(degree, sequence_size);
+  if (num_chunks == 0) { return accumulators_type{reduction_identities(ops, indices)}; }
+
+  std::vector<std::size_t> chunks(num_chunks);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  const auto chunk_size = sequence_size / num_chunks;
+
+  return ex.map_reduce(std::make_tuple(chunks.begin()), num_chunks,
+      accumulators_type{reduction_identities(ops, indices)},
+      [&](std::size_t chunk) {
+        const auto delta = chunk * chunk_size;
+        const auto size = (chunk == num_chunks - 1) ?
+            sequence_size - delta : chunk_size;
+        return reduce_chunk(std::next(first, delta), size, ops);
+      },
+      [&](const accumulators_type & lhs, const accumulators_type & rhs) {
+        return reduction_combine(lhs, rhs, ops, indices);
+      });
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
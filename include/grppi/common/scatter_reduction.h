@@ -0,0 +1,184 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_SCATTER_REDUCTION_H
+#define GRPPI_COMMON_SCATTER_REDUCTION_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "accumulate.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Maximum number of privatized bins (adding the bins of every worker).
+Above this limit workers update a single set of shared atomic bins instead of
+keeping private copies.
+*/
+constexpr std::size_t max_private_bins = std::size_t{1} << 22;
+
+/**
+\brief Atomically combine a value into a shared bin.
+*/
+template <typename T, typename U, typename Combiner>
+void atomic_combine(std::atomic<T> & bin, U && value, const Combiner & combine_op)
+{
+  T expected = bin.load(std::memory_order_relaxed);
+  while (!bin.compare_exchange_weak(expected, combine_op(expected, value),
+      std::memory_order_relaxed))
+  {}
+}
+
+/**
+\brief Atomically add a value into a shared bin.
+\note Overload for additions on integral types, using a fetch-and-add
+instead of a compare-and-swap loop.
+*/
+template <typename T, typename U,
+    std::enable_if_t<std::is_integral<T>::value, int> = 0>
+void atomic_combine(std::atomic<T> & bin, U && value, const std::plus<T> &)
+{
+  bin.fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+\brief Reduce the elements of a sequence into a set of bins.
+Every element `x` is combined into the bin `index_op(x)` as
+`bin = combine_op(bin, transform_op(x))`.
+
+The sequence is split into one chunk per worker. When the privatized bins
+fit within max_private_bins every worker reduces its chunk into its own
+bins and bins are then merged in parallel, each worker merging a contiguous
+block of bins. Otherwise, for trivially copyable bins and a combiner
+returning the combined value, workers update a single set of atomic bins.
+
+Steps are run with the map pattern of the execution policy, so any
+execution policy supporting map may be used.
+*/
+template <typename Execution, typename InputIterator, typename T,
+    typename Indexer, typename Transformer, typename Combiner>
+std::vector<T> scatter_reduce(const Execution & ex,
+    InputIterator first, std::size_t sequence_size,
+    std::size_t num_bins, const T & identity,
+    Indexer && index_op, Transformer && transform_op, Combiner && combine_op)
+{
+  if (sequence_size == 0 || num_bins == 0) {
+    return std::vector<T>(num_bins, identity);
+  }
+
+  const auto degree = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+
+  const auto num_chunks = std::min(degree, sequence_size);
+  std::vector<std::size_t> chunks(num_chunks);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  const auto chunk_size = sequence_size / num_chunks;
+
+  const auto num_blocks = std::min(degree, num_bins);
+  std::vector<std::size_t> blocks(num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  const auto block_size = num_bins / num_blocks;
+
+  // Apply op(first, size) on every chunk of the sequence in parallel.
+  // Chunk ids are written back to its own sequence, as map is only used
+  // for its side effects.
+  auto for_each_chunk = [&](auto && op) {
+    ex.map(std::make_tuple(chunks.begin()), chunks.begin(), num_chunks,
+      [&](std::size_t chunk) {
+        const auto delta = chunk * chunk_size;
+        op(std::next(first, delta), (chunk == num_chunks - 1) ?
+            sequence_size - delta : chunk_size);
+        return chunk;
+      });
+  };
+
+  // Apply op(lo, hi) on every block of bins in parallel.
+  auto for_each_block = [&](auto && op) {
+    ex.map(std::make_tuple(blocks.begin()), blocks.begin(), num_blocks,
+      [&](std::size_t block) {
+        const auto lo = block * block_size;
+        op(lo, (block == num_blocks - 1) ? num_bins : lo + block_size);
+        return block;
+      });
+  };
+
+  if constexpr (std::is_trivially_copyable<T>::value &&
+      std::is_invocable_r<T, Combiner &, const T &, const T &>::value)
+  {
+    if (num_chunks > 1 && num_bins * num_chunks > max_private_bins) {
+      std::vector<std::atomic<T>> shared_bins(num_bins);
+      for_each_block([&](std::size_t lo, std::size_t hi) {
+        for (auto b = lo; b < hi; ++b) {
+          shared_bins[b].store(identity, std::memory_order_relaxed);
+        }
+      });
+      for_each_chunk([&](auto it, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i, ++it) {
+          const auto & item = *it;
+          atomic_combine(shared_bins[index_op(item)], transform_op(item),
+              combine_op);
+        }
+      });
+      std::vector<T> result(num_bins, identity);
+      for_each_block([&](std::size_t lo, std::size_t hi) {
+        for (auto b = lo; b < hi; ++b) {
+          result[b] = shared_bins[b].load(std::memory_order_relaxed);
+        }
+      });
+      return result;
+    }
+  }
+
+  std::vector<std::vector<T>> private_bins(num_chunks);
+  ex.map(std::make_tuple(chunks.begin()), private_bins.begin(), num_chunks,
+    [&](std::size_t chunk) {
+      const auto delta = chunk * chunk_size;
+      const auto size = (chunk == num_chunks - 1) ?
+          sequence_size - delta : chunk_size;
+      std::vector<T> bins(num_bins, identity);
+      auto it = std::next(first, delta);
+      for (std::size_t i = 0; i < size; ++i, ++it) {
+        const auto & item = *it;
+        combine_into(combine_op, bins[index_op(item)], transform_op(item));
+      }
+      return bins;
+    });
+
+  auto & result = private_bins[0];
+  for_each_block([&](std::size_t lo, std::size_t hi) {
+    for (std::size_t w = 1; w < num_chunks; ++w) {
+      auto & bins = private_bins[w];
+      for (auto b = lo; b < hi; ++b) {
+        combine_partial(combine_op, result[b], bins[b]);
+      }
+    }
+  });
+  return std::move(result);
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
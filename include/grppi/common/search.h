@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_SEARCH_H
+#define GRPPI_COMMON_SEARCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "cancellation.h"
+#include "optional.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Number of blocks per worker in which a search is split.
+Cancellation is checked at the beginning of every block.
+*/
+constexpr std::size_t search_blocks_per_worker = 16;
+
+/**
+\brief Find the position of an element satisfying a predicate.
+The sequence is split into blocks that are processed with the map pattern of
+the execution policy. Before processing a block, the search checks if the
+result has already been decided, and skips the block in that case. Once the
+token is cancelled, the remaining blocks are skipped as well.
+\tparam Leftmost Whether the first element satisfying the predicate is 
+required. Otherwise, any element satisfying the predicate may be returned.
+\return The position of the element or `sequence_size` if no element
+satisfies the predicate. An empty value if the token was cancelled before the
+result was decided.
+*/
+template <bool Leftmost, typename Execution, typename InputIterator,
+    typename Predicate>
+grppi::optional<std::size_t> find_index(const Execution & ex, 
+    InputIterator first, std::size_t sequence_size,
+    Predicate && predicate_op, const cancellation_token & token)
+{
+  if (sequence_size == 0) { return std::size_t{0}; }
+
+  const auto degree = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+  const auto num_blocks = std::min(degree * search_blocks_per_worker,
+      sequence_size);
+  std::vector<std::size_t> blocks(num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  const auto block_size = sequence_size / num_blocks;
+
+  std::atomic<std::size_t> found{sequence_size};
+  std::atomic<std::size_t> cancelled{sequence_size};
+  auto decided = [&](std::size_t lo) {
+    const auto pos = found.load(std::memory_order_acquire);
+    return Leftmost ? (pos < lo) : (pos < sequence_size);
+  };
+  auto lower = [](std::atomic<std::size_t> & pos, std::size_t i) {
+    auto p = pos.load(std::memory_order_relaxed);
+    while (i < p && !pos.compare_exchange_weak(p, i, 
+        std::memory_order_release, std::memory_order_relaxed))
+    {}
+  };
+
+  // Block ids are written back to its own sequence, as map is only used
+  // for its side effects.
+  ex.map(std::make_tuple(blocks.begin()), blocks.begin(), num_blocks,
+    [&](std::size_t block) {
+      const auto lo = block * block_size;
+      const auto hi = (block == num_blocks - 1) ? 
+          sequence_size : lo + block_size;
+      if (decided(lo)) { return block; }
+      if (token.is_cancelled()) { 
+        lower(cancelled, lo);
+        return block; 
+      }
+      auto it = std::next(first, lo);
+      for (auto i = lo; i < hi; ++i, ++it) {
+        if (predicate_op(*it)) {
+          lower(found, i);
+          break;
+        }
+      }
+      return block;
+    });
+
+  // A result is decided if no block that could change it was skipped
+  const auto pos = found.load();
+  const auto skipped = cancelled.load();
+  if (skipped == sequence_size || 
+      (Leftmost ? (pos < skipped) : (pos < sequence_size))) 
+  { 
+    return pos; 
+  }
+  return {};
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_SEQUENCE_TRACKER_H
+#define GRPPI_COMMON_SEQUENCE_TRACKER_H
+
+#include <iterator>
+#include <map>
+#include <utility>
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Renumbering of a stream where some items are discarded.
+Items are identified by their input sequence number, starting at 0, and may
+arrive in any order. Kept items are released in input order with contiguous
+output sequence numbers.
+
+Discarded items are not stored. A discarded item that arrives in order only
+advances the next expected number, while one that arrives early is recorded
+in a range of skipped numbers, which is merged with adjacent ranges.
+\tparam T Type of the kept items.
+*/
+template <typename T>
+class sequence_tracker {
+public:
+
+  /**
+  \brief Track a kept item.
+  \param seq Input sequence number of the item.
+  \param item Data item.
+  \param emit Callable taking every released item and its output number.
+  */
+  template <typename Emit>
+  void keep(long seq, T item, Emit && emit) {
+    if (seq != next_) {
+      pending_.emplace(seq, std::move(item));
+      return;
+    }
+    emit(std::move(item), order_++);
+    next_++;
+    release(emit);
+  }
+
+  /**
+  \brief Track a discarded item.
+  \param seq Input sequence number of the item.
+  \param emit Callable taking every released item and its output number.
+  */
+  template <typename Emit>
+  void skip(long seq, Emit && emit) {
+    if (seq != next_) {
+      add_skipped(seq);
+      return;
+    }
+    next_++;
+    release(emit);
+  }
+
+  /**
+  \brief Number of items released so far.
+  */
+  long released() const noexcept { return order_; }
+
+private:
+  template <typename Emit>
+  void release(Emit & emit) {
+    for (;;) {
+      auto skipped = skipped_.begin();
+      if (skipped != skipped_.end() && skipped->first == next_) {
+        next_ = skipped->second;
+        skipped_.erase(skipped);
+        continue;
+      }
+      auto item = pending_.begin();
+      if (item == pending_.end() || item->first != next_) { return; }
+      emit(std::move(item->second), order_++);
+      pending_.erase(item);
+      next_++;
+    }
+  }
+
+  void add_skipped(long seq) {
+    long last = seq + 1;
+    auto after = skipped_.find(last);
+    if (after != skipped_.end()) {
+      last = after->second;
+      skipped_.erase(after);
+    }
+    auto before = skipped_.lower_bound(seq);
+    if (before != skipped_.begin() && std::prev(before)->second == seq) {
+      std::prev(before)->second = last;
+    }
+    else {
+      skipped_.emplace(seq, last);
+    }
+  }
+
+  long next_ = 0;
+  long order_ = 0;
+  // Items arrived before their turn, by input sequence number
+  std::map<long,T> pending_{};
+  // Ranges [first,last) of discarded items arrived before their turn
+  std::map<long,long> skipped_{};
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_SUBRANGE_H
+#define GRPPI_COMMON_SUBRANGE_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace grppi {
+
+/**
+\brief A lightweight view of a range of indices [first,last).
+*/
+struct index_range {
+  std::size_t first = 0;
+  std::size_t last = 0;
+
+  /// Number of indices in the range.
+  std::size_t size() const noexcept { return last - first; }
+
+  /// Get the range of indices [first+lo, first+hi).
+  index_range subrange(std::size_t lo, std::size_t hi) const noexcept {
+    return {first + lo, first + hi};
+  }
+};
+
+/**
+\brief A lightweight view of a sequence given by a pair of iterators.
+\tparam Iterator Iterator type.
+*/
+template <typename Iterator>
+struct iterator_range {
+  Iterator first{};
+  Iterator last{};
+
+  Iterator begin() const { return first; }
+  Iterator end() const { return last; }
+
+  /// Number of elements in the range.
+  std::size_t size() const { 
+    return static_cast<std::size_t>(std::distance(first, last)); 
+  }
+
+  /// Get the range of elements [first+lo, first+hi).
+  iterator_range subrange(std::size_t lo, std::size_t hi) const {
+    return {std::next(first, lo), std::next(first, hi)};
+  }
+};
+
+/**
+\brief Factory function for an iterator range.
+\param first Iterator to the first element in the range.
+\param last Iterator to one past the end of the range.
+*/
+template <typename Iterator>
+iterator_range<Iterator> make_iterator_range(Iterator first, Iterator last)
+{
+  return {first, last};
+}
+
+/**
+\brief Factory function for an iterator range over a whole container.
+\param c Container.
+*/
+template <typename Container>
+auto make_iterator_range(Container & c)
+{
+  return make_iterator_range(std::begin(c), std::end(c));
+}
+
+/**
+\brief Split a range in N consecutive parts of (almost) the same size.
+This may be used as a divider in \ref md_divide-conquer.
+\tparam N Number of parts.
+\tparam Range Range type (index_range or iterator_range).
+\param r Range to be split.
+\return An array with the N parts.
+*/
+template <std::size_t N, typename Range>
+std::array<Range,N> split(const Range & r)
+{
+  static_assert(N > 0, "A range must be split in at least one part");
+  std::array<Range,N> parts;
+  const auto size = r.size();
+  std::size_t lo = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto hi = (size * (i+1)) / N;
+    parts[i] = r.subrange(lo, hi);
+    lo = hi;
+  }
+  return parts;
+}
+
+}
+
+#endif
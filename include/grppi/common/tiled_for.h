@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_TILED_FOR_H
+#define GRPPI_COMMON_TILED_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "index_space.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Default tiling for an index space.
+The first dimension is split into one tile per worker. Tiles span the whole
+extent of every other dimension.
+*/
+template <std::size_t N>
+tiling<N> default_tiling(const index_space<N> & space, std::size_t workers)
+{
+  tiling<N> result{{}, tile_schedule::static_schedule};
+  result.shape[0] = (space.extent(0) + workers - 1) / workers;
+  return result;
+}
+
+/**
+\brief Apply a body to every tile of an index space.
+Tiles are processed by workers launched with the map pattern of the execution
+policy. With a static schedule, every worker processes a contiguous block of
+tiles. With a dynamic schedule, every worker takes tiles from a shared counter
+until none is left.
+\param body Callable object taking a tile, or taking `N` indices. In the 
+latter case it is applied to every index in every tile.
+*/
+template <typename Execution, std::size_t N, typename Body>
+void tiled_for(const Execution & ex, const index_space<N> & space,
+    const tiling<N> & tiles, Body && body)
+{
+  if (space.empty()) { return; }
+
+  const tile_grid<N> grid{space, tiles.shape};
+  const auto num_tiles = grid.size();
+  const auto degree = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+  const auto num_workers = std::min(degree, num_tiles);
+  std::vector<std::size_t> workers(num_workers);
+  std::iota(workers.begin(), workers.end(), 0);
+
+  auto process_tile = [&](std::size_t t) {
+    if constexpr (std::is_invocable<Body&, const tile<N> &>::value) {
+      body(grid[t]);
+    }
+    else {
+      grid[t].for_each(body);
+    }
+  };
+
+  // Worker ids are written back to its own sequence, as map is only used
+  // for its side effects.
+  if (tiles.schedule == tile_schedule::static_schedule) {
+    ex.map(std::make_tuple(workers.begin()), workers.begin(), num_workers,
+      [&](std::size_t w) {
+        const auto lo = w * num_tiles / num_workers;
+        const auto hi = (w + 1) * num_tiles / num_workers;
+        for (auto t = lo; t < hi; ++t) { process_tile(t); }
+        return w;
+      });
+  }
+  else {
+    std::atomic<std::size_t> next_tile{0};
+    ex.map(std::make_tuple(workers.begin()), workers.begin(), num_workers,
+      [&](std::size_t w) {
+        for (;;) {
+          const auto t = next_tile.fetch_add(1, std::memory_order_relaxed);
+          if (t >= num_tiles) { break; }
+          process_tile(t);
+        }
+        return w;
+      });
+  }
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
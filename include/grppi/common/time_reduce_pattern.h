@@ -0,0 +1,220 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_TIME_REDUCE_PATTERN_H
+#define GRPPI_COMMON_TIME_REDUCE_PATTERN_H
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <utility>
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Time elapsed since the epoch for a timestamp.
+Timestamps may be given either as a time point or as a duration.
+*/
+template <typename Rep, typename Period>
+auto time_since_epoch(const std::chrono::duration<Rep,Period> & t) {
+  return t;
+}
+
+template <typename Clock, typename Duration>
+auto time_since_epoch(const std::chrono::time_point<Clock,Duration> & t) {
+  return t.time_since_epoch();
+}
+
+/**
+\brief Integer division rounding towards minus infinity.
+*/
+template <typename Rep>
+long long floor_div(Rep a, Rep b) {
+  if constexpr (std::is_floating_point_v<Rep>) {
+    return static_cast<long long>(std::floor(a / b));
+  }
+  else {
+    auto q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) { --q; }
+    return static_cast<long long>(q);
+  }
+}
+
+}
+
+/**
+\brief Representation of a time based reduce pattern.
+Represents a reduction over windows of event time that can be used as a
+stage on a pipeline. Window `k` covers the interval
+`[k*slide, k*slide+window)` since the epoch of the timestamps, so that
+windows with equal size and slide are tumbling windows and windows with a
+smaller slide are sliding windows.
+
+The watermark is the highest timestamp seen minus the allowed lateness. A
+window is closed, and its reduction emitted, as soon as the watermark reaches
+its end. Items that only belong to already closed windows are discarded.
+Windows without items are not emitted. At the end of the stream every open
+window is closed.
+\tparam Combiner Callable type for the combine operation used in the reduction.
+\tparam Identity Identity value for the combiner.
+\tparam Timestamp Callable type for extracting the timestamp of an item.
+\tparam Duration Duration type for window size, slide and lateness.
+*/
+template <typename Combiner, typename Identity, typename Timestamp,
+          typename Duration>
+class time_reduce_t {
+public:
+
+  using input_type = Identity;
+  using result_type = std::invoke_result_t<Combiner,Identity,Identity>;
+
+private:
+  using timestamp_type = decltype(internal::time_since_epoch(
+      std::declval<std::invoke_result_t<Timestamp,const Identity &>>()));
+  using tick_type = std::common_type_t<Duration,timestamp_type>;
+
+public:
+
+  /**
+  \brief Construct a time based reduction pattern object.
+  \param window Duration of every window.
+  \param slide Time between consecutive window starts.
+  \param lateness Allowed lateness for out of order items.
+  \param id Identity value.
+  \param combine_op Combiner used for the reduction.
+  \param timestamp_op Callable for extracting the timestamp of an item.
+  */
+  time_reduce_t(Duration window, Duration slide, Duration lateness,
+      Identity id, Combiner combine_op, Timestamp timestamp_op) :
+    window_{window}, slide_{slide}, lateness_{lateness},
+    identity_{id}, combiner_{std::move(combine_op)},
+    timestamp_{std::move(timestamp_op)}
+  {}
+
+  /**
+  \brief Add an item to every open window it belongs to.
+  The watermark is advanced with the timestamp of the item, possibly closing
+  one or more windows.
+  \param item to be added.
+  */
+  void add_item(const Identity & item) {
+    const tick_type t = internal::time_since_epoch(timestamp_(item));
+    auto first = internal::floor_div((t - window_).count(), slide_.count()) + 1;
+    auto last = internal::floor_div(t.count(), slide_.count());
+    if (first <= closed_) { first = closed_ + 1; }
+    for (auto k = first; k <= last; ++k) {
+      auto it = open_.try_emplace(k, identity_).first;
+      it->second = combiner_(it->second, item);
+    }
+
+    if (!started_ || t > max_time_) {
+      started_ = true;
+      max_time_ = t;
+      auto closed = internal::floor_div(
+          (max_time_ - lateness_ - window_).count(), slide_.count());
+      if (closed > closed_) { closed_ = closed; }
+    }
+  }
+
+  /**
+  \brief Check if a closed window is pending to be emitted.
+  */
+  bool reduction_needed() const {
+    return !open_.empty() && open_.begin()->first <= closed_;
+  }
+
+  /**
+  \brief Get the reduction of the oldest closed window.
+  \pre reduction_needed() is true.
+  \return The result of the reduction.
+  */
+  template <typename E>
+  auto reduce_window(const E &) {
+    auto it = open_.begin();
+    auto red = std::move(it->second);
+    open_.erase(it);
+    return red;
+  }
+
+  /**
+  \brief Close every open window.
+  Called at the end of the stream.
+  */
+  void flush() { closed_ = std::numeric_limits<long long>::max(); }
+
+  /**
+  \brief Get the combiner.
+  \return The combiner held by the reduction object.
+  */
+  Combiner combiner() const { return combiner_; }
+
+  /**
+  \brief Get the window duration.
+  */
+  Duration window_size() const {
+    return std::chrono::duration_cast<Duration>(window_);
+  }
+
+  /**
+  \brief Get the time between window starts.
+  */
+  Duration offset() const {
+    return std::chrono::duration_cast<Duration>(slide_);
+  }
+
+  /**
+  \brief Get the allowed lateness.
+  */
+  Duration lateness() const {
+    return std::chrono::duration_cast<Duration>(lateness_);
+  }
+
+private:
+  tick_type window_;
+  tick_type slide_;
+  tick_type lateness_;
+  Identity identity_;
+  Combiner combiner_;
+  Timestamp timestamp_;
+
+  std::map<long long, Identity> open_{};
+  tick_type max_time_{};
+  bool started_ = false;
+  long long closed_ = std::numeric_limits<long long>::min();
+};
+
+namespace internal {
+
+template<typename T>
+struct is_time_reduce : std::false_type {};
+
+template <typename C, typename I, typename T, typename D>
+struct is_time_reduce<time_reduce_t<C,I,T,D>> :std::true_type {};
+
+}
+
+template <typename T>
+constexpr bool is_time_reduce = internal::is_time_reduce<std::decay_t<T>>();
+
+template <typename T>
+using requires_time_reduce = std::enable_if_t<is_time_reduce<T>,int>;
+
+} // end namespace grppi
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COMMON_WINDOW_AGGREGATOR_H
+#define GRPPI_COMMON_WINDOW_AGGREGATOR_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "accumulate.h"
+
+namespace grppi {
+
+/**
+\brief Combination operation with an inverse operation.
+The inverse removes from an accumulated value the contribution of a value 
+previously combined into it, so that `inverse(combine(acc,x), x) == acc`.
+\tparam Combiner Callable type for the combination.
+\tparam Inverse Callable type for the inverse combination.
+*/
+template <typename Combiner, typename Inverse>
+class invertible_combiner {
+public:
+  invertible_combiner(Combiner combine_op, Inverse inverse_op) :
+    combine_op_{std::move(combine_op)}, inverse_op_{std::move(inverse_op)}
+  {}
+
+  /// Combine two values.
+  template <typename Acc, typename T>
+  decltype(auto) operator()(Acc && acc, T && x) const
+  {
+    return combine_op_(std::forward<Acc>(acc), std::forward<T>(x));
+  }
+
+  /// Remove a value from an accumulated value.
+  template <typename Acc, typename T>
+  decltype(auto) inverse(Acc && acc, T && x) const
+  {
+    return inverse_op_(std::forward<Acc>(acc), std::forward<T>(x));
+  }
+
+  /// Get the inverse combination.
+  const Inverse & inverse_operation() const noexcept { return inverse_op_; }
+
+private:
+  Combiner combine_op_;
+  Inverse inverse_op_;
+};
+
+namespace internal {
+
+template <typename T>
+struct is_invertible_combiner : std::false_type {};
+
+template <typename C, typename I>
+struct is_invertible_combiner<invertible_combiner<C,I>> : std::true_type {};
+
+/**
+\brief Fixed capacity FIFO buffer.
+Storage is allocated as elements are first added and then reused, so that
+adding and removing elements never shifts other elements.
+*/
+template <typename T>
+class ring_buffer {
+public:
+
+  explicit ring_buffer(std::size_t capacity) : capacity_{capacity} {}
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// Get the oldest element.
+  T & front() noexcept { return items_[head_]; }
+
+  /**
+  \brief Add an element after the newest one.
+  The capacity is doubled if the buffer is full.
+  */
+  void push_back(T && item)
+  {
+    if (size_ == capacity_) { grow(); }
+    const auto tail = (head_ + size_) % capacity_;
+    if (tail == items_.size()) { items_.push_back(std::move(item)); }
+    else { items_[tail] = std::move(item); }
+    ++size_;
+  }
+
+  /// Remove the oldest element.
+  void pop_front() noexcept
+  {
+    head_ = (head_ + 1) % capacity_;
+    --size_;
+  }
+
+  void clear() noexcept { head_ = 0; size_ = 0; }
+
+private:
+
+  void grow()
+  {
+    std::vector<T> items;
+    items.reserve(2 * capacity_);
+    for (std::size_t i = 0; i < size_; ++i) {
+      items.push_back(std::move(items_[(head_ + i) % capacity_]));
+    }
+    items_ = std::move(items);
+    head_ = 0;
+    capacity_ *= 2;
+  }
+
+  std::size_t capacity_;
+  std::vector<T> items_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+};
+
+/**
+\brief Incremental aggregation of a window of items.
+Items are added at the back of the window and evicted from its front. The
+aggregation of the window is kept up to date with:
+  - A running value, when the combiner has an inverse. Evicted items are 
+  removed with the inverse combination. Items are kept in a ring buffer.
+  Adding or evicting an item costs one combination.
+  - Two stacks, otherwise. New items are pushed to a back stack with its 
+  running aggregation. When the front stack is empty, the back stack is 
+  moved to it computing the aggregation of every suffix. Adding or evicting
+  an item costs amortized O(1) combinations.
+Items are always combined in window order, so the combiner only needs to be
+associative.
+\tparam T Type of the items and of the aggregation.
+\tparam Combiner Callable type for the combination.
+*/
+template <typename T, typename Combiner>
+class window_aggregator {
+public:
+
+  static constexpr bool invertible = is_invertible_combiner<Combiner>::value;
+
+  /**
+  \brief Construct an empty window.
+  \param identity Identity value for the combination.
+  \param combine_op Combination operation.
+  \param capacity Maximum number of items in the window.
+  \param store_items Whether items are kept to be evicted later. When false
+  the window can only be cleared.
+  */
+  window_aggregator(T identity, Combiner combine_op, std::size_t capacity,
+      bool store_items) :
+    identity_{std::move(identity)}, combine_op_{std::move(combine_op)},
+    store_items_{store_items},
+    total_{identity_}, ring_{capacity > 0 ? capacity : 1}
+  {}
+
+  /// Get the number of items in the window.
+  std::size_t size() const noexcept { return size_; }
+
+  /// Add an item to the back of the window.
+  void push(T && item)
+  {
+    combine_into(combine_op_, total_, item);
+    if (store_items_) {
+      if constexpr (invertible) { ring_.push_back(std::move(item)); }
+      else { back_.push_back(std::move(item)); }
+    }
+    ++size_;
+  }
+
+  /// Get the aggregation of the items in the window.
+  T value()
+  {
+    if constexpr (!invertible) {
+      if (!front_.empty()) {
+        T result = front_.back();
+        combine_into(combine_op_, result, total_);
+        return result;
+      }
+    }
+    return total_;
+  }
+
+  /**
+  \brief Evict the oldest item from the window.
+  \pre Items are stored and size() > 0.
+  */
+  void pop()
+  {
+    if constexpr (invertible) {
+      combine_into(combine_op_.inverse_operation(), total_, ring_.front());
+      ring_.pop_front();
+    }
+    else {
+      if (front_.empty()) { flip(); }
+      front_.pop_back();
+    }
+    --size_;
+  }
+
+  /// Evict every item from the window.
+  void clear()
+  {
+    total_ = identity_;
+    ring_.clear();
+    front_.clear();
+    back_.clear();
+    size_ = 0;
+  }
+
+private:
+
+  // Moves the back stack to the front stack, newest items first, so that
+  // the oldest item is on top, with the aggregation of the whole stack.
+  void flip()
+  {
+    T acc = identity_;
+    for (auto it = back_.rbegin(); it != back_.rend(); ++it) {
+      T suffix = std::move(*it);
+      combine_into(combine_op_, suffix, acc);
+      acc = suffix;
+      front_.push_back(std::move(suffix));
+    }
+    back_.clear();
+    total_ = identity_;
+  }
+
+  T identity_;
+  Combiner combine_op_;
+  bool store_items_;
+  T total_;
+  ring_buffer<T> ring_;
+  std::vector<T> front_;
+  std::vector<T> back_;
+  std::size_t size_ = 0;
+};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_COPY_IF_H
+#define GRPPI_COPY_IF_H
+
+#include <iterator>
+#include <utility>
+
+#include "grppi/common/range_concept.h"
+#include "grppi/common/iterator_traits.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/compaction.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup copy_if_pattern Copy if pattern
+\brief Interface for applyinng the \ref md_copy-if.
+@{
+*/
+
+/**
+\brief Invoke \ref md_copy-if on a data sequence.
+Elements satisfying the predicate are copied contiguously to the output
+sequence, keeping their relative order.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for the input sequence.
+\tparam OutputIt Iterator type used for the output sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param first_out Iterator to the first element in the output sequence.
+\param predicate_op Predicate operation.
+\return Iterator to one past the last element written.
+\pre The output sequence has room for every element in the input sequence.
+*/
+template <typename Execution, typename InputIt, typename OutputIt,
+    typename Predicate,
+    requires_iterator<InputIt> = 0,
+    requires_iterator<OutputIt> = 0>
+OutputIt copy_if(const Execution & ex,
+                 InputIt first, InputIt last, OutputIt first_out,
+                 Predicate && predicate_op)
+{
+  static_assert(supports_map<Execution>(),
+                "copy_if not supported on execution type");
+  return std::next(first_out, internal::copy_if(ex, first, 
+      std::distance(first, last), first_out,
+      std::forward<Predicate>(predicate_op)));
+}
+
+/**
+\brief Invoke \ref md_copy-if on a data range.
+Elements satisfying the predicate are copied contiguously to the output
+range, keeping their relative order.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam OutRange Range type for the output range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param rout Output range.
+\param predicate_op Predicate operation.
+\return Iterator to one past the last element written in the output range.
+\pre rout.size() >= number of elements satisfying the predicate.
+*/
+template <typename Execution, typename InRange, typename OutRange,
+    typename Predicate,
+    meta::requires_<range_concept,InRange> = 0,
+    meta::requires_<range_concept,OutRange> = 0>
+auto copy_if(const Execution & ex,
+             const InRange & rin, OutRange && rout,
+             Predicate && predicate_op)
+{
+  static_assert(supports_map<Execution>(),
+                "copy_if not supported on execution type");
+  return std::next(rout.begin(), internal::copy_if(ex, rin.begin(), 
+      rin.size(), rout.begin(), std::forward<Predicate>(predicate_op)));
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
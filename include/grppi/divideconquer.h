@@ -19,6 +19,9 @@
 #include <utility>
 
 #include "grppi/common/execution_traits.h"
+#include "grppi/common/subrange.h"
+#include "grppi/common/adaptive_cutoff.h"
+#include "grppi/seq/sequential_execution.h"
 
 namespace grppi {
 
@@ -94,6 +97,135 @@ auto divide_conquer(
         std::forward<Combiner>(combiner_op));
 }
 
+/**
+\brief Invoke \ref md_divide-conquer with an adaptive granularity.
+Problems are divided into parallel tasks only while they are greater than a
+cutoff learned at run time by a controller. Smaller problems are solved with
+sequential recursion.
+\tparam Execution Execution policy type.
+\tparam Input Type used for the input problem.
+\tparam Divider Callable type for the divider operation.
+\tparam Predicate Callable type for the stop condition predicate.
+\tparam Solver Callable type for the solver operation.
+\tparam Combiner Callable type for the combiner operation.
+\tparam SizeEstimator Callable type for the size estimator of the controller.
+\param ex Execution policy object.
+\param input Input problem to be solved.
+\param divider_op Divider operation.
+\param predicate_op Predicate operation.
+\param solver_op Solver operation.
+\param combiner_op Combiner operation.
+\param cutoff Cutoff controller. It keeps what was learned and may be 
+queried for the chosen cutoff once the problem is solved.
+*/
+template <typename Execution, typename Input,
+          typename Divider,typename Predicate, typename Solver, typename Combiner,
+          typename SizeEstimator>
+auto divide_conquer(
+    const Execution & ex,
+    Input && input,
+    Divider && divider_op,
+    Predicate && predicate_op,
+    Solver && solver_op,
+    Combiner && combiner_op,
+    adaptive_cutoff<SizeEstimator> & cutoff)
+{
+  static_assert(supports_divide_conquer<Execution>(),
+      "divide/conquer pattern not supported for execution type");
+  return internal::adaptive_divide_conquer(ex, sequential_execution{},
+        std::forward<Input>(input),
+        std::forward<Divider>(divider_op),
+        std::forward<Predicate>(predicate_op),
+        std::forward<Solver>(solver_op),
+        std::forward<Combiner>(combiner_op),
+        cutoff);
+}
+
+/**
+\brief Invoke \ref md_divide-conquer with problems solved in place.
+Problems are expected to be lightweight views (e.g. grppi::index_range or
+grppi::iterator_range) and no memory is allocated for subproblems or 
+partial results.
+\tparam Execution Execution policy type.
+\tparam Problem Type used for the problem.
+\tparam Divider Callable type for the divider operation.
+\tparam Predicate Callable type for the stop condition predicate.
+\tparam Solver Callable type for the solver operation.
+\tparam Combiner Callable type for the combiner operation.
+\param ex Execution policy object.
+\param problem Problem to be solved.
+\param divider_op Divider operation returning a std::array of subproblems.
+\param predicate_op Predicate operation.
+\param solver_op Solver operation. If it returns void, the problem is 
+assumed to be solved in place.
+\param combine_op Combiner operation. If the solver returns void, the
+combiner is invoked with the problem and the array of its solved subproblems.
+Otherwise, it combines the result of a subproblem into an accumulated
+result (in place combiners are supported).
+\return The result of solving the problem (if any).
+*/
+template <typename Execution, typename Problem,
+          typename Divider,typename Predicate, typename Solver, typename Combiner>
+auto inplace_divide_conquer(
+    const Execution & ex,
+    const Problem & problem,
+    Divider && divider_op,
+    Predicate && predicate_op,
+    Solver && solver_op,
+    Combiner && combiner_op)
+{
+  static_assert(supports_inplace_divide_conquer<Execution>(),
+      "in place divide/conquer pattern not supported for execution type");
+  return ex.inplace_divide_conquer(problem,
+        std::forward<Divider>(divider_op),
+        std::forward<Predicate>(predicate_op),
+        std::forward<Solver>(solver_op),
+        std::forward<Combiner>(combiner_op));
+}
+
+/**
+\brief Invoke \ref md_divide-conquer memoizing the result of every problem.
+Problems with the same key are solved only once, even when they are reached
+concurrently by several workers. A worker reaching a problem that is being
+solved by another worker waits for (or joins) that computation.
+\tparam Execution Execution policy type.
+\tparam Input Type used for the input problem.
+\tparam KeyExtractor Callable type for the key extractor operation.
+\tparam Divider Callable type for the divider operation.
+\tparam Predicate Callable type for the stop condition predicate.
+\tparam Solver Callable type for the solver operation.
+\tparam Combiner Callable type for the combiner operation.
+\param ex Execution policy object.
+\param input Input problem to be solved.
+\param key_op Key extractor operation. It returns a hashable key which is
+equal for problems having the same solution.
+\param divider_op Divider operation.
+\param predicate_op Predicate operation.
+\param solver_op Solver operation.
+\param combiner_op Combiner operation.
+\return The result of solving the problem.
+*/
+template <typename Execution, typename Input, typename KeyExtractor,
+          typename Divider,typename Predicate, typename Solver, typename Combiner>
+auto memoized_divide_conquer(
+    const Execution & ex,
+    const Input & input,
+    KeyExtractor && key_op,
+    Divider && divider_op,
+    Predicate && predicate_op,
+    Solver && solver_op,
+    Combiner && combiner_op)
+{
+  static_assert(supports_memoized_divide_conquer<Execution>(),
+      "memoized divide/conquer pattern not supported for execution type");
+  return ex.memoized_divide_conquer(input,
+        std::forward<KeyExtractor>(key_op),
+        std::forward<Divider>(divider_op),
+        std::forward<Predicate>(predicate_op),
+        std::forward<Solver>(solver_op),
+        std::forward<Combiner>(combiner_op));
+}
+
 /**
 @}
 @}
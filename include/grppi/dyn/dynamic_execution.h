@@ -57,6 +57,22 @@ public:
 
   bool has_execution() const { return execution_.get() != nullptr; }
 
+  /**
+  \brief Get the concurrency degree of the underlying execution policy.
+  \note Returns 1 if there is no execution policy.
+  */
+  int concurrency_degree() const noexcept {
+    return has_execution() ? execution_->concurrency_degree() : 1;
+  }
+
+  /**
+  \brief Is the underlying execution policy ordered?
+  \note Returns true if there is no execution policy.
+  */
+  bool is_ordered() const noexcept {
+    return has_execution() ? execution_->is_ordered() : true;
+  }
+
   /**
   \brief Applies a transformation to multiple sequences leaving the result in
   another sequence.
@@ -180,6 +196,27 @@ public:
                       Solver && solve_op,
                       Combiner && combine_op) const;
 
+  /**
+  \brief Invoke \ref md_divide-conquer with problems solved in place.
+  \tparam Problem Type used for the problem (usually a lightweight view).
+  \tparam Divider Callable type for the divider operation.
+  \tparam Predicate Callable type for the stop condition predicate.
+  \tparam Solver Callable type for the solver operation.
+  \tparam Combiner Callable type for the combiner operation.
+  \param problem Problem to be solved.
+  \param divider_op Divider operation returning a std::array of subproblems.
+  \param predicate_op Predicate operation.
+  \param solver_op Solver operation.
+  \param combine_op Combiner operation.
+  */
+  template <typename Problem, typename Divider, typename Predicate,
+      typename Solver, typename Combiner>
+  auto inplace_divide_conquer(const Problem & problem,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const;
+
 
   /**
   \brief Invoke \ref md_pipeline.
@@ -219,6 +256,8 @@ private:
   class execution_base {
   public:
     virtual ~execution_base() {};
+    virtual int concurrency_degree() const noexcept = 0;
+    virtual bool is_ordered() const noexcept = 0;
   };
 
   template <typename E>
@@ -226,6 +265,14 @@ private:
   public:
     execution(const E & e) : ex_{e} {}
     virtual ~execution() = default;
+    int concurrency_degree() const noexcept override {
+      if constexpr (is_supported<E>()) { return ex_.concurrency_degree(); }
+      else { return 1; }
+    }
+    bool is_ordered() const noexcept override {
+      if constexpr (is_supported<E>()) { return ex_.is_ordered(); }
+      else { return true; }
+    }
     E ex_;
   };
 
@@ -282,6 +329,14 @@ constexpr bool supports_stencil<dynamic_execution>() { return true; }
 template <>
 constexpr bool supports_divide_conquer<dynamic_execution>() { return true; }
 
+/**
+\brief Determines if an execution policy supports the in place divide/conquer
+pattern.
+\note Specialization for dynamic_execution.
+*/
+template <>
+constexpr bool supports_inplace_divide_conquer<dynamic_execution>() { return true; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note Specialization for dynamic_execution.
@@ -425,6 +480,22 @@ auto dynamic_execution::divide_conquer(
       std::forward<Combiner>(combine_op));
 }
 
+template <typename Problem, typename Divider, typename Predicate, 
+          typename Solver, typename Combiner>
+auto dynamic_execution::inplace_divide_conquer(
+    const Problem & problem,
+    Divider && divide_op,
+    Predicate && predicate_op,
+    Solver && solve_op,
+    Combiner && combine_op) const
+{
+  GRPPI_TRY_PATTERN_ALL_NOFF(inplace_divide_conquer, problem,
+      std::forward<Divider>(divide_op),
+      std::forward<Predicate>(predicate_op),
+      std::forward<Solver>(solve_op),
+      std::forward<Combiner>(combine_op));
+}
+
 template <typename Generator, typename ... Transformers>
 void dynamic_execution::pipeline(
     Generator && generate_op, 
@@ -17,6 +17,9 @@
 #define GRPPI_FARM_H
 
 #include "grppi/common/farm_pattern.h"
+#include "grppi/common/iteration_pattern.h"
+#include "grppi/common/keyed_pattern.h"
+#include "grppi/common/reduce_pattern.h"
 
 namespace grppi {
 
@@ -43,6 +46,59 @@ auto farm(int ntasks, Transformer && transform_op)
        std::forward<Transformer>(transform_op)};
 }
 
+/**
+\brief Invoke \ref md_farm on the windows of a \ref md_stream-reduce.
+Completed windows are handed to a number of replicas, each reducing a whole
+window. Windows keep their order when the execution policy is ordered.
+\tparam Combiner Callable type used for data items combination.
+\tparam Identity Type of the identity value used by the combiner.
+\param ntasks Number of replicas.
+\param reduce_obj Stream reduction whose windows are farmed.
+*/
+template <typename Combiner, typename Identity>
+auto farm(int ntasks, reduce_t<Combiner,Identity> reduce_obj)
+{
+  reduce_obj.set_cardinality(ntasks);
+  return reduce_obj;
+}
+
+/**
+\brief Invoke \ref md_farm on a \ref md_stream-iteration.
+Items are handed to a number of replicas, each one iterating an item until
+the predicate holds before taking the next one.
+\tparam Transformer Callable type or pipeline for the iteration body.
+\tparam Predicate Callable type for the iteration predicate.
+\param ntasks Number of replicas.
+\param iteration_obj Stream iteration whose items are farmed.
+*/
+template <typename Transformer, typename Predicate>
+auto farm(int ntasks, iteration_t<Transformer,Predicate> iteration_obj)
+{
+  iteration_obj.set_cardinality(ntasks);
+  return iteration_obj;
+}
+
+/**
+\brief Invoke \ref md_farm on a data stream partitioned by key,
+that can be composed in other streaming patterns.
+Every item is processed by the replica owning its key. Each key has its own
+copy of the transformer, so that per key state may be kept in the
+transformer without any locking.
+\tparam KeyExtractor Callable type for the key extraction operation.
+\tparam Transformer Callable type for the transformation operation.
+\param ntasks Number of replicas.
+\param key_op Operation returning the key of an item. Keys must be hashable.
+\param transform_op Transformer operation.
+*/
+template <typename KeyExtractor, typename Transformer>
+auto keyed_farm(int ntasks, KeyExtractor && key_op,
+    Transformer && transform_op)
+{
+  return keyed_t<std::decay_t<KeyExtractor>,std::decay_t<Transformer>>{
+      ntasks, std::forward<KeyExtractor>(key_op),
+      std::forward<Transformer>(transform_op)};
+}
+
 /**
 @}
 @}
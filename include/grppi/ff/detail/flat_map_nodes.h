@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FF_DETAIL_FLAT_MAP_NODES_H
+#define GRPPI_FF_DETAIL_FLAT_MAP_NODES_H
+
+#include "fastflow_allocator.h"
+
+#include <stdexcept>
+
+#include <ff/allocator.hpp>
+#include <ff/node.hpp>
+
+namespace grppi {
+
+namespace detail_ff {
+
+/**
+ \brief Flat map node.
+ Every output is sent out as soon as it is produced.
+ */
+template <typename Item, typename FlatMap>
+class flat_map_node : public ff::ff_node {
+public:
+  flat_map_node(const FlatMap & flat_map) : flat_map_{flat_map} {}
+  void * svc(void * p_value);
+
+private:
+  using output_type = typename FlatMap::output_type;
+
+  FlatMap flat_map_;
+};
+
+template <typename Item, typename FlatMap>
+void * flat_map_node<Item,FlatMap>::svc(void * p_value)
+{
+  Item * p_item = static_cast<Item*>(p_value);
+  flat_map_(*p_item, [this](output_type && out) {
+    ff_send_out(new (ff_arena) output_type{std::move(out)});
+  });
+  operator delete(p_item, ff_arena);
+  return GO_ON;
+}
+
+/**
+ \brief Batching node.
+ A node is only run when an item arrives, so that batches cannot expire on
+ their own. Batches with a timeout are therefore not supported. The last
+ partial batch is sent at the end of the stream.
+ \throw std::invalid_argument if the batch has a timeout.
+ */
+template <typename Item, typename Batch>
+class batch_node : public ff::ff_node {
+public:
+  batch_node(const Batch & batch) : batch_{batch} 
+  {
+    if (batch_.timeout() > Batch::clock_type::duration::zero()) {
+      throw std::invalid_argument{
+          "Batch timeouts are not supported by the FastFlow back-end"};
+    }
+  }
+  void * svc(void * p_value);
+  void eosnotify(ssize_t id) override;
+
+private:
+  using output_type = typename Batch::output_type;
+
+  Batch batch_;
+};
+
+template <typename Item, typename Batch>
+void * batch_node<Item,Batch>::svc(void * p_value)
+{
+  Item * p_item = static_cast<Item*>(p_value);
+  batch_.add_item(std::move(*p_item));
+  operator delete(p_item, ff_arena);
+  if (!batch_.full()) { return GO_ON; }
+  return new (ff_arena) output_type{batch_.take_batch()};
+}
+
+template <typename Item, typename Batch>
+void batch_node<Item,Batch>::eosnotify(ssize_t)
+{
+  if (!batch_.empty()) {
+    ff_send_out(new (ff_arena) output_type{batch_.take_batch()});
+  }
+}
+
+} // namespace detail_ff
+
+} // namespace grppi
+
+#endif
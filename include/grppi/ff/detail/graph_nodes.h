@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FF_DETAIL_GRAPH_NODES_H
+#define GRPPI_FF_DETAIL_GRAPH_NODES_H
+
+#include "fastflow_allocator.h"
+#include "../../common/graph_pattern.h"
+#include "../../seq/sequential_execution.h"
+
+#include <ff/allocator.hpp>
+#include <ff/node.hpp>
+
+#include <type_traits>
+
+namespace grppi {
+
+namespace detail_ff {
+
+/**
+ \brief Node running a split or a join.
+ Branches are run sequentially within the node. Every output is sent out as
+ soon as it is produced. Stages of the branches are closed at the end of
+ the stream.
+ */
+template <typename Item, typename Graph>
+class graph_node : public ff::ff_node {
+public:
+  graph_node(const Graph & graph) : graph_{graph} {}
+  void * svc(void * p_value);
+  void eosnotify(ssize_t id) override;
+
+private:
+  using output_type = internal::stage_output_t<Item,Graph>;
+
+  Graph graph_;
+  sequential_execution seq_{};
+};
+
+template <typename Item, typename Graph>
+void * graph_node<Item,Graph>::svc(void * p_value)
+{
+  Item * p_item = static_cast<Item*>(p_value);
+  if constexpr (std::is_void<output_type>::value) {
+    seq_.pipeline_step(*p_item, graph_);
+  }
+  else {
+    seq_.pipeline_step(*p_item, graph_, [this](output_type out) {
+      ff_send_out(new (ff_arena) output_type{std::move(out)});
+    });
+  }
+  operator delete(p_item, ff_arena);
+  return GO_ON;
+}
+
+template <typename Item, typename Graph>
+void graph_node<Item,Graph>::eosnotify(ssize_t)
+{
+  if constexpr (std::is_void<output_type>::value) {
+    seq_.pipeline_flush(graph_);
+  }
+  else {
+    seq_.pipeline_flush(graph_, [this](output_type out) {
+      ff_send_out(new (ff_arena) output_type{std::move(out)});
+    });
+  }
+}
+
+} // namespace detail_ff
+
+} // namespace grppi
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FF_DETAIL_KEYED_NODES_H
+#define GRPPI_FF_DETAIL_KEYED_NODES_H
+
+#include "fastflow_allocator.h"
+
+#include <ff/allocator.hpp>
+#include <ff/node.hpp>
+
+namespace grppi {
+
+namespace detail_ff {
+
+/**
+ \brief Keyed farm node.
+ Keys are processed by a single node, going through every shard.
+ */
+template <typename Item, typename Keyed>
+class keyed_node : public ff::ff_node {
+public:
+  keyed_node(const Keyed & keyed) : keyed_{keyed} {}
+  void * svc(void * p_value);
+
+private:
+  using output_type = typename Keyed::output_type;
+
+  Keyed keyed_;
+};
+
+template <typename Item, typename Keyed>
+void * keyed_node<Item,Keyed>::svc(void * p_value)
+{
+  Item * p_item = static_cast<Item*>(p_value);
+  auto out = keyed_(keyed_.shard(*p_item), *p_item);
+  operator delete(p_item, ff_arena);
+  if (!out) { return GO_ON; }
+  return new (ff_arena) output_type{std::move(*out)};
+}
+
+} // namespace detail_ff
+
+} // namespace grppi
+
+#endif
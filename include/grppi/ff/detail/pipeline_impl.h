@@ -19,11 +19,13 @@
 #ifdef GRPPI_FF
 
 #include "simple_node.h"
-#include "ordered_stream_reduce.h"
-#include "unordered_stream_reduce.h"
+#include "reduce_nodes.h"
 #include "ordered_stream_filter.h"
 #include "unordered_stream_filter.h"
 #include "iteration_nodes.h"
+#include "keyed_nodes.h"
+#include "flat_map_nodes.h"
+#include "graph_nodes.h"
 #include "../../common/mpmc_queue.h"
 
 
@@ -315,24 +317,113 @@ private:
     static_assert(!std::is_void<Input>::value,
         "Reduce must take non-void argument");
 
-    if(ordered_) {
-      using reducer_type = Reduce<Combiner,Identity>;
-      using node_type = ordered_stream_reduce<Input,reducer_type,Combiner>;
-      auto p_farm = std::make_unique<node_type>(
-          std::forward<reducer_type>(reduce_obj), 
-          nworkers_);
-      add_node(std::move(p_farm));
-      add_stages<Input>(std::forward<OtherTransformers>(other_transform_ops)...);
-    } 
-    else {
-      using reducer_type = Reduce<Combiner,Identity>;
-      using node_type = unordered_stream_reduce<Input,reducer_type,Combiner>;
-      auto p_farm = std::make_unique<node_type>(
-          std::forward<Reduce<Combiner,Identity>>(reduce_obj), 
-          nworkers_);
-      add_node(std::move(p_farm));
-      add_stages<Input>(std::forward<OtherTransformers>(other_transform_ops)...);
-    }
+    // Windows are reduced incrementally, which is inherently sequential
+    using reducer_type = Reduce<Combiner,Identity>;
+    using node_type = reduce_node<Input,reducer_type>;
+    auto p_stage = std::make_unique<node_type>(reduce_obj);
+    add_node(std::move(p_stage));
+    add_stages<Input>(std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
+  template <typename Input, typename TimeReduce,
+          typename ... OtherTransformers,
+          requires_time_reduce<TimeReduce> = 0>
+  auto add_stages(TimeReduce && reduce_obj,
+      OtherTransformers && ... other_transform_ops) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Reduce must take non-void argument");
+
+    using reducer_type = std::decay_t<TimeReduce>;
+    using node_type = time_reduce_node<Input,reducer_type>;
+    auto p_stage = std::make_unique<node_type>(reduce_obj);
+    add_node(std::move(p_stage));
+    add_stages<Input>(std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
+  template <typename Input, typename Keyed,
+          typename ... OtherTransformers,
+          requires_keyed<Keyed> = 0>
+  auto add_stages(Keyed && keyed_obj,
+      OtherTransformers && ... other_transform_ops) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Keyed farm must take non-void argument");
+
+    using keyed_type = std::decay_t<Keyed>;
+    using output_type = typename keyed_type::output_type;
+    using node_type = keyed_node<Input,keyed_type>;
+    auto p_stage = std::make_unique<node_type>(keyed_obj);
+    add_node(std::move(p_stage));
+    add_stages<output_type>(
+        std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
+  template <typename Input, typename FlatMap,
+          typename ... OtherTransformers,
+          requires_flat_map<FlatMap> = 0>
+  auto add_stages(FlatMap && flat_map_obj,
+      OtherTransformers && ... other_transform_ops) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Flat map must take non-void argument");
+
+    using flat_map_type = std::decay_t<FlatMap>;
+    using output_type = typename flat_map_type::output_type;
+    using node_type = flat_map_node<Input,flat_map_type>;
+    auto p_stage = std::make_unique<node_type>(flat_map_obj);
+    add_node(std::move(p_stage));
+    add_stages<output_type>(
+        std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
+  template <typename Input, typename Batch,
+          typename ... OtherTransformers,
+          requires_batch<Batch> = 0>
+  auto add_stages(Batch && batch_obj,
+      OtherTransformers && ... other_transform_ops) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Batch must take non-void argument");
+
+    using batch_type = std::decay_t<Batch>;
+    using output_type = typename batch_type::output_type;
+    using node_type = batch_node<Input,batch_type>;
+    auto p_stage = std::make_unique<node_type>(batch_obj);
+    add_node(std::move(p_stage));
+    add_stages<output_type>(
+        std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
+  template <typename Input, typename Split,
+          requires_split<Split> = 0>
+  auto add_stages(Split && split_obj) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Split must take non-void argument");
+
+    using node_type = graph_node<Input,std::decay_t<Split>>;
+    auto p_stage = std::make_unique<node_type>(split_obj);
+    add_node(std::move(p_stage));
+  }
+
+  template <typename Input, typename Graph,
+          typename ... OtherTransformers,
+          std::enable_if_t<is_split<Graph> || is_join<Graph>, int> = 0,
+          std::enable_if_t<(sizeof...(OtherTransformers) > 0), int> = 0>
+  auto add_stages(Graph && graph_obj,
+      OtherTransformers && ... other_transform_ops) 
+  {
+    static_assert(!std::is_void<Input>::value,
+        "Split or join must take non-void argument");
+
+    using graph_type = std::decay_t<Graph>;
+    using output_type = internal::stage_output_t<Input,graph_type>;
+    using node_type = graph_node<Input,graph_type>;
+    auto p_stage = std::make_unique<node_type>(graph_obj);
+    add_node(std::move(p_stage));
+    add_stages<output_type>(
+        std::forward<OtherTransformers>(other_transform_ops)...);
   }
 
   /**
@@ -342,8 +433,7 @@ private:
   template <typename Input, typename Transformer, typename Predicate,
             template <typename T, typename P> class Iteration,
             typename ... OtherTransformers,
-            requires_iteration<Iteration<Transformer,Predicate>> =0,
-            requires_no_pattern<Transformer> =0>
+            requires_iteration<Iteration<Transformer,Predicate>> =0>
   auto add_stages(Iteration<Transformer,Predicate> & iteration_obj,
       OtherTransformers && ... other_transform_ops) 
   {
@@ -359,8 +449,7 @@ private:
   template <typename Input, typename Transformer, typename Predicate,
             template <typename T, typename P> class Iteration,
             typename ... OtherTransformers,
-            requires_iteration<Iteration<Transformer,Predicate>> =0,
-            requires_no_pattern<Transformer> =0>
+            requires_iteration<Iteration<Transformer,Predicate>> =0>
   auto add_stages(Iteration<Transformer,Predicate> && iteration_obj,
       OtherTransformers && ... other_transform_ops) 
   {
@@ -368,10 +457,10 @@ private:
 
     using iteration_type = Iteration<Transformer,Predicate>;
     using worker_type = iteration_worker<Input,iteration_type>;
-    for (int i=0; i<nworkers_; ++i)
+    for (int i=0; i<iteration_obj.cardinality(); ++i)
       workers.push_back(
         std::make_unique<worker_type>(
-          std::forward<iteration_type>(iteration_obj)));
+          iteration_type{iteration_obj}));
 
     if (ordered_) {
       using node_type = ff::ff_OFarm<Input>;
@@ -387,22 +476,6 @@ private:
     }
   }
 
-  /**
-  \brief Adds a stage with an iteration object.
-  \note This version takes iteration by r-value reference.
-  \note This version takes as body of the iteration an inner pipeline.
-  */
-  template <typename Input, typename Transformer, typename Predicate,
-      template <typename T, typename P> class Iteration,
-      typename ... OtherTransformers,
-      requires_iteration<Iteration<Transformer,Predicate>> =0,
-      requires_pipeline<Transformer> =0>
-  auto add_stages(Iteration<Transformer,Predicate> && iteration_obj,
-      OtherTransformers && ... other_transform_ops) 
-  {
-    static_assert(!is_pipeline<Transformer>, "Not implemented");
-  }
-
   template <typename Input, typename Execution, typename Transformer, 
             template <typename, typename> class Context,
             typename ... OtherTransformers,
@@ -27,127 +27,76 @@ namespace grppi {
 namespace detail_ff {
 
 /**
- \brief Reduce emitter.
+ \brief Count based reduce node.
+ Windows are reduced incrementally by a single node as items arrive, and the
+ result of every window is sent as soon as the window is complete.
  */
 template <typename Item, typename Reducer>
-class reduce_emitter : public ff::ff_node {
+class reduce_node : public ff::ff_node {
 public:
-  reduce_emitter(int window_size, int offset);
+  reduce_node(const Reducer & reducer) : reducer_{reducer} {}
   void * svc(void * p_value);
 
 private:
-  void advance_large_offset(Item * p_item);
-  void advance_small_offset();
-
-private:
-  int window_size_;
-  int offset_;
-  int skip_;
-  std::vector<Item> items_;
+  Reducer reducer_;
 };
 
 template <typename Item, typename Reducer>
-reduce_emitter<Item,Reducer>::reduce_emitter(int window_size, int offset) :
-    window_size_{window_size},
-    offset_{offset},
-    skip_{-1},
-    items_{}
+void * reduce_node<Item,Reducer>::svc(void * p_value) 
 {
-    items_.reserve(window_size);
+  Item * p_item = static_cast<Item*>(p_value);
+  reducer_.add_item(*p_item);
+  operator delete(p_item, ff_arena);
+
+  if (!reducer_.reduction_needed()) { return GO_ON; }
+  constexpr ::grppi::sequential_execution seq{};
+  return new (ff_arena) Item{reducer_.reduce_window(seq)};
 }
 
+/**
+ \brief Time based reduce node.
+ Windows are sent as soon as they are closed. Windows still open are closed
+ when the end of the stream is notified.
+ */
 template <typename Item, typename Reducer>
-void * reduce_emitter<Item,Reducer>::svc(void * p_value) 
-{
-  Item * p_item = static_cast<Item*>(p_value);
+class time_reduce_node : public ff::ff_node {
+public:
+  time_reduce_node(const Reducer & reducer) : reducer_{reducer} {}
+  void * svc(void * p_value);
+  void eosnotify(ssize_t id) override;
 
-  if(static_cast<int>(items_.size()) != window_size_)
-    items_.push_back(*p_item);
+private:
+  void send_closed();
 
-  if(static_cast<int>(items_.size()) == window_size_) {
-    if(offset_ > window_size_) {
-      advance_large_offset(p_item);
-    }
-    else {
-      advance_small_offset();
-    }
-  } 
+  Reducer reducer_;
+};
 
+template <typename Item, typename Reducer>
+void * time_reduce_node<Item,Reducer>::svc(void * p_value)
+{
+  Item * p_item = static_cast<Item*>(p_value);
+  reducer_.add_item(*p_item);
   operator delete(p_item, ff_arena);
+  send_closed();
   return GO_ON;
 }
 
 template <typename Item, typename Reducer>
-void reduce_emitter<Item,Reducer>::advance_large_offset(Item * p_item) 
+void time_reduce_node<Item,Reducer>::eosnotify(ssize_t)
 {
-  if (skip_==-1) {
-    auto * p_items_to_send = new std::vector<Item>{items_};
-    ff_send_out(p_items_to_send);
-    skip_++;
-  } 
-  else if (skip_ == (offset_ - window_size_)) {
-    skip_ = -1;
-    items_.clear();
-    items_.push_back(*p_item);
-  } 
-  else {
-    skip_++;
-  }
+  reducer_.flush();
+  send_closed();
 }
 
 template <typename Item, typename Reducer>
-void reduce_emitter<Item,Reducer>::advance_small_offset() 
+void time_reduce_node<Item,Reducer>::send_closed()
 {
-  auto * p_items_to_send = new std::vector<Item>{
-      std::make_move_iterator(items_.begin()),
-      std::make_move_iterator(items_.end())};
-  auto it_last = (offset_ < window_size_) ?
-      std::next(items_.begin(), offset_) :
-      items_.end();
-  items_.erase(items_.begin(), it_last);
-  ff_send_out(p_items_to_send);
-}
-
-/**
- \brief Reduce worker.
- */
-template <typename Item, typename Combiner>
-class reduce_worker : public ff::ff_node {
-public:
-
-  reduce_worker(Combiner && combine_op) : combine_op_{combine_op} {}
-  void * svc(void * p_value);
-
-private:
-  Combiner combine_op_;
-};
-
-template <typename Item, typename Combiner>
-void * reduce_worker<Item,Combiner>::svc(void * p_value) {
-  std::vector<Item> * p_items = static_cast<std::vector<Item>*>(p_value);
-
-  Item identity{};
   constexpr ::grppi::sequential_execution seq{};
-  Item * p_result = new (ff_arena) Item{
-      ::grppi::reduce(seq, p_items->begin(), p_items->end(),
-          identity, combine_op_)
-  };
-
-  delete p_items;
-  return p_result;
+  while (reducer_.reduction_needed()) {
+    ff_send_out(new (ff_arena) Item{reducer_.reduce_window(seq)});
+  }
 }
 
-/**
- \brief Reduce collector.
- */
-class reduce_collector : public ff::ff_node {
-public:
-  reduce_collector() = default;
-
-  void * svc(void * p_value) { return p_value; }
-};
-
-
 } // namespace detail_ff
 
 } // namespace grppi
@@ -21,6 +21,7 @@
 #include "grppi/ff/detail/pipeline_impl.h"
 
 #include "../common/iterator.h"
+#include "../common/accumulate.h"
 #include "../common/execution_traits.h"
 
 #include <type_traits>
@@ -331,9 +332,12 @@ auto parallel_execution_ff::reduce(InputIterator first,
 
   pfr.parallel_reduce(result, identity, 0, sequence_size,
       [combine_op,first](long delta, auto & value) {
-        value = combine_op(value, *std::next(first,delta));
+        internal::combine_into(combine_op, value, *std::next(first,delta));
+      }, 
+      [&result, combine_op](auto a, auto b) {
+        internal::combine_partial(combine_op, a, b);
+        result = std::move(a);
       }, 
-      [&result, combine_op](auto a, auto b) { result = combine_op(a,b); }, 
       concurrency_degree_);
 
   return result;
@@ -347,13 +351,22 @@ auto parallel_execution_ff::map_reduce(std::tuple<InputIterators...> firsts,
     Transformer && transform_op,
     Combiner && combine_op) const 
 {
-  std::vector<Identity> partial_outs(sequence_size);
-  map(firsts, partial_outs.begin(), sequence_size, 
-      std::forward<Transformer>(transform_op));
+  using result_type = std::decay_t<Identity>;
+  ff::ParallelForReduce<result_type> pfr{concurrency_degree_, true};
+  result_type result{identity};
 
-  return reduce(partial_outs.begin(), sequence_size, 
-      std::forward<Identity>(identity),
-      std::forward<Combiner>(combine_op));
+  pfr.parallel_reduce(result, identity, 0, sequence_size,
+      [combine_op,&transform_op,firsts](long delta, auto & value) {
+        internal::combine_into(combine_op, value,
+            apply_iterators_indexed(transform_op, firsts, delta));
+      }, 
+      [&result, combine_op](auto a, auto b) {
+        internal::combine_partial(combine_op, a, b);
+        result = std::move(a);
+      }, 
+      concurrency_degree_);
+
+  return result;
 }
 
 template <typename ... InputIterators, typename OutputIterator,
@@ -0,0 +1,429 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FIND_H
+#define GRPPI_FIND_H
+
+#include <iterator>
+#include <utility>
+
+#include "grppi/common/range_concept.h"
+#include "grppi/common/iterator_traits.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/cancellation.h"
+#include "grppi/common/optional.h"
+#include "grppi/common/search.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup find_pattern Find pattern
+\brief Interface for applyinng the \ref md_find.
+@{
+*/
+
+/**
+\brief Invoke \ref md_find to get the first element satisfying a predicate.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\return Iterator to the first element satisfying the predicate or `last`
+if there is no such element.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+InputIt find_if(const Execution & ex,
+                InputIt first, InputIt last,
+                Predicate && predicate_op)
+{
+  static_assert(supports_map<Execution>(),
+                "find not supported on execution type");
+  return std::next(first, *internal::find_index<true>(ex, first, 
+      std::distance(first,last), std::forward<Predicate>(predicate_op),
+      cancellation_token{}));
+}
+
+/**
+\brief Invoke \ref md_find to get the first element satisfying a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return Iterator to the first element satisfying the predicate or `last`
+if there is no such element. An empty value if the token was cancelled 
+before the first element was found.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+grppi::optional<InputIt> find_if(const Execution & ex,
+                                 InputIt first, InputIt last,
+                                 Predicate && predicate_op,
+                                 const cancellation_token & token)
+{
+  static_assert(supports_map<Execution>(),
+                "find not supported on execution type");
+  const auto pos = internal::find_index<true>(ex, first, 
+      std::distance(first,last), std::forward<Predicate>(predicate_op),
+      token);
+  if (!pos) { return {}; }
+  return std::next(first, *pos);
+}
+
+/**
+\brief Invoke \ref md_find to get the first element satisfying a predicate.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\return Iterator to the first element satisfying the predicate or the end
+of the range if there is no such element.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+auto find_if(const Execution & ex,
+             InRange && rin,
+             Predicate && predicate_op)
+{
+  return grppi::find_if(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op));
+}
+
+/**
+\brief Invoke \ref md_find to get the first element satisfying a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return Iterator to the first element satisfying the predicate or the end
+of the range if there is no such element. An empty value if the token was
+cancelled before the first element was found.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+auto find_if(const Execution & ex,
+             InRange && rin,
+             Predicate && predicate_op,
+             const cancellation_token & token)
+{
+  return grppi::find_if(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op), token);
+}
+
+/**
+\brief Invoke \ref md_find to check if any element satisfies a predicate.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\return true if at least one element satisfies the predicate.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+bool any_of(const Execution & ex,
+            InputIt first, InputIt last,
+            Predicate && predicate_op)
+{
+  static_assert(supports_map<Execution>(),
+                "find not supported on execution type");
+  const auto size = static_cast<std::size_t>(std::distance(first,last));
+  return *internal::find_index<false>(ex, first, size,
+      std::forward<Predicate>(predicate_op), cancellation_token{}) < size;
+}
+
+/**
+\brief Invoke \ref md_find to check if any element satisfies a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if at least one element satisfies the predicate. An empty value
+if the token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+grppi::optional<bool> any_of(const Execution & ex,
+                             InputIt first, InputIt last,
+                             Predicate && predicate_op,
+                             const cancellation_token & token)
+{
+  static_assert(supports_map<Execution>(),
+                "find not supported on execution type");
+  const auto size = static_cast<std::size_t>(std::distance(first,last));
+  const auto pos = internal::find_index<false>(ex, first, size,
+      std::forward<Predicate>(predicate_op), token);
+  if (!pos) { return {}; }
+  return *pos < size;
+}
+
+/**
+\brief Invoke \ref md_find to check if any element satisfies a predicate.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\return true if at least one element satisfies the predicate.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+bool any_of(const Execution & ex,
+            InRange && rin,
+            Predicate && predicate_op)
+{
+  return grppi::any_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op));
+}
+
+/**
+\brief Invoke \ref md_find to check if any element satisfies a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if at least one element satisfies the predicate. An empty value
+if the token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+grppi::optional<bool> any_of(const Execution & ex,
+                             InRange && rin,
+                             Predicate && predicate_op,
+                             const cancellation_token & token)
+{
+  return grppi::any_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op), token);
+}
+
+/**
+\brief Invoke \ref md_find to check if all the elements satisfy a predicate.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\return true if every element satisfies the predicate.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+bool all_of(const Execution & ex,
+            InputIt first, InputIt last,
+            Predicate && predicate_op)
+{
+  return !grppi::any_of(ex, first, last, 
+      [&](const auto & x) { return !predicate_op(x); });
+}
+
+/**
+\brief Invoke \ref md_find to check if all the elements satisfy a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if every element satisfies the predicate. An empty value if the
+token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+grppi::optional<bool> all_of(const Execution & ex,
+                             InputIt first, InputIt last,
+                             Predicate && predicate_op,
+                             const cancellation_token & token)
+{
+  const auto any = grppi::any_of(ex, first, last, 
+      [&](const auto & x) { return !predicate_op(x); }, token);
+  if (!any) { return {}; }
+  return !*any;
+}
+
+/**
+\brief Invoke \ref md_find to check if all the elements satisfy a predicate.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\return true if every element satisfies the predicate.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+bool all_of(const Execution & ex,
+            InRange && rin,
+            Predicate && predicate_op)
+{
+  return grppi::all_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op));
+}
+
+/**
+\brief Invoke \ref md_find to check if all the elements satisfy a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if every element satisfies the predicate. An empty value if the
+token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+grppi::optional<bool> all_of(const Execution & ex,
+                             InRange && rin,
+                             Predicate && predicate_op,
+                             const cancellation_token & token)
+{
+  return grppi::all_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op), token);
+}
+
+/**
+\brief Invoke \ref md_find to check if no element satisfies a predicate.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\return true if no element satisfies the predicate.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+bool none_of(const Execution & ex,
+             InputIt first, InputIt last,
+             Predicate && predicate_op)
+{
+  return !grppi::any_of(ex, first, last, 
+      std::forward<Predicate>(predicate_op));
+}
+
+/**
+\brief Invoke \ref md_find to check if no element satisfies a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if no element satisfies the predicate. An empty value if the
+token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InputIt, typename Predicate,
+    requires_iterator<InputIt> = 0>
+grppi::optional<bool> none_of(const Execution & ex,
+                              InputIt first, InputIt last,
+                              Predicate && predicate_op,
+                              const cancellation_token & token)
+{
+  const auto any = grppi::any_of(ex, first, last, 
+      std::forward<Predicate>(predicate_op), token);
+  if (!any) { return {}; }
+  return !*any;
+}
+
+/**
+\brief Invoke \ref md_find to check if no element satisfies a predicate.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\return true if no element satisfies the predicate.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+bool none_of(const Execution & ex,
+             InRange && rin,
+             Predicate && predicate_op)
+{
+  return grppi::none_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op));
+}
+
+/**
+\brief Invoke \ref md_find to check if no element satisfies a predicate,
+unless the search is cancelled.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Predicate Callable type for the predicate.
+\param ex Execution policy object.
+\param rin Input range.
+\param predicate_op Predicate operation.
+\param token Cancellation token.
+\return true if no element satisfies the predicate. An empty value if the
+token was cancelled before the result was decided.
+*/
+template <typename Execution, typename InRange, typename Predicate,
+    meta::requires_<range_concept,InRange> = 0>
+grppi::optional<bool> none_of(const Execution & ex,
+                              InRange && rin,
+                              Predicate && predicate_op,
+                              const cancellation_token & token)
+{
+  return grppi::none_of(ex, rin.begin(), rin.end(),
+      std::forward<Predicate>(predicate_op), token);
+}
+
+/**
+@}
+@}
+*/
+}
+
+#endif
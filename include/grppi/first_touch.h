@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FIRST_TOUCH_H
+#define GRPPI_FIRST_TOUCH_H
+
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "grppi/common/execution_traits.h"
+
+namespace grppi {
+
+/**
+\brief Allocator adapter that default-initializes elements instead of
+value-initializing them.
+For trivially constructible types, elements are not written when a container
+is sized, so that memory pages are not touched until the elements are first
+assigned.
+\tparam T Element type.
+\tparam Base Adapted allocator type.
+*/
+template <typename T, typename Base = std::allocator<T>>
+class default_init_allocator : public Base {
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = default_init_allocator<U, 
+        typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+  };
+
+  using Base::Base;
+
+  default_init_allocator() = default;
+
+  template <typename U, typename B>
+  default_init_allocator(const default_init_allocator<U,B> & other) noexcept :
+    Base(static_cast<const B &>(other))
+  {}
+
+  /// Default-initialize an element.
+  template <typename U>
+  void construct(U * p) 
+      noexcept(std::is_nothrow_default_constructible<U>::value) 
+  {
+    ::new(static_cast<void*>(p)) U;
+  }
+
+  /// Construct an element from arguments.
+  template <typename U, typename ... Args>
+  void construct(U * p, Args && ... args) 
+  {
+    std::allocator_traits<Base>::construct(static_cast<Base &>(*this), p, 
+        std::forward<Args>(args)...);
+  }
+};
+
+/**
+\brief A vector whose elements are not initialized when the vector is sized.
+*/
+template <typename T>
+using first_touch_vector = std::vector<T, default_init_allocator<T>>;
+
+/**
+\brief Make a vector whose elements are first written in parallel.
+Elements are assigned with the map pattern of the execution policy. Under a 
+first-touch memory policy, every memory page is placed on the memory node of 
+the thread first writing it. Later data patterns with the same execution 
+policy and the same number of elements process every element from the same 
+chunk, and thus access local memory. With grppi::parallel_execution_native 
+the mapping of chunks to CPUs may be fixed with `enable_chunk_affinity()`.
+\tparam T Element type.
+\tparam Execution Execution policy type.
+\param ex Execution policy object.
+\param size Number of elements.
+\param value Value assigned to every element.
+\note Only trivially default constructible types are left untouched when the 
+vector is sized.
+*/
+template <typename T, typename Execution>
+first_touch_vector<T> make_first_touch_vector(const Execution & ex, 
+    std::size_t size, const T & value = T{})
+{
+  static_assert(supports_map<Execution>(),
+                "first touch not supported on execution type");
+  first_touch_vector<T> result(size);
+  // Elements are bound to a reference and never read before being assigned.
+  ex.map(std::make_tuple(result.begin()), result.begin(), size,
+      [&value](const T &) { return value; });
+  return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_FLAT_MAP_H
+#define GRPPI_FLAT_MAP_H
+
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#include "grppi/common/patterns.h"
+
+namespace grppi {
+
+/**
+\addtogroup stream_patterns
+@{
+\defgroup flat_map_pattern Flat map pattern
+\brief Interface for applying the \ref md_flat-map.
+@{
+*/
+
+/**
+\brief Invoke \ref md_flat-map on a data stream
+that can be composed in other streaming patterns.
+\tparam Transformer Callable type taking an item and a sink.
+\param transform_op Operation sending zero or more outputs for every item
+through its sink.
+*/
+template <typename Transformer>
+auto flat_map(Transformer && transform_op)
+{
+  return flat_map_t<std::decay_t<Transformer>>{
+      std::forward<Transformer>(transform_op)};
+}
+
+/**
+\brief Invoke batching of a data stream
+that can be composed in other streaming patterns.
+Batches are emitted when full or when the timeout has elapsed since their
+first item.
+\tparam T Type of the data items.
+\param n Maximum number of items in a batch.
+\param timeout Maximum time a batch waits for more items.
+*/
+template <typename T, typename Rep, typename Period>
+auto batch(int n, std::chrono::duration<Rep,Period> timeout)
+{
+  using clock_type = typename batch_t<T>::clock_type;
+  return batch_t<T>{n,
+      std::chrono::duration_cast<typename clock_type::duration>(timeout)};
+}
+
+/**
+\brief Invoke batching of a data stream without timeout
+that can be composed in other streaming patterns.
+\tparam T Type of the data items.
+\param n Number of items in a batch.
+*/
+template <typename T>
+auto batch(int n)
+{
+  return batch_t<T>{n, batch_t<T>::clock_type::duration::zero()};
+}
+
+/**
+\brief Invoke unbatching of a data stream
+that can be composed in other streaming patterns.
+Every item of a batch is sent to the next stage.
+\tparam T Type of the items in a batch.
+*/
+template <typename T>
+auto unbatch()
+{
+  return flat_map([](const std::vector<T> & items, sink<T> & out) {
+    for (const auto & item : items) { out(item); }
+  });
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
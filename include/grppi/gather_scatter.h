@@ -0,0 +1,213 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_GATHER_SCATTER_H
+#define GRPPI_GATHER_SCATTER_H
+
+#include <iterator>
+#include <utility>
+
+#include "grppi/common/range_concept.h"
+#include "grppi/common/iterator_traits.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/indexed_copy.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup gather_scatter_pattern Gather/scatter pattern
+\brief Interface for applyinng the \ref md_gather-scatter.
+@{
+*/
+
+/**
+\brief Invoke \ref md_gather-scatter gathering elements by index.
+`first_out[i] = source[first_index[i]]` for every index in the sequence.
+\tparam Execution Execution type.
+\tparam IndexIt Iterator type used for the sequence of indices.
+\tparam SourceIt Random access iterator type used for the source sequence.
+\tparam OutputIt Iterator type used for the output sequence.
+\param ex Execution policy object.
+\param first_index Iterator to the first index.
+\param last_index Iterator to one past the last index.
+\param source Iterator to the first element of the source sequence.
+\param first_out Iterator to the first element of the output sequence.
+*/
+template <typename Execution, typename IndexIt, typename SourceIt,
+    typename OutputIt,
+    requires_iterator<IndexIt> = 0,
+    requires_iterator<SourceIt> = 0,
+    requires_iterator<OutputIt> = 0>
+void gather(const Execution & ex,
+            IndexIt first_index, IndexIt last_index,
+            SourceIt source, OutputIt first_out)
+{
+  static_assert(supports_map<Execution>(),
+                "gather not supported on execution type");
+  internal::gather(ex, first_index, std::distance(first_index, last_index),
+      source, first_out);
+}
+
+/**
+\brief Invoke \ref md_gather-scatter gathering elements by index.
+`rout[i] = source[indices[i]]` for every index.
+\tparam Execution Execution type.
+\tparam IndexRange Range type for the indices.
+\tparam SourceRange Random access range type for the source.
+\tparam OutRange Range type for the output.
+\param ex Execution policy object.
+\param indices Range of indices.
+\param source Source range.
+\param rout Output range.
+\pre rout.size() == indices.size()
+*/
+template <typename Execution, typename IndexRange, typename SourceRange,
+    typename OutRange,
+    meta::requires_<range_concept,IndexRange> = 0,
+    meta::requires_<range_concept,SourceRange> = 0,
+    meta::requires_<range_concept,OutRange> = 0>
+void gather(const Execution & ex,
+            const IndexRange & indices, const SourceRange & source,
+            OutRange && rout)
+{
+  static_assert(supports_map<Execution>(),
+                "gather not supported on execution type");
+  internal::gather(ex, indices.begin(), indices.size(), source.begin(),
+      rout.begin());
+}
+
+/**
+\brief Invoke \ref md_gather-scatter scattering elements to positions given
+by index.
+`dest[first_index[i]] = first[i]` for every element in the input sequence.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for the input sequence.
+\tparam IndexIt Iterator type used for the sequence of indices.
+\tparam OutputIt Random access iterator type used for the destination.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param first_index Iterator to the first index.
+\param dest Iterator to the first element of the destination sequence.
+\note Results are unspecified if indices are not unique.
+*/
+template <typename Execution, typename InputIt, typename IndexIt,
+    typename OutputIt,
+    requires_iterator<InputIt> = 0,
+    requires_iterator<IndexIt> = 0,
+    requires_iterator<OutputIt> = 0>
+void scatter(const Execution & ex,
+             InputIt first, InputIt last,
+             IndexIt first_index, OutputIt dest)
+{
+  static_assert(supports_map<Execution>(),
+                "scatter not supported on execution type");
+  internal::scatter(ex, first, std::distance(first, last), first_index, dest);
+}
+
+/**
+\brief Invoke \ref md_gather-scatter scattering elements to positions given
+by index.
+`dest[indices[i]] = rin[i]` for every element in the input range.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input.
+\tparam IndexRange Range type for the indices.
+\tparam OutRange Random access range type for the destination.
+\param ex Execution policy object.
+\param rin Input range.
+\param indices Range of indices.
+\param dest Destination range.
+\pre indices.size() == rin.size()
+\note Results are unspecified if indices are not unique.
+*/
+template <typename Execution, typename InRange, typename IndexRange,
+    typename OutRange,
+    meta::requires_<range_concept,InRange> = 0,
+    meta::requires_<range_concept,IndexRange> = 0,
+    meta::requires_<range_concept,OutRange> = 0>
+void scatter(const Execution & ex,
+             const InRange & rin, const IndexRange & indices,
+             OutRange && dest)
+{
+  static_assert(supports_map<Execution>(),
+                "scatter not supported on execution type");
+  internal::scatter(ex, rin.begin(), rin.size(), indices.begin(), 
+      dest.begin());
+}
+
+/**
+\brief Invoke \ref md_gather-scatter applying a permutation.
+`rout[i] = rin[perm[i]]` for every position.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input.
+\tparam PermRange Range type for the permutation.
+\tparam OutRange Range type for the output.
+\param ex Execution policy object.
+\param rin Input range.
+\param perm Permutation of the positions in the input range.
+\param rout Output range.
+\pre rin.size() == perm.size() && rout.size() == perm.size()
+*/
+template <typename Execution, typename InRange, typename PermRange,
+    typename OutRange,
+    meta::requires_<range_concept,InRange> = 0,
+    meta::requires_<range_concept,PermRange> = 0,
+    meta::requires_<range_concept,OutRange> = 0>
+void permute(const Execution & ex,
+             const InRange & rin, const PermRange & perm,
+             OutRange && rout)
+{
+  static_assert(supports_map<Execution>(),
+                "permute not supported on execution type");
+  internal::gather(ex, perm.begin(), perm.size(), rin.begin(), rout.begin());
+}
+
+/**
+\brief Invoke \ref md_gather-scatter applying the inverse of a permutation.
+`rout[perm[i]] = rin[i]` for every position.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input.
+\tparam PermRange Range type for the permutation.
+\tparam OutRange Range type for the output.
+\param ex Execution policy object.
+\param rin Input range.
+\param perm Permutation of the positions in the output range.
+\param rout Output range.
+\pre rin.size() == perm.size() && rout.size() == perm.size()
+*/
+template <typename Execution, typename InRange, typename PermRange,
+    typename OutRange,
+    meta::requires_<range_concept,InRange> = 0,
+    meta::requires_<range_concept,PermRange> = 0,
+    meta::requires_<range_concept,OutRange> = 0>
+void inverse_permute(const Execution & ex,
+                     const InRange & rin, const PermRange & perm,
+                     OutRange && rout)
+{
+  static_assert(supports_map<Execution>(),
+                "inverse_permute not supported on execution type");
+  internal::scatter(ex, rin.begin(), rin.size(), perm.begin(), rout.begin());
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
@@ -20,9 +20,16 @@
 #include "grppi/dyn/dynamic_execution.h"
 
 // Includes for data parallel patterns
+#include "copy_if.h"
+#include "find.h"
+#include "incremental_reduce.h"
+#include "first_touch.h"
+#include "gather_scatter.h"
 #include "map.h"
 #include "mapreduce.h"
+#include "parallel_for.h"
 #include "reduce.h"
+#include "scatter_reduce.h"
 #include "stencil.h"
 
 namespace grppi {
@@ -46,13 +53,18 @@ namespace grppi {
 }
 
 // Includes for streaming patterns
+#include "async_pipeline.h"
 #include "context.h"
 #include "farm.h"
+#include "flat_map.h"
 #include "pipeline.h"
+#include "pipeline_plan.h"
 #include "stream_filter.h"
+#include "stream_graph.h"
 #include "stream_iteration.h"
 #include "stream_reduce.h"
 #include "stream_pool.h"
+#include "worker_local.h"
 
 namespace grppi {
 
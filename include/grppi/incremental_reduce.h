@@ -0,0 +1,297 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_INCREMENTAL_REDUCE_H
+#define GRPPI_INCREMENTAL_REDUCE_H
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "grppi/common/range_concept.h"
+#include "grppi/common/iterator_traits.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/accumulate.h"
+#include "grppi/common/reduction.h"
+#include "grppi/seq/sequential_execution.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup incremental_reduce_pattern Incremental reduce pattern
+\brief Interface for the incremental variant of \ref md_reduce.
+@{
+*/
+
+/**
+\brief Default number of elements in a block of an incremental reduction.
+*/
+constexpr std::size_t incremental_block_size = 4096;
+
+/**
+\brief Reduction of a sequence that is kept up to date as elements change.
+The sequence is split into fixed size blocks. The reduction of every block
+is cached, as well as a balanced tree combining the blocks in sequence 
+order. After some elements are modified and notified with invalidate(), 
+value() only reduces again the modified blocks, in parallel, and the tree 
+nodes above them.
+\tparam Iterator Iterator type for the sequence.
+\tparam Result Type of the result.
+\tparam Transformer Callable type for the transformation, or 
+internal::no_transform for a plain reduction.
+\tparam Combiner Callable type for the combination.
+\note The sequence must be kept alive and must not be resized while the 
+object is in use. Notifications and queries must not be concurrent.
+*/
+template <typename Iterator, typename Result, typename Transformer,
+    typename Combiner>
+class incremental_reduction {
+public:
+
+  using result_type = Result;
+
+  /**
+  \brief Construct an incremental reduction. 
+  Every block is dirty until the first call to value().
+  \param first Iterator to the first element of the sequence.
+  \param size Number of elements in the sequence.
+  \param identity Identity value for the combination.
+  \param transform_op Transformation operation.
+  \param combine_op Combination operation.
+  \param block_size Number of elements in a block.
+  */
+  incremental_reduction(Iterator first, std::size_t size, Result identity,
+      Transformer transform_op, Combiner combine_op, 
+      std::size_t block_size = incremental_block_size) :
+    first_{first}, size_{size}, 
+    block_size_{std::max<std::size_t>(block_size, 1)},
+    block_count_{(size_ + block_size_ - 1) / block_size_},
+    identity_{std::move(identity)},
+    transform_op_{std::move(transform_op)},
+    combine_op_{std::move(combine_op)},
+    dirty_flags_(block_count_, 0)
+  {
+    while (leaf_count_ < block_count_) { leaf_count_ *= 2; }
+    tree_.assign(2 * leaf_count_, identity_);
+    invalidate_all();
+  }
+
+  /// Get the number of elements in the sequence.
+  std::size_t size() const noexcept { return size_; }
+
+  /// Get the number of elements in a block.
+  std::size_t block_size() const noexcept { return block_size_; }
+
+  /// Get the number of blocks.
+  std::size_t block_count() const noexcept { return block_count_; }
+
+  /// Get the number of blocks to be reduced again in the next query.
+  std::size_t dirty_blocks() const noexcept { return dirty_.size(); }
+
+  /**
+  \brief Notify that an element has been modified.
+  \param index Index of the element.
+  */
+  void invalidate(std::size_t index) { invalidate(index, index+1); }
+
+  /**
+  \brief Notify that a range of elements has been modified.
+  \param first Index of the first modified element.
+  \param last Index of one past the last modified element.
+  */
+  void invalidate(std::size_t first, std::size_t last)
+  {
+    last = std::min(last, size_);
+    if (first >= last) return;
+    for (auto b = first / block_size_; b <= (last-1) / block_size_; ++b) {
+      if (!dirty_flags_[b]) {
+        dirty_flags_[b] = 1;
+        dirty_.push_back(b);
+      }
+    }
+  }
+
+  /**
+  \brief Notify that every element has been modified.
+  */
+  void invalidate_all() { invalidate(0, size_); }
+
+  /**
+  \brief Get the reduction of the sequence.
+  Dirty blocks are reduced again in parallel with the map pattern of the
+  execution policy. Then the nodes of the combination tree above them are
+  updated.
+  \tparam Execution Execution policy type.
+  \param ex Execution policy object.
+  */
+  template <typename Execution>
+  const result_type & value(const Execution & ex)
+  {
+    static_assert(supports_map<Execution>(),
+                  "incremental reduce not supported on execution type");
+    if (!dirty_.empty()) {
+      update(ex);
+    }
+    return tree_[1];
+  }
+
+private:
+
+  template <typename Execution>
+  void update(const Execution & ex)
+  {
+    std::sort(dirty_.begin(), dirty_.end());
+    // Block ids are written back to their own sequence, as map is only used
+    // for its side effects.
+    ex.map(std::make_tuple(dirty_.begin()), dirty_.begin(), dirty_.size(),
+        [this](std::size_t b) {
+          tree_[leaf_count_ + b] = reduce_block(b);
+          return b;
+        });
+
+    std::vector<std::size_t> nodes;
+    nodes.reserve(dirty_.size());
+    for (auto b : dirty_) { 
+      dirty_flags_[b] = 0;
+      nodes.push_back(leaf_count_ + b); 
+    }
+    dirty_.clear();
+
+    while (nodes.front() > 1) {
+      for (auto & n : nodes) { n /= 2; }
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+      for (auto n : nodes) {
+        tree_[n] = tree_[2*n];
+        internal::combine_into(combine_op_, tree_[n], tree_[2*n+1]);
+      }
+    }
+  }
+
+  result_type reduce_block(std::size_t b) const
+  {
+    constexpr sequential_execution seq;
+    const auto first = std::next(first_, b * block_size_);
+    const auto n = std::min(block_size_, size_ - b * block_size_);
+    auto identity = identity_;
+    auto combine_op = combine_op_;
+    if constexpr (std::is_same<Transformer, internal::no_transform>::value) {
+      return seq.reduce(first, n, std::move(identity), combine_op);
+    }
+    else {
+      auto transform_op = transform_op_;
+      return seq.map_reduce(std::make_tuple(first), n, std::move(identity),
+          transform_op, combine_op);
+    }
+  }
+
+  Iterator first_;
+  std::size_t size_;
+  std::size_t block_size_;
+  std::size_t block_count_;
+  std::size_t leaf_count_ = 1;
+  Result identity_;
+  Transformer transform_op_;
+  Combiner combine_op_;
+  std::vector<result_type> tree_;
+  std::vector<unsigned char> dirty_flags_;
+  std::vector<std::size_t> dirty_;
+};
+
+/**
+\brief Make an incremental reduction of a data sequence.
+\tparam InputIt Iterator type used for the input sequence.
+\tparam Identity Type for the identity value.
+\tparam Combiner Callable type for the combiner operation.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param identity Identity value for the combiner operation.
+\param combine_op Combiner operation.
+\param block_size Number of elements in a block.
+*/
+template <typename InputIt, typename Identity, typename Combiner,
+    requires_iterator<InputIt> = 0>
+auto make_incremental_reduce(InputIt first, InputIt last,
+    Identity && identity, Combiner && combine_op,
+    std::size_t block_size = incremental_block_size)
+{
+  return incremental_reduction<InputIt, std::decay_t<Identity>,
+      internal::no_transform, std::decay_t<Combiner>>{
+      first, static_cast<std::size_t>(std::distance(first, last)),
+      std::forward<Identity>(identity), {}, 
+      std::forward<Combiner>(combine_op), block_size};
+}
+
+/**
+\brief Make an incremental reduction of a data range.
+\tparam InRange Range type for the input range.
+\tparam Identity Type for the identity value.
+\tparam Combiner Callable type for the combiner operation.
+\param rin Input range.
+\param identity Identity value for the combiner operation.
+\param combine_op Combiner operation.
+\param block_size Number of elements in a block.
+*/
+template <typename InRange, typename Identity, typename Combiner,
+    meta::requires_<range_concept,InRange> = 0>
+auto make_incremental_reduce(InRange & rin, 
+    Identity && identity, Combiner && combine_op,
+    std::size_t block_size = incremental_block_size)
+{
+  return make_incremental_reduce(rin.begin(), rin.end(),
+      std::forward<Identity>(identity), std::forward<Combiner>(combine_op),
+      block_size);
+}
+
+/**
+\brief Make an incremental map/reduce of a data range.
+\tparam InRange Range type for the input range.
+\tparam Identity Type for the identity value.
+\tparam Transformer Callable type for the transformation operation.
+\tparam Combiner Callable type for the combiner operation.
+\param rin Input range.
+\param identity Identity value for the combiner operation.
+\param transform_op Transformation operation.
+\param combine_op Combiner operation.
+\param block_size Number of elements in a block.
+*/
+template <typename InRange, typename Identity, typename Transformer,
+    typename Combiner,
+    meta::requires_<range_concept,InRange> = 0>
+auto make_incremental_map_reduce(InRange & rin, 
+    Identity && identity, Transformer && transform_op, Combiner && combine_op,
+    std::size_t block_size = incremental_block_size)
+{
+  using iterator_type = decltype(rin.begin());
+  return incremental_reduction<iterator_type, std::decay_t<Identity>,
+      std::decay_t<Transformer>, std::decay_t<Combiner>>{
+      rin.begin(), static_cast<std::size_t>(rin.size()),
+      std::forward<Identity>(identity), 
+      std::forward<Transformer>(transform_op),
+      std::forward<Combiner>(combine_op), block_size};
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <tuple>
 
 #include "grppi/common/zip_view.h"
+#include "grppi/common/lazy_view.h"
 #include "grppi/common/execution_traits.h"
 #include "grppi/common/iterator_traits.h"
 
@@ -133,6 +134,36 @@ namespace grppi {
         range_out.size(), transform_op);
   }
 
+/**
+\brief Invoke \ref md_map on a lazy view.
+All the stages in the view and the transformation are fused in a single pass
+without intermediate storage.
+\tparam Execution Execution policy type.
+\tparam View Lazy view type for the input.
+\tparam OutRange Range type for the output range.
+\tparam Transformer Callable type for the transformation operation.
+\param ex Execution policy object.
+\param view Lazy view over the input sequences.
+\param range_out Output range.
+\param transform_op Transformation operation.
+\pre view.size() == range_out.size()
+*/
+  template<typename Execution, typename View, typename OutRange,
+      typename Transformer,
+      requires_lazy_view<View> = 0,
+      meta::requires_<range_concept, OutRange> = 0>
+  void map(const Execution & ex, View && view,
+      OutRange && range_out,
+      Transformer transform_op)
+  {
+    static_assert(supports_map<Execution>(),
+        "map not supported on execution type");
+    static_assert(!std::decay_t<View>::has_filter,
+        "map cannot be applied to a lazy view with filters");
+    ex.map(view.begin(), range_out.begin(), view.size(),
+        view.transformer(transform_op));
+  }
+
 /**
 \brief Invoke \ref md_map on a data sequence.
 \tparam InputIt Iterator type used for input sequence.
@@ -20,6 +20,7 @@
 #include <tuple>
 
 #include "grppi/common/zip_view.h"
+#include "grppi/common/lazy_view.h"
 #include "grppi/common/execution_traits.h"
 #include "grppi/common/iterator_traits.h"
 
@@ -94,6 +95,38 @@ auto map_reduce(const Execution & ex,
                        std::forward<Combiner>(combine_op));
 }
 
+/**
+\brief Invoke \ref md_map-reduce on a lazy view.
+All the stages in the view and the transformation are fused in a single pass.
+\tparam Execution Execution type.
+\tparam View Lazy view type for the input.
+\tparam Identity Type for the identity value.
+\tparam Transformer Callable type for the transformation operation.
+\tparam Combiner Callable type for the combination operation of the reduction.
+\param ex Execution policy object.
+\param view Lazy view over the input sequences.
+\param identity Identity value for the combination operation.
+\param transf_op Transformation operation.
+\param combine_op Combination operation.
+\return Result of the map/reduce operation.
+\note Elements discarded by filter stages in the view are not combined.
+*/
+template <typename Execution, typename View,
+    typename Identity, typename Transformer, typename Combiner,
+    requires_lazy_view<View> = 0>
+auto map_reduce(const Execution & ex,
+                View && view,
+                Identity && identity,
+                Transformer && transform_op, Combiner && combine_op)
+{
+  static_assert(supports_map_reduce<Execution>(),
+                "map/reduce not supported on execution type");
+  return ex.map_reduce(view.begin(), view.size(),
+                       std::forward<Identity>(identity),
+                       view.transformer(std::forward<Transformer>(transform_op)),
+                       view.combiner(std::forward<Combiner>(combine_op)));
+}
+
 /**
 \brief Invoke \ref md_map-reduce on a data sequence.
 \tparam Execution Execution type.
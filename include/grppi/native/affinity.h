@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_NATIVE_AFFINITY_H
+#define GRPPI_NATIVE_AFFINITY_H
+
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Get the CPUs available to the process.
+The set is taken once from the affinity mask of the first thread asking 
+for it. 
+\return The identifiers of the CPUs, or an empty vector when thread affinity 
+is not supported in the platform.
+*/
+inline const std::vector<int> & available_cpus()
+{
+  static const std::vector<int> cpus = []() {
+    std::vector<int> result;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &mask)) { result.push_back(cpu); }
+      }
+    }
+#endif
+    return result;
+  }();
+  return cpus;
+}
+
+/**
+\brief Scoped binding of the current thread to a CPU.
+The previous affinity of the thread is restored on destruction.
+A default constructed object does not change the thread affinity.
+*/
+class thread_binding {
+public:
+
+  thread_binding() noexcept = default;
+
+  /**
+  \brief Bind the current thread to the CPU used for a chunk.
+  Chunks are assigned to available CPUs in round-robin order, so that a given
+  chunk is always processed on the same CPU.
+  \param chunk Index of the chunk.
+  */
+  explicit thread_binding(int chunk) noexcept :
+    thread_binding{available_cpus(), chunk}
+  {}
+
+  /**
+  \brief Bind the current thread to a CPU from a list.
+  \param cpus Identifiers of the CPUs.
+  \param index Index in the list, taken in round-robin order.
+  */
+  thread_binding(const std::vector<int> & cpus, int index) noexcept
+  {
+#ifdef __linux__
+    if (cpus.empty() || index < 0) return;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(previous_), 
+        &previous_) != 0) return;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpus[index % cpus.size()], &mask);
+    bound_ = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+    (void) cpus;
+    (void) index;
+#endif
+  }
+
+  thread_binding(const thread_binding &) = delete;
+  thread_binding & operator=(const thread_binding &) = delete;
+
+  ~thread_binding()
+  {
+#ifdef __linux__
+    if (bound_) {
+      pthread_setaffinity_np(pthread_self(), sizeof(previous_), &previous_);
+    }
+#endif
+  }
+
+  /// Check if the thread was bound to a CPU.
+  bool bound() const noexcept { return bound_; }
+
+private:
+  bool bound_ = false;
+#ifdef __linux__
+  cpu_set_t previous_;
+#endif
+};
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
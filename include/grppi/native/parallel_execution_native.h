@@ -17,16 +17,26 @@
 #define GRPPI_NATIVE_PARALLEL_EXECUTION_NATIVE_H
 
 #include "worker_pool.h"
+#include "affinity.h"
+#include "topology.h"
 #include "../common/optional.h"
 #include "../common/mpmc_queue.h"
 #include "../common/iterator.h"
+#include "../common/accumulate.h"
+#include "../common/inplace_divide_conquer.h"
+#include "../common/memoized_divide_conquer.h"
 #include "../common/execution_traits.h"
 #include "../common/configuration.h"
+#include "../common/sequence_tracker.h"
 
 #include <thread>
 #include <atomic>
 #include <algorithm>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <array>
 #include <type_traits>
 #include <tuple>
 #include <sstream>
@@ -40,9 +50,10 @@ namespace grppi {
 
 A thread table provides a simple way to offer thread indices (starting from 0).
 
-When a thread registers itself in the registry, its id is added to the vector 
-of identifiers. When a thread deregisters itself from the registry its entry
-is modified to contain the empty thread id.
+When a thread registers itself in the registry, its id is stored in the first
+free entry of the vector of identifiers, which is extended if there is none.
+When a thread deregisters itself from the registry its entry is modified to
+contain the empty thread id, so that it can be reused by later threads.
 
 To get an integer index, users may call `current_index`, which provides the order
 number of the calling thread in the registry.
@@ -80,7 +91,9 @@ inline void thread_registry::register_thread() noexcept
   using namespace std;
   while (lock_.test_and_set(memory_order_acquire)) {}
   auto this_id = this_thread::get_id();
-  ids_.push_back(this_id);
+  auto free = find(begin(ids_), end(ids_), thread::id{});
+  if (free != end(ids_)) { *free = this_id; }
+  else { ids_.push_back(this_id); }
   lock_.clear(memory_order_release);
 }
 
@@ -171,12 +184,22 @@ public:
 
   parallel_execution_native(const parallel_execution_native & ex) :
       parallel_execution_native{ex.concurrency_degree_, ex.ordering_}
-  {}
+  {
+    chunk_affinity_ = ex.chunk_affinity_;
+    topology_aware_ = ex.topology_aware_;
+    worker_cpus_ = ex.worker_cpus_;
+    thread_cache_ = ex.thread_cache_;
+  }
 
   /**
   \brief Set number of grppi threads.
+  \note When execution is topology aware, the CPU of every thread is 
+  computed again.
   */
-  void set_concurrency_degree(int degree) noexcept { concurrency_degree_ = degree; }
+  void set_concurrency_degree(int degree) { 
+    concurrency_degree_ = degree; 
+    if (topology_aware_) { update_worker_cpus(); }
+  }
 
   /**
   \brief Get number of grppi threads.
@@ -198,6 +221,92 @@ public:
   */
   bool is_ordered() const noexcept { return ordering_; }
 
+  /**
+  \brief Enable a fixed mapping of data chunks to CPUs.
+  Data patterns (map, reduce, map/reduce and stencil) split data into one 
+  chunk per thread. When enabled, the thread processing the i-th chunk is 
+  bound to the same CPU in every pattern, so that data first touched by a 
+  chunk (see grppi::make_first_touch_vector()) stays local to the thread 
+  processing it later.
+  \note Only effective on Linux. Elsewhere threads are never bound.
+  */
+  void enable_chunk_affinity() noexcept { chunk_affinity_=true; }
+
+  /**
+  \brief Disable a fixed mapping of data chunks to CPUs.
+  */
+  void disable_chunk_affinity() noexcept { chunk_affinity_=false; }
+
+  /**
+  \brief Is the mapping of data chunks to CPUs fixed.
+  */
+  bool is_chunk_affinity_enabled() const noexcept { return chunk_affinity_; }
+
+  /**
+  \brief Bind the current thread to the CPU of a data chunk, if the mapping
+  of chunks to CPUs is enabled or execution is topology aware.
+  \return A binding object restoring the thread affinity when destroyed.
+  */
+  internal::thread_binding bind_to_chunk(int chunk) const {
+    if (topology_aware_ && worker_cpus_) {
+      return internal::thread_binding{*worker_cpus_, chunk};
+    }
+    return chunk_affinity_ ? 
+        internal::thread_binding{chunk} : internal::thread_binding{};
+  }
+
+  /**
+  \brief Enable topology aware execution.
+  Threads are grouped by memory domain (CPUs sharing a socket and an L3 
+  cache, as found in `/sys/devices/system/cpu`), and every thread is bound 
+  to a CPU in the domain of its group:
+    - Reductions (reduce and map/reduce) first combine the partial results 
+      within each domain and then combine one value per domain.
+    - Farm replicas in the same domain share an input queue, which is fed 
+      by a distributor thread.
+  \note Grouping only has effect on systems with more than one domain, and 
+  threads are only bound on Linux.
+  */
+  void enable_topology_awareness() { 
+    topology_aware_=true; 
+    update_worker_cpus();
+  }
+
+  /**
+  \brief Disable topology aware execution.
+  */
+  void disable_topology_awareness() noexcept { 
+    topology_aware_=false; 
+    worker_cpus_.reset();
+  }
+
+  /**
+  \brief Is execution topology aware.
+  */
+  bool is_topology_aware() const noexcept { return topology_aware_; }
+
+  /**
+  \brief Enable the reuse of threads.
+  Threads launched by patterns are parked when their tasks finish, and later
+  patterns run by this policy, or by its copies, take parked threads instead
+  of creating new ones.
+  */
+  void enable_thread_cache() {
+    if (!thread_cache_) { thread_cache_ = std::make_shared<thread_cache>(); }
+  }
+
+  /**
+  \brief Disable the reuse of threads.
+  Parked threads are joined once no copy of the policy uses them.
+  */
+  void disable_thread_cache() noexcept { thread_cache_.reset(); }
+
+  /**
+  \brief Get the cache of parked threads.
+  \return A pointer to the cache, or null if threads are not reused.
+  */
+  thread_cache * cached_threads() const noexcept { return thread_cache_.get(); }
+
   /**
   \brief Get a manager object for registration/deregistration in the
   thread index table for current thread.
@@ -380,6 +489,51 @@ public:
                       Solver && solve_op,
                       Combiner && combine_op) const;
 
+  /**
+  \brief Invoke \ref md_divide-conquer with problems solved in place.
+  \tparam Problem Type used for the problem (usually a lightweight view).
+  \tparam Divider Callable type for the divider operation.
+  \tparam Predicate Callable type for the stop condition predicate.
+  \tparam Solver Callable type for the solver operation.
+  \tparam Combiner Callable type for the combiner operation.
+  \param problem Problem to be solved.
+  \param divider_op Divider operation returning a std::array of subproblems.
+  \param predicate_op Predicate operation.
+  \param solver_op Solver operation.
+  \param combine_op Combiner operation.
+  */
+  template <typename Problem, typename Divider, typename Predicate,
+      typename Solver, typename Combiner>
+  auto inplace_divide_conquer(const Problem & problem,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const;
+
+  /**
+  \brief Invoke \ref md_divide-conquer memoizing the result of every problem.
+  \tparam Input Type used for the input problem.
+  \tparam KeyExtractor Callable type for the key extractor operation.
+  \tparam Divider Callable type for the divider operation.
+  \tparam Predicate Callable type for the stop condition predicate.
+  \tparam Solver Callable type for the solver operation.
+  \tparam Combiner Callable type for the combiner operation.
+  \param input Input problem to be solved.
+  \param key_op Key extractor operation.
+  \param divider_op Divider operation.
+  \param predicate_op Predicate operation.
+  \param solver_op Solver operation.
+  \param combine_op Combiner operation.
+  */
+  template <typename Input, typename KeyExtractor, typename Divider, 
+      typename Predicate, typename Solver, typename Combiner>
+  auto memoized_divide_conquer(const Input & input,
+      KeyExtractor && key_op,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const;
+
 
 
   /**
@@ -561,11 +715,55 @@ private:
   void do_pipeline(Queue && input_queue, Reduce<Combiner,Identity> && reduce_obj,
                    OtherTransformers && ... other_transform_ops) const;
 
+  template <typename Queue, typename TimeReduce,
+            typename ... OtherTransformers,
+            requires_time_reduce<TimeReduce> = 0>
+  void do_pipeline(Queue && input_queue, TimeReduce && reduce_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename Queue, typename Reduce,
+            typename ... OtherTransformers>
+  void do_farmed_reduce(Queue & input_queue, Reduce & reduce_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename Queue, typename Keyed,
+            typename ... OtherTransformers,
+            requires_keyed<Keyed> = 0>
+  void do_pipeline(Queue & input_queue, Keyed && keyed_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename InputQueue, typename OutputQueue>
+  void emit_ordered(InputQueue & input_queue,
+                    OutputQueue & output_queue) const;
+
+  template <typename Queue, typename FlatMap,
+            typename ... OtherTransformers,
+            requires_flat_map<FlatMap> = 0>
+  void do_pipeline(Queue & input_queue, FlatMap && flat_map_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename Queue, typename Batch,
+            typename ... OtherTransformers,
+            requires_batch<Batch> = 0>
+  void do_pipeline(Queue & input_queue, Batch && batch_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename Queue, typename Split,
+            typename ... OtherTransformers,
+            requires_split<Split> = 0>
+  void do_pipeline(Queue & input_queue, Split && split_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
+  template <typename Queue, typename Join,
+            typename ... OtherTransformers,
+            requires_join<Join> = 0>
+  void do_pipeline(Queue & input_queue, Join && join_obj,
+                   OtherTransformers && ... other_transform_ops) const;
+
   template <typename Queue, typename Transformer, typename Predicate,
             template <typename T, typename P> class Iteration,
             typename ... OtherTransformers,
-            requires_iteration<Iteration<Transformer,Predicate>> =0,
-            requires_no_pattern<Transformer> =0>
+            requires_iteration<Iteration<Transformer,Predicate>> =0>
   void do_pipeline(Queue & input_queue, Iteration<Transformer,Predicate> & iteration_obj,
                    OtherTransformers && ... other_transform_ops) const
   {
@@ -576,16 +774,7 @@ private:
   template <typename Queue, typename Transformer, typename Predicate,
             template <typename T, typename P> class Iteration,
             typename ... OtherTransformers,
-            requires_iteration<Iteration<Transformer,Predicate>> =0,
-            requires_no_pattern<Transformer> =0>
-  void do_pipeline(Queue & input_queue, Iteration<Transformer,Predicate> && iteration_obj,
-                   OtherTransformers && ... other_transform_ops) const;
-
-  template <typename Queue, typename Transformer, typename Predicate,
-            template <typename T, typename P> class Iteration,
-            typename ... OtherTransformers,
-            requires_iteration<Iteration<Transformer,Predicate>> =0,
-            requires_pipeline<Transformer> =0>
+            requires_iteration<Iteration<Transformer,Predicate>> =0>
   void do_pipeline(Queue & input_queue, Iteration<Transformer,Predicate> && iteration_obj,
                    OtherTransformers && ... other_transform_ops) const;
 
@@ -632,8 +821,44 @@ private:
       std::tuple<Transformers...> && transform_ops,
       std::index_sequence<I...>) const;
 
+  /**
+  \brief Get the groups of workers combining partial results together.
+  \param workers Number of workers.
+  \return Bounds of the groups (a single group unless topology aware).
+  */
+  std::vector<int> worker_groups(int workers) const {
+    return topology_aware_ ?
+        internal::cpu_topology::system().worker_groups(workers) :
+        std::vector<int>{0, workers};
+  }
+
+  /**
+  \brief Launch the replicas of a farm.
+  Unless execution is topology aware, every replica takes items from the 
+  input queue. Otherwise, replicas are grouped by domain and every group 
+  takes items from its own queue, fed by an additional distributor thread.
+  \param workers Pool where replicas are launched.
+  \param group_queues Storage for the queues of the groups.
+  \param input_queue Input queue of the farm.
+  \param ntasks Number of replicas.
+  \param replica Operation run by each replica on its input queue.
+  */
+  template <typename Queue, typename Replica>
+  void launch_replicas(worker_pool & workers, 
+      std::vector<mpmc_queue<typename Queue::value_type>> & group_queues,
+      Queue & input_queue, int ntasks, Replica & replica) const;
+
 private: 
 
+  /**
+  \brief Compute the CPU of every thread for the current concurrency degree.
+  The mapping is shared by copies of the policy.
+  */
+  void update_worker_cpus() {
+    worker_cpus_ = std::make_shared<const std::vector<int>>(
+        internal::cpu_topology::system().worker_cpus(concurrency_degree_));
+  }
+
   mutable thread_registry thread_registry_{};
   
   configuration<> config_{};
@@ -641,6 +866,14 @@ private:
   int concurrency_degree_ = config_.concurrency_degree();
   
   bool ordering_ = config_.ordering();
+
+  bool chunk_affinity_ = false;
+
+  bool topology_aware_ = false;
+
+  std::shared_ptr<const std::vector<int>> worker_cpus_{};
+
+  std::shared_ptr<thread_cache> thread_cache_{};
   
   int queue_size_ = config_.queue_size();
 
@@ -698,6 +931,24 @@ constexpr bool supports_stencil<parallel_execution_native>() { return true; }
 template <>
 constexpr bool supports_divide_conquer<parallel_execution_native>() { return true; }
 
+/**
+\brief Determines if an execution policy supports the in place divide/conquer
+pattern.
+\note Specialization for parallel_execution_native.
+*/
+template<>
+constexpr bool
+supports_inplace_divide_conquer<parallel_execution_native>() { return true; }
+
+/**
+\brief Determines if an execution policy supports the memoized divide/conquer
+pattern.
+\note Specialization for parallel_execution_native.
+*/
+template<>
+constexpr bool
+supports_memoized_divide_conquer<parallel_execution_native>() { return true; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note Specialization for parallel_execution_native.
@@ -739,12 +990,13 @@ void parallel_execution_native::map(
       const auto delta = chunk_size * i;
       const auto chunk_firsts = iterators_next(firsts,delta);
       const auto chunk_first_out = next(first_out, delta);
-      workers.launch(*this, process_chunk, chunk_firsts, chunk_size, chunk_first_out);
+      workers.launch_chunk(*this, i, process_chunk, chunk_firsts, chunk_size, chunk_first_out);
     }
 
     const auto delta = chunk_size * (concurrency_degree_ - 1);
     const auto chunk_firsts = iterators_next(firsts,delta);
     const auto chunk_first_out = next(first_out, delta);
+    auto binding = bind_to_chunk(concurrency_degree_-1);
     process_chunk(chunk_firsts, sequence_size - delta, chunk_first_out);
   } // Pool synch
 }
@@ -757,11 +1009,14 @@ auto parallel_execution_native::reduce(
 {
   using result_type = std::decay_t<Identity>;
   std::vector<result_type> partial_results(concurrency_degree_);
+  auto combiner = internal::make_domain_combiner(partial_results,
+      worker_groups(concurrency_degree_), combine_op);
 
   constexpr sequential_execution seq;
   auto process_chunk = [&](InputIterator f, std::size_t sz, std::size_t id) {
     partial_results[id] = seq.reduce(f,sz, std::forward<Identity>(identity), 
         std::forward<Combiner>(combine_op));
+    combiner.done(id);
   };
 
   const auto chunk_size = sequence_size / concurrency_degree_;
@@ -771,18 +1026,17 @@ auto parallel_execution_native::reduce(
     for (int i=0; i<concurrency_degree_-1; ++i) {
       const auto delta = chunk_size * i;
       const auto chunk_first = std::next(first,delta);
-      workers.launch(*this, process_chunk, chunk_first, chunk_size, i);
+      workers.launch_chunk(*this, i, process_chunk, chunk_first, chunk_size, i);
     }
 
     const auto delta = chunk_size * (concurrency_degree_-1);
     const auto chunk_first = std::next(first, delta);
     const auto chunk_sz = sequence_size - delta;
+    auto binding = bind_to_chunk(concurrency_degree_-1);
     process_chunk(chunk_first, chunk_sz, concurrency_degree_-1);
   } // Pool synch
 
-  return seq.reduce(std::next(partial_results.begin()), 
-      partial_results.size()-1, std::forward<result_type>(partial_results[0]), 
-      std::forward<Combiner>(combine_op));
+  return combiner.result();
 }
 
 template <typename ... InputIterators, typename Identity, 
@@ -795,6 +1049,8 @@ auto parallel_execution_native::map_reduce(
 {
   using result_type = std::decay_t<Identity>;
   std::vector<result_type> partial_results(concurrency_degree_);
+  auto combiner = internal::make_domain_combiner(partial_results,
+      worker_groups(concurrency_degree_), combine_op);
 
   constexpr sequential_execution seq;
   auto process_chunk = [&](auto f, std::size_t sz, std::size_t id) {
@@ -802,6 +1058,7 @@ auto parallel_execution_native::map_reduce(
         std::forward<Identity>(identity),
         std::forward<Transformer>(transform_op),
         std::forward<Combiner>(combine_op));
+    combiner.done(id);
   };
 
   const auto chunk_size = sequence_size / concurrency_degree_;
@@ -811,17 +1068,16 @@ auto parallel_execution_native::map_reduce(
     for(int i=0;i<concurrency_degree_-1;++i){    
       const auto delta = chunk_size * i;
       const auto chunk_firsts = iterators_next(firsts,delta);
-      workers.launch(*this, process_chunk, chunk_firsts, chunk_size, i);
+      workers.launch_chunk(*this, i, process_chunk, chunk_firsts, chunk_size, i);
     }
 
     const auto delta = chunk_size * (concurrency_degree_-1);
     const auto chunk_firsts = iterators_next(firsts, delta);
+    auto binding = bind_to_chunk(concurrency_degree_-1);
     process_chunk(chunk_firsts, sequence_size - delta, concurrency_degree_-1);
   } // Pool synch
 
-  return seq.reduce(partial_results.begin(), 
-     partial_results.size(), std::forward<Identity>(identity),
-     std::forward<Combiner>(combine_op));
+  return combiner.result();
 }
 
 template <typename ... InputIterators, typename OutputIterator,
@@ -849,12 +1105,13 @@ void parallel_execution_native::stencil(
       const auto delta = chunk_size * i;
       const auto chunk_firsts = iterators_next(firsts,delta);
       const auto chunk_out = std::next(first_out,delta);
-      workers.launch(*this, process_chunk, chunk_firsts, chunk_size, chunk_out);
+      workers.launch_chunk(*this, i, process_chunk, chunk_firsts, chunk_size, chunk_out);
     }
 
     const auto delta = chunk_size * (concurrency_degree_ - 1);
     const auto chunk_firsts = iterators_next(firsts,delta);
     const auto chunk_out = std::next(first_out,delta);
+    auto binding = bind_to_chunk(concurrency_degree_-1);
     process_chunk(chunk_firsts, sequence_size - delta, chunk_out);
   } // Pool synch
 }
@@ -890,6 +1147,77 @@ auto parallel_execution_native::divide_conquer(
         num_threads);
 }
 
+template <typename Problem, typename Divider, typename Predicate,
+    typename Solver, typename Combiner>
+auto parallel_execution_native::inplace_divide_conquer(
+    const Problem & problem,
+    Divider && divide_op,
+    Predicate && predicate_op,
+    Solver && solve_op,
+    Combiner && combine_op) const
+{
+  // Threads are created once for the whole problem. Every extra subproblem
+  // is handed to a parked thread, or solved by the caller when none is parked.
+  fork_pool pool{*this, concurrency_degree_-1};
+  auto fork = [&pool](auto n, auto & task) {
+    constexpr std::size_t arity = decltype(n)::value;
+    std::array<fork_pool::slot, arity> subtasks;
+    for (std::size_t i = 1; i < arity; ++i) {
+      subtasks[i].bind(task, i);
+      if (!pool.try_post(subtasks[i])) { task(i); }
+    }
+    task(0);
+    for (auto & s : subtasks) { pool.wait(s); }
+  };
+
+  return internal::inplace_divide_conquer(problem, divide_op, predicate_op,
+      solve_op, combine_op, fork);
+}
+
+template <typename Input, typename KeyExtractor, typename Divider, 
+    typename Predicate, typename Solver, typename Combiner>
+auto parallel_execution_native::memoized_divide_conquer(
+    const Input & input,
+    KeyExtractor && key_op,
+    Divider && divide_op,
+    Predicate && predicate_op,
+    Solver && solve_op,
+    Combiner && combine_op) const
+{
+  using key_type = std::decay_t<decltype(key_op(input))>;
+  using result_type = std::decay_t<decltype(solve_op(input))>;
+  internal::future_memo<key_type, result_type> memo{
+      4 * static_cast<std::size_t>(concurrency_degree_)};
+  std::atomic<int> num_threads{concurrency_degree_-1};
+
+  // Launch a thread for every extra subproblem while threads are available.
+  // Workers are dedicated threads, so that waiting for a problem being solved
+  // by another worker cannot deadlock.
+  auto fork = [&,this](std::size_t n, auto && task) {
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < n; ++i) {
+      if (num_threads.fetch_sub(1) > 0) {
+        workers.emplace_back([&,this,i]() {
+          auto manager = thread_manager();
+          task(i);
+        });
+      }
+      else {
+        num_threads++;
+        task(i);
+      }
+    }
+    if (n > 0) { task(0); }
+    for (auto & w : workers) {
+      w.join(); 
+      num_threads++;
+    }
+  };
+
+  return internal::memoized_divide_conquer(input, key_op, divide_op, 
+      predicate_op, solve_op, combine_op, memo, fork);
+}
+
 template <typename Generator, typename ... Transformers>
 void parallel_execution_native::pipeline(
     Generator && generate_op, 
@@ -900,9 +1228,8 @@ void parallel_execution_native::pipeline(
   using output_type = pair<result_type,long>;
   auto output_queue = make_queue<output_type>();
 
-  thread generator_task([&,this]() {
-    auto manager = thread_manager();
-
+  worker_pool generator_task{1};
+  generator_task.launch(*this, [&]() {
     long order = 0;
     for (;;) {
       auto item{generate_op()};
@@ -913,7 +1240,7 @@ void parallel_execution_native::pipeline(
   });
 
   do_pipeline(output_queue, forward<Transformers>(transform_ops)...);
-  generator_task.join();
+  generator_task.wait();
 }
 
 template <typename Population, typename Selection, typename Evolution,
@@ -1189,9 +1516,8 @@ void parallel_execution_native::do_pipeline(
   decltype(auto) output_queue =
     get_output_queue<output_item_type>(other_transform_ops...);
 
-  thread task([&,this]() {
-    auto manager = thread_manager();
-
+  worker_pool task{1};
+  task.launch(*this, [&]() {
     for (;;) {
       auto item{input_queue.pop()};
       if (!item.first) break;
@@ -1203,7 +1529,47 @@ void parallel_execution_native::do_pipeline(
 
   do_pipeline(output_queue, 
       forward<OtherTransformers>(other_transform_ops)...);
-  task.join();
+  task.wait();
+}
+
+template <typename Queue, typename Replica>
+void parallel_execution_native::launch_replicas(worker_pool & workers, 
+    std::vector<mpmc_queue<typename Queue::value_type>> & group_queues,
+    Queue & input_queue, int ntasks, Replica & replica) const
+{
+  const auto bounds = worker_groups(ntasks);
+  if (bounds.size() < 3) {
+    for (int i=0; i<ntasks; ++i) {
+      workers.launch(*this, [&replica,&input_queue]() { replica(input_queue); });
+    }
+    return;
+  }
+
+  const auto cpus = internal::cpu_topology::system().worker_cpus(ntasks);
+  group_queues.reserve(bounds.size()-1);
+  for (std::size_t g=0; g+1<bounds.size(); ++g) {
+    group_queues.emplace_back(queue_size_, queue_mode_);
+  }
+
+  for (int i=0; i<ntasks; ++i) {
+    const int g = internal::worker_group(bounds, i);
+    workers.launch(*this, [&replica,&group_queues,cpus,i,g]() {
+      internal::thread_binding binding{cpus, i};
+      replica(group_queues[g]);
+    });
+  }
+
+  // Items are dealt to groups in proportion to their number of replicas
+  workers.launch(*this, [&group_queues,&input_queue,bounds,ntasks]() {
+    int next = 0;
+    auto item{input_queue.pop()};
+    while (item.first) {
+      group_queues[internal::worker_group(bounds, next)].push(std::move(item));
+      next = (next+1) % ntasks;
+      item = input_queue.pop();
+    }
+    for (auto & queue : group_queues) { queue.push(typename Queue::value_type{}); }
+  });
 }
 
 template <typename Queue, typename FarmTransformer,
@@ -1215,18 +1581,19 @@ void parallel_execution_native::do_pipeline(
 {
   using namespace std;
 
-  auto farm_task = [&](int) {
-    auto item{input_queue.pop()}; 
+  auto farm_task = [&](auto & queue) {
+    auto item{queue.pop()}; 
     while (item.first) {
       farm_obj(*item.first);
-      item = input_queue.pop();
+      item = queue.pop();
     }
-    input_queue.push(item);
+    queue.push(item);
   };
 
   auto ntasks = farm_obj.cardinality();
+  std::vector<mpmc_queue<typename Queue::value_type>> group_queues;
   worker_pool workers{ntasks};
-  workers.launch_tasks(*this, farm_task, ntasks);  
+  launch_replicas(workers, group_queues, input_queue, ntasks, farm_task);
   workers.wait();
 }
 
@@ -1289,19 +1656,20 @@ void parallel_execution_native::do_pipeline(
 
   atomic<int> done_threads{0};
 
-  auto farm_task = [&](int nt) {
-    do_pipeline(input_queue, farm_obj.transformer(), output_queue);
+  auto ntasks = farm_obj.cardinality();
+  auto farm_task = [&](auto & queue) {
+    do_pipeline(queue, farm_obj.transformer(), output_queue);
     done_threads++;
-    if (done_threads == nt) {
+    if (done_threads == ntasks) {
       output_queue.push(make_pair(output_optional_type{}, -1));
     }else{
-      input_queue.push(input_item_type{});
+      queue.push(input_item_type{});
     }
   };
 
-  auto ntasks = farm_obj.cardinality();
+  std::vector<mpmc_queue<input_item_type>> group_queues;
   worker_pool workers{ntasks};
-  workers.launch_tasks(*this, farm_task, ntasks);  
+  launch_replicas(workers, group_queues, input_queue, ntasks, farm_task);
   do_pipeline(output_queue, 
       forward<OtherTransformers>(other_transform_ops)... );
   
@@ -1321,93 +1689,40 @@ void parallel_execution_native::do_pipeline(
 
   using input_item_type = typename Queue::value_type;
   using input_value_type = typename input_item_type::first_type;
-  auto filter_queue = make_queue<input_item_type>();
 
+  decltype(auto) output_queue =
+    get_output_queue<input_item_type>(other_transform_ops...);
+
+  // Discarded items are not sent downstream. When ordered, kept items are
+  // renumbered here and discarded ones are only tracked as skipped numbers.
   auto filter_task = [&,this]() {
-    auto manager = thread_manager();
+    internal::sequence_tracker<input_value_type> tracker;
+    auto emit = [&](input_value_type && value, long order) {
+      output_queue.push(make_pair(move(value), order));
+    };
+    long order = 0;
     auto item{input_queue.pop()};
     while (item.first) {
-      if (filter_obj.keep()) {
-        if (filter_obj(*item.first)) {
-          filter_queue.push(item);
-        }
-        else {
-          filter_queue.push(make_pair(input_value_type{}, item.second));
-        }
+      const bool matches = filter_obj(*item.first);
+      const bool kept = (matches == filter_obj.keep());
+      if (!is_ordered()) {
+        if (kept) { emit(move(item.first), order++); }
+      }
+      else if (kept) {
+        tracker.keep(item.second, move(item.first), emit);
       }
       else {
-        if (!filter_obj(*item.first)) {
-          filter_queue.push(item);
-        }
-        else {
-          filter_queue.push(make_pair(input_value_type{}, item.second));
-        }
+        tracker.skip(item.second, emit);
       }
       item = input_queue.pop();
     }
-    filter_queue.push(make_pair(input_value_type{}, -1));
+    output_queue.push(make_pair(input_value_type{}, -1));
   };
-  thread filter_thread{filter_task};
+  worker_pool filter_thread{1};
+  filter_thread.launch(*this, filter_task);
 
-  decltype(auto) output_queue =
-    get_output_queue<input_item_type>(other_transform_ops...);
-
-  thread ordering_thread;
-  if (is_ordered()) {
-    auto ordering_task = [&]() {
-      auto manager = thread_manager();
-      vector<input_item_type> elements;
-      int current = 0;
-      long order = 0;
-      auto item{filter_queue.pop()};
-      for (;;) {
-        if(!item.first && item.second == -1) break; 
-        if (item.second == current) {
-          if (item.first) {
-            output_queue.push(make_pair(item.first,order));
-            order++;
-          }
-          current++;
-        }
-        else {
-          elements.push_back(item);
-        }
-        auto it = find_if(elements.begin(), elements.end(), 
-           [&](auto x) { return x.second== current; });
-        if(it != elements.end()){
-          if (it->first) {
-            output_queue.push(make_pair(it->first,order));
-            order++;
-          }       
-          elements.erase(it);
-          current++;
-        }
-        item = filter_queue.pop();
-      }
-      while (elements.size()>0) {
-        auto it = find_if(elements.begin(), elements.end(), 
-           [&](auto x) { return x.second== current; });
-        if(it != elements.end()){
-          if (it->first) {
-            output_queue.push(make_pair(it->first,order));
-            order++;
-          }       
-          elements.erase(it);
-          current++;
-        }
-      }
-      output_queue.push(item);
-    };
-
-    ordering_thread = thread{ordering_task};
-    do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
-    filter_thread.join();
-    ordering_thread.join();
-  }
-  else {
-    do_pipeline(filter_queue, forward<OtherTransformers>(other_transform_ops)...);
-    filter_thread.join();
-  }
+  do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
+  filter_thread.wait();
 }
 
 template <typename Queue, typename Combiner, typename Identity,
@@ -1423,11 +1738,16 @@ void parallel_execution_native::do_pipeline(
 
   using output_item_value_type = grppi::optional<decay_t<Identity>>;
   using output_item_type = pair<output_item_value_type,long>;
+  if (reduce_obj.cardinality() > 1) {
+    do_farmed_reduce(input_queue, reduce_obj,
+        forward<OtherTransformers>(other_transform_ops)...);
+    return;
+  }
+
   decltype(auto) output_queue =
     get_output_queue<output_item_type>(other_transform_ops...);
 
   auto reduce_task = [&,this]() {
-    auto manager = thread_manager();
     auto item{input_queue.pop()};
     int order = 0;
     while (item.first) {
@@ -1441,71 +1761,640 @@ void parallel_execution_native::do_pipeline(
     }
     output_queue.push(make_pair(output_item_value_type{}, -1));
   };
-  thread reduce_thread{reduce_task};
+  worker_pool reduce_thread{1};
+  reduce_thread.launch(*this, reduce_task);
   do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
-  reduce_thread.join();
+  reduce_thread.wait();
 }
 
-template <typename Queue, typename Transformer, typename Predicate,
-          template <typename T, typename P> class Iteration,
+template <typename Queue, typename Reduce,
+          typename ... OtherTransformers>
+void parallel_execution_native::do_farmed_reduce(
+    Queue & input_queue,
+    Reduce & reduce_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+
+  using value_type = decay_t<typename Reduce::input_type>;
+  using output_item_value_type = grppi::optional<value_type>;
+  using output_item_type = pair<output_item_value_type,long>;
+  decltype(auto) output_queue =
+    get_output_queue<output_item_type>(other_transform_ops...);
+
+  // Windows are views of blocks of items shared by the windows they
+  // overlap. A block is never reallocated, so that replicas may read
+  // the items of a window while the collector appends further items.
+  using block_type = vector<value_type>;
+  struct window_type {
+    shared_ptr<block_type> block;
+    const value_type * first;
+    long size;
+  };
+  using window_item_type = pair<grppi::optional<window_type>,long>;
+  auto window_queue = make_queue<window_item_type>();
+
+  // Windows are collected by a single thread, following the same rules as
+  // reduce_t, and reduced from scratch by the replicas. Their order is kept
+  // in the window number. When a block is full, the items of the open 
+  // window are copied to a new block, which is sized so that every item is
+  // copied at most once on average.
+  auto collect_task = [&,this]() {
+    const long window_size = reduce_obj.window_size();
+    const long offset = reduce_obj.offset();
+    const long full_size = max(window_size, 1L);
+    const long block_size = (offset >= window_size) ? 
+        full_size : 2 * full_size;
+    auto make_block = [](long capacity) {
+      auto block = make_shared<block_type>();
+      block->reserve(capacity);
+      return block;
+    };
+    auto block = make_block(block_size);
+    long start = 0;
+    long remaining = 0;
+    long order = 0;
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      if (remaining > 0) {
+        remaining--;
+        continue;
+      }
+      if (block->size() == block->capacity()) {
+        const long kept = static_cast<long>(block->size()) - start;
+        auto next = make_block(max(block_size, kept + full_size));
+        next->insert(next->end(), block->begin() + start, block->end());
+        block = move(next);
+        start = 0;
+      }
+      block->push_back(move(*item.first));
+      if (static_cast<long>(block->size()) - start < full_size) { continue; }
+      window_queue.push(make_pair(
+          window_type{block, block->data() + start, full_size}, order++));
+      if (offset >= window_size) {
+        remaining = offset - window_size;
+        block = make_block(block_size);
+        start = 0;
+      }
+      else {
+        start += offset;
+      }
+    }
+    window_queue.push(make_pair(grppi::optional<window_type>{}, -1));
+  };
+
+  // With ordering, results are sent in window order by a collector.
+  auto results_queue = make_queue<output_item_type>();
+  auto & replica_queue = is_ordered() ? results_queue : output_queue;
+  const int ntasks = reduce_obj.cardinality();
+  atomic<int> done_tasks{0};
+  auto window_task = [&]() {
+    constexpr sequential_execution seq;
+    for (auto w{window_queue.pop()}; w.first; w = window_queue.pop()) {
+      auto red = seq.reduce(w.first->first, w.first->size,
+          reduce_obj.identity(), reduce_obj.combiner());
+      w.first.reset();
+      replica_queue.push(make_pair(output_item_value_type{move(red)}, 
+          w.second));
+    }
+    if (++done_tasks == ntasks) {
+      replica_queue.push(make_pair(output_item_value_type{}, -1));
+    }
+    else {
+      window_queue.push(make_pair(grppi::optional<window_type>{}, -1));
+    }
+  };
+
+  worker_pool collect_thread{1};
+  collect_thread.launch(*this, collect_task);
+  worker_pool workers{ntasks};
+  workers.launch_tasks(*this, window_task);
+  worker_pool ordering_thread{1};
+  if (is_ordered()) {
+    ordering_thread.launch(*this, [&]() {
+      emit_ordered(results_queue, output_queue);
+    });
+  }
+  do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
+  workers.wait();
+  collect_thread.wait();
+  ordering_thread.wait();
+}
+
+template <typename Queue, typename Keyed,
           typename ... OtherTransformers,
-          requires_iteration<Iteration<Transformer,Predicate>>,
-          requires_no_pattern<Transformer>>
+          requires_keyed<Keyed>>
 void parallel_execution_native::do_pipeline(
-    Queue & input_queue, 
-    Iteration<Transformer,Predicate> && iteration_obj,
+    Queue & input_queue,
+    Keyed && keyed_obj,
     OtherTransformers && ... other_transform_ops) const
 {
   using namespace std;
 
-  using input_item_type = typename decay_t<Queue>::value_type;
+  using input_item_type = typename Queue::value_type;
+  using output_value_type = typename decay_t<Keyed>::output_type;
+  using output_optional_type = grppi::optional<output_value_type>;
+  using output_item_type = pair<output_optional_type,long>;
 
   decltype(auto) output_queue =
-    get_output_queue<input_item_type>(other_transform_ops...);
+    get_output_queue<output_item_type>(other_transform_ops...);
 
-  auto iteration_task = [&]() {
-    for (;;) {
-      auto item = input_queue.pop();
-      if (!item.first) break;
-      auto value = iteration_obj.transform(*item.first);
-      auto new_item = input_item_type{value,item.second};
-      if (iteration_obj.predicate(value)) {
-        output_queue.push(new_item);
+  // Every replica has its own queue and owns the keys routed to it
+  const int ntasks = keyed_obj.cardinality();
+  vector<mpmc_queue<input_item_type>> shard_queues;
+  shard_queues.reserve(ntasks);
+  for (int i=0; i<ntasks; ++i) {
+    shard_queues.emplace_back(queue_size_, queue_mode_);
+  }
+
+  auto route_task = [&,this]() {
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      shard_queues[keyed_obj.shard(*item.first)].push(move(item));
+    }
+    for (auto & queue : shard_queues) { queue.push(input_item_type{}); }
+  };
+
+  // With ordering, replicas send an item for every input, with or without
+  // value, so that the sequence can be rebuilt.
+  auto results_queue = make_queue<output_item_type>();
+  auto & replica_queue = is_ordered() ? results_queue : output_queue;
+  atomic<int> done_tasks{0};
+  auto keyed_task = [&,this](int shard) {
+    auto & queue = shard_queues[shard];
+    for (auto item{queue.pop()}; item.first; item = queue.pop()) {
+      auto out = keyed_obj(shard, *item.first);
+      if (out || is_ordered()) {
+        replica_queue.push(make_pair(move(out), item.second));
+      }
+    }
+    if (++done_tasks == ntasks) {
+      replica_queue.push(make_pair(output_optional_type{}, -1));
+    }
+  };
+
+  worker_pool route_thread{1};
+  route_thread.launch(*this, route_task);
+  worker_pool workers{ntasks};
+  for (int i=0; i<ntasks; ++i) {
+    workers.launch(*this, keyed_task, i);
+  }
+
+  if (is_ordered()) {
+    worker_pool ordering_thread{1};
+    ordering_thread.launch(*this, [&]() {
+      emit_ordered(results_queue, output_queue);
+    });
+    do_pipeline(output_queue,
+        forward<OtherTransformers>(other_transform_ops)...);
+    ordering_thread.wait();
+  }
+  else {
+    do_pipeline(output_queue,
+        forward<OtherTransformers>(other_transform_ops)...);
+  }
+  workers.wait();
+  route_thread.wait();
+}
+
+template <typename InputQueue, typename OutputQueue>
+void parallel_execution_native::emit_ordered(
+    InputQueue & input_queue,
+    OutputQueue & output_queue) const
+{
+  using namespace std;
+  using item_type = typename InputQueue::value_type;
+
+  // Items arrive with their input sequence number. Those without value are
+  // dropped and the rest are renumbered.
+  internal::sequence_tracker<typename item_type::first_type> tracker;
+  auto emit = [&](auto && value, long order) {
+    output_queue.push(make_pair(move(value), order));
+  };
+  for (auto item{input_queue.pop()}; item.first || item.second != -1;
+      item = input_queue.pop()) {
+    if (item.first) { tracker.keep(item.second, move(item.first), emit); }
+    else { tracker.skip(item.second, emit); }
+  }
+  output_queue.push(make_pair(typename item_type::first_type{}, -1));
+}
+
+template <typename Queue, typename FlatMap,
+          typename ... OtherTransformers,
+          requires_flat_map<FlatMap>>
+void parallel_execution_native::do_pipeline(
+    Queue & input_queue,
+    FlatMap && flat_map_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+
+  using input_item_type = typename Queue::value_type;
+  using input_value_type = typename input_item_type::first_type;
+  using output_type = typename decay_t<FlatMap>::output_type;
+  using output_value_type = grppi::optional<output_type>;
+  using output_item_type = pair<output_value_type,long>;
+
+  decltype(auto) output_queue =
+    get_output_queue<output_item_type>(other_transform_ops...);
+
+  // Outputs are numbered as they are produced. When ordered, items are
+  // released in input order first, so that outputs follow the input order.
+  auto flat_map_task = [&,this]() {
+    long order = 0;
+    auto emit = [&](output_type && value) {
+      output_queue.push(make_pair(output_value_type{move(value)}, order++));
+    };
+    auto apply = [&](input_value_type && item, long) {
+      flat_map_obj(*item, emit);
+    };
+    internal::sequence_tracker<input_value_type> tracker;
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      if (is_ordered()) { tracker.keep(item.second, move(item.first), apply); }
+      else { flat_map_obj(*item.first, emit); }
+    }
+    output_queue.push(make_pair(output_value_type{}, -1));
+  };
+
+  worker_pool flat_map_thread{1};
+  flat_map_thread.launch(*this, flat_map_task);
+  do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
+  flat_map_thread.wait();
+}
+
+template <typename Queue, typename Batch,
+          typename ... OtherTransformers,
+          requires_batch<Batch>>
+void parallel_execution_native::do_pipeline(
+    Queue & input_queue,
+    Batch && batch_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+
+  using input_item_type = typename Queue::value_type;
+  using input_value_type = typename input_item_type::first_type;
+  using batch_type = decay_t<Batch>;
+  using output_value_type = grppi::optional<typename batch_type::output_type>;
+  using output_item_type = pair<output_value_type,long>;
+
+  decltype(auto) output_queue =
+    get_output_queue<output_item_type>(other_transform_ops...);
+
+  // Full batches are emitted by the stage thread, while expired batches are
+  // emitted by a timer thread. Both emit under the batch lock.
+  mutex batch_mutex;
+  condition_variable batch_cv;
+  bool done = false;
+  long order = 0;
+  auto emit_batch = [&]() {
+    output_queue.push(make_pair(output_value_type{batch_obj.take_batch()},
+        order++));
+  };
+  auto add = [&](input_value_type && item, long) {
+    unique_lock<mutex> lock{batch_mutex};
+    const bool started = batch_obj.empty();
+    batch_obj.add_item(move(*item));
+    if (batch_obj.full()) { emit_batch(); }
+    else if (started) { batch_cv.notify_one(); }
+  };
+
+  auto batch_task = [&,this]() {
+    internal::sequence_tracker<input_value_type> tracker;
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      if (is_ordered()) { tracker.keep(item.second, move(item.first), add); }
+      else { add(move(item.first), item.second); }
+    }
+    unique_lock<mutex> lock{batch_mutex};
+    if (!batch_obj.empty()) { emit_batch(); }
+    output_queue.push(make_pair(output_value_type{}, -1));
+    done = true;
+    batch_cv.notify_one();
+  };
+
+  auto timer_task = [&]() {
+    unique_lock<mutex> lock{batch_mutex};
+    while (!done) {
+      if (batch_obj.empty()) { batch_cv.wait(lock); }
+      else if (batch_obj.batch_ready()) { emit_batch(); }
+      else { batch_cv.wait_until(lock, batch_obj.deadline()); }
+    }
+  };
+
+  worker_pool batch_threads{2};
+  batch_threads.launch(*this, batch_task);
+  if (batch_obj.timeout() > batch_type::clock_type::duration::zero()) {
+    batch_threads.launch(*this, timer_task);
+  }
+  do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
+  batch_threads.wait();
+}
+
+template <typename Queue, typename Split,
+          typename ... OtherTransformers,
+          requires_split<Split>>
+void parallel_execution_native::do_pipeline(
+    Queue & input_queue,
+    Split && split_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+
+  using split_type = decay_t<Split>;
+  using input_item_type = typename Queue::value_type;
+  using input_value_type = typename input_item_type::first_type;
+  constexpr auto nbranches = split_type::size();
+
+  // Every branch numbers its own items
+  vector<mpmc_queue<input_item_type>> branch_queues;
+  branch_queues.reserve(nbranches);
+  for (size_t i=0; i<nbranches; ++i) {
+    branch_queues.emplace_back(queue_size_, queue_mode_);
+  }
+
+  auto route_task = [&]() {
+    vector<long> order(nbranches, 0);
+    auto route = [&](input_value_type && item, long) {
+      if constexpr (split_type::is_broadcast) {
+        for (size_t i=0; i<nbranches; ++i) {
+          branch_queues[i].push(make_pair(item, order[i]++));
+        }
       }
       else {
-        input_queue.push(new_item);
+        auto i = split_obj.route(*item);
+        branch_queues[i].push(make_pair(move(item), order[i]++));
+      }
+    };
+    internal::sequence_tracker<input_value_type> tracker;
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      if (is_ordered()) {
+        tracker.keep(item.second, move(item.first), route);
+      }
+      else {
+        route(move(item.first), item.second);
       }
     }
-    while (!input_queue.empty()) {
-      auto item = input_queue.pop();
-      auto value = iteration_obj.transform(*item.first);
-      auto new_item = input_item_type{value,item.second};
-      if (iteration_obj.predicate(value)) {
-        output_queue.push(new_item);
+    for (auto & queue : branch_queues) {
+      queue.push(make_pair(input_value_type{}, -1));
+    }
+  };
+
+  if constexpr (sizeof...(OtherTransformers) == 0) {
+    worker_pool workers{static_cast<int>(nbranches)};
+    for (size_t i=0; i<nbranches; ++i) {
+      workers.launch(*this, [&,i]() {
+        split_obj.apply_to(i, [&](auto & branch) {
+          do_pipeline(branch_queues[i], branch);
+        });
+      });
+    }
+    route_task();
+    workers.wait();
+  }
+  else {
+    using output_type =
+        typename split_type::template output_type<typename input_value_type::value_type>;
+    static_assert(!is_void<output_type>::value,
+        "Branches of an intermediate split must produce a result");
+    using output_value_type = grppi::optional<output_type>;
+    using output_item_type = pair<output_value_type,long>;
+
+    decltype(auto) output_queue =
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    vector<mpmc_queue<output_item_type>> merge_queues;
+    merge_queues.reserve(nbranches);
+    for (size_t i=0; i<nbranches; ++i) {
+      merge_queues.emplace_back(queue_size_, queue_mode_);
+    }
+
+    // Outputs of a branch are released in order and renumbered as merged
+    atomic<long> order{0};
+    atomic<size_t> done_branches{0};
+    auto merge_task = [&](size_t i) {
+      auto emit = [&](output_value_type && value, long) {
+        output_queue.push(make_pair(move(value), order++));
+      };
+      internal::sequence_tracker<output_value_type> tracker;
+      for (auto item{merge_queues[i].pop()}; item.first;
+          item = merge_queues[i].pop()) {
+        if (is_ordered()) {
+          tracker.keep(item.second, move(item.first), emit);
+        }
+        else {
+          emit(move(item.first), item.second);
+        }
+      }
+      if (++done_branches == nbranches) {
+        output_queue.push(make_pair(output_value_type{}, -1));
+      }
+    };
+
+    worker_pool workers{static_cast<int>(2*nbranches+1)};
+    workers.launch(*this, route_task);
+    for (size_t i=0; i<nbranches; ++i) {
+      workers.launch(*this, [&,i]() {
+        split_obj.apply_to(i, [&](auto & branch) {
+          do_pipeline(branch_queues[i], branch, merge_queues[i]);
+        });
+        merge_queues[i].push(make_pair(output_value_type{}, -1));
+      });
+      workers.launch(*this, merge_task, i);
+    }
+    do_pipeline(output_queue,
+        forward<OtherTransformers>(other_transform_ops)...);
+    workers.wait();
+  }
+}
+
+template <typename Queue, typename Join,
+          typename ... OtherTransformers,
+          requires_join<Join>>
+void parallel_execution_native::do_pipeline(
+    Queue & input_queue,
+    Join && join_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+  static_assert(sizeof...(OtherTransformers) > 0,
+      "A join cannot be the last stage of a pipeline");
+
+  using join_type = decay_t<Join>;
+  using input_item_type = typename Queue::value_type;
+  using input_value_type = typename input_item_type::first_type;
+  using left_item_type =
+      pair<grppi::optional<typename join_type::left_type>,long>;
+  using right_item_type =
+      pair<grppi::optional<typename join_type::right_type>,long>;
+  using output_value_type = grppi::optional<typename join_type::output_type>;
+  using output_item_type = pair<output_value_type,long>;
+
+  decltype(auto) output_queue =
+      get_output_queue<output_item_type>(other_transform_ops...);
+
+  auto left_queue = make_queue<input_item_type>();
+  auto right_queue = make_queue<input_item_type>();
+  auto left_output = make_queue<left_item_type>();
+  auto right_output = make_queue<right_item_type>();
+
+  // Both branches number items in the same way
+  auto route_task = [&]() {
+    long order = 0;
+    auto route = [&](input_value_type && item, long) {
+      left_queue.push(make_pair(item, order));
+      right_queue.push(make_pair(move(item), order));
+      order++;
+    };
+    internal::sequence_tracker<input_value_type> tracker;
+    for (auto item{input_queue.pop()}; item.first; item = input_queue.pop()) {
+      if (is_ordered()) {
+        tracker.keep(item.second, move(item.first), route);
       }
       else {
-        input_queue.push(new_item);
+        route(move(item.first), item.second);
+      }
+    }
+    left_queue.push(make_pair(input_value_type{}, -1));
+    right_queue.push(make_pair(input_value_type{}, -1));
+  };
+
+  // Pairs by position keep the order of their position
+  mutex join_mutex;
+  long order = 0;
+  int done_branches = 0;
+  auto join_task = [&](auto & queue, auto add) {
+    for (auto item{queue.pop()}; item.first; item = queue.pop()) {
+      lock_guard<mutex> lock{join_mutex};
+      auto out = add(item.second, move(*item.first));
+      if (out) {
+        const long seq = (join_type::by_sequence && is_ordered()) ?
+            item.second : order++;
+        output_queue.push(make_pair(output_value_type{move(*out)}, seq));
       }
     }
-    output_queue.push(input_item_type{{},-1});
+    lock_guard<mutex> lock{join_mutex};
+    if (++done_branches == 2) {
+      join_obj.clear();
+      output_queue.push(make_pair(output_value_type{}, -1));
+    }
   };
 
-  thread iteration_thread{iteration_task};
+  worker_pool workers{5};
+  workers.launch(*this, route_task);
+  workers.launch(*this, [&]() {
+    do_pipeline(left_queue, join_obj.left(), left_output);
+    left_output.push(left_item_type{{}, -1});
+  });
+  workers.launch(*this, [&]() {
+    do_pipeline(right_queue, join_obj.right(), right_output);
+    right_output.push(right_item_type{{}, -1});
+  });
+  workers.launch(*this, [&]() {
+    join_task(left_output, [&](long seq, auto && value) {
+      return join_obj.add_left(seq, move(value));
+    });
+  });
+  workers.launch(*this, [&]() {
+    join_task(right_output, [&](long seq, auto && value) {
+      return join_obj.add_right(seq, move(value));
+    });
+  });
+  do_pipeline(output_queue,
+      forward<OtherTransformers>(other_transform_ops)...);
+  workers.wait();
+}
+
+template <typename Queue, typename TimeReduce,
+          typename ... OtherTransformers,
+          requires_time_reduce<TimeReduce>>
+void parallel_execution_native::do_pipeline(
+    Queue && input_queue,
+    TimeReduce && reduce_obj,
+    OtherTransformers && ... other_transform_ops) const
+{
+  using namespace std;
+
+  using input_item_type = typename decay_t<Queue>::value_type;
+  using output_item_value_type =
+      grppi::optional<typename decay_t<TimeReduce>::input_type>;
+  using output_item_type = pair<output_item_value_type,long>;
+  decltype(auto) output_queue =
+    get_output_queue<output_item_type>(other_transform_ops...);
+
+  auto reduce_task = [&,this]() {
+    constexpr sequential_execution seq;
+    long order = 0;
+    auto emit_closed = [&]() {
+      while (reduce_obj.reduction_needed()) {
+        output_queue.push(make_pair(reduce_obj.reduce_window(seq), order++));
+      }
+    };
+    for (input_item_type item{input_queue.pop()}; item.first;
+        item = input_queue.pop()) {
+      reduce_obj.add_item(*item.first);
+      emit_closed();
+    }
+    reduce_obj.flush();
+    emit_closed();
+    output_queue.push(make_pair(output_item_value_type{}, -1));
+  };
+  worker_pool reduce_thread{1};
+  reduce_thread.launch(*this, reduce_task);
   do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
-  iteration_thread.join();
+  reduce_thread.wait();
 }
 
 template <typename Queue, typename Transformer, typename Predicate,
           template <typename T, typename P> class Iteration,
           typename ... OtherTransformers,
-          requires_iteration<Iteration<Transformer,Predicate>>,
-          requires_pipeline<Transformer>>
+          requires_iteration<Iteration<Transformer,Predicate>>>
 void parallel_execution_native::do_pipeline(
-    Queue &,
-    Iteration<Transformer,Predicate> &&,
-    OtherTransformers && ...) const
+    Queue & input_queue, 
+    Iteration<Transformer,Predicate> && iteration_obj,
+    OtherTransformers && ... other_transform_ops) const
 {
-  static_assert(!is_pipeline<Transformer>, "Not implemented");
+  using namespace std;
+
+  using input_item_type = typename decay_t<Queue>::value_type;
+  using input_value_type = typename input_item_type::first_type;
+
+  decltype(auto) output_queue =
+    get_output_queue<input_item_type>(other_transform_ops...);
+
+  // Every replica loops on its item until the predicate holds. With several
+  // ordered replicas, items keep their sequence number and are released in
+  // order by a collector.
+  atomic<int> done_threads{0};
+  const int ntasks = iteration_obj.cardinality();
+  const bool reorder = is_ordered() && ntasks > 1;
+  auto results_queue = make_queue<input_item_type>();
+  auto & replica_queue = reorder ? results_queue : output_queue;
+  auto iteration_task = [&](auto & queue) {
+    for (auto item{queue.pop()}; item.first; item = queue.pop()) {
+      auto value = iteration_obj.transform(*item.first);
+      while (!iteration_obj.predicate(value)) {
+        value = iteration_obj.transform(value);
+      }
+      replica_queue.push(make_pair(input_value_type{move(value)}, item.second));
+    }
+    if (++done_threads == ntasks) {
+      replica_queue.push(make_pair(input_value_type{}, -1));
+    }
+    else {
+      queue.push(input_item_type{});
+    }
+  };
+
+  std::vector<mpmc_queue<input_item_type>> group_queues;
+  worker_pool workers{ntasks};
+  launch_replicas(workers, group_queues, input_queue, ntasks, iteration_task);
+  worker_pool ordering_thread{1};
+  if (reorder) {
+    ordering_thread.launch(*this, [&]() {
+      emit_ordered(results_queue, output_queue);
+    });
+  }
+  do_pipeline(output_queue, forward<OtherTransformers>(other_transform_ops)...);
+  workers.wait();
+  ordering_thread.wait();
 }
 
 
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_NATIVE_TOPOLOGY_H
+#define GRPPI_NATIVE_TOPOLOGY_H
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "affinity.h"
+#include "../common/accumulate.h"
+
+namespace grppi {
+
+namespace internal {
+
+/**
+\brief Read the leading integer of a file.
+\param path Path to the file.
+\param fallback Value returned if the file cannot be read.
+\note Lists such as `0-7,64-71` are read as their first CPU.
+*/
+inline int read_leading_int(const std::string & path, int fallback) noexcept
+{
+  std::ifstream file{path};
+  int value;
+  if (file >> value) return value;
+  return fallback;
+}
+
+/**
+\brief Grouping of CPUs into memory domains.
+A domain is the set of CPUs sharing both a socket (physical package) and a 
+last level (L3) cache. Domains are sorted by socket and, within a socket, by
+L3 cache.
+*/
+class cpu_topology {
+public:
+
+  /**
+  \brief Discover the topology of a set of CPUs from a sysfs tree.
+  CPUs whose socket or L3 cache cannot be determined are considered to be 
+  in socket 0 and to share a single L3 cache.
+  \param sysfs_root Directory containing the `cpuN` entries.
+  \param cpus Identifiers of the CPUs to group.
+  */
+  cpu_topology(const std::string & sysfs_root, const std::vector<int> & cpus)
+  {
+    std::map<std::pair<int,int>, std::vector<int>> domains;
+    for (int cpu : cpus) {
+      const auto cpu_dir = sysfs_root + "/cpu" + std::to_string(cpu);
+      const int package = read_leading_int(
+          cpu_dir + "/topology/physical_package_id", 0);
+      const int cache = read_leading_int(
+          cpu_dir + "/cache/index3/shared_cpu_list", -1);
+      domains[{package,cache}].push_back(cpu);
+    }
+    for (auto & d : domains) { domains_.push_back(std::move(d.second)); }
+    if (domains_.empty()) { domains_.emplace_back(); }
+  }
+
+  /**
+  \brief Get the topology of the CPUs available to the process.
+  It is discovered once from `/sys/devices/system/cpu`.
+  */
+  static const cpu_topology & system()
+  {
+    static const cpu_topology topology{"/sys/devices/system/cpu", 
+        available_cpus()};
+    return topology;
+  }
+
+  /// Get the number of domains.
+  int domain_count() const noexcept { return static_cast<int>(domains_.size()); }
+
+  /// Get the CPUs in a domain.
+  const std::vector<int> & domain(int d) const noexcept { return domains_[d]; }
+
+  /**
+  \brief Split a number of workers into one group per domain.
+  Groups are contiguous and sized in proportion to the number of CPUs in 
+  their domain. Some groups may be empty when there are less workers than 
+  domains.
+  \param workers Number of workers.
+  \return Bounds of the groups. Group g has workers in [bounds[g],bounds[g+1]).
+  */
+  std::vector<int> worker_groups(int workers) const
+  {
+    std::size_t total = 0;
+    for (auto & d : domains_) { total += d.size(); }
+    std::vector<int> bounds{0};
+    std::size_t accumulated = 0;
+    for (auto & d : domains_) {
+      accumulated += d.size();
+      bounds.push_back(total == 0 ? workers : 
+          static_cast<int>(workers * accumulated / total));
+    }
+    return bounds;
+  }
+
+  /**
+  \brief Get the CPU for every worker.
+  Workers in a group are assigned to the CPUs of its domain in round-robin
+  order.
+  \param workers Number of workers.
+  \return The CPU of each worker, or an empty vector when CPUs are unknown.
+  */
+  std::vector<int> worker_cpus(int workers) const
+  {
+    std::vector<int> cpus;
+    const auto bounds = worker_groups(workers);
+    for (int g = 0; g < domain_count(); ++g) {
+      const auto & d = domains_[g];
+      if (d.empty()) return {};
+      for (int w = bounds[g]; w < bounds[g+1]; ++w) {
+        cpus.push_back(d[(w - bounds[g]) % d.size()]);
+      }
+    }
+    return cpus;
+  }
+
+private:
+  std::vector<std::vector<int>> domains_;
+};
+
+/**
+\brief Get the group of a worker.
+\param bounds Bounds of the groups as returned by cpu_topology::worker_groups().
+\param worker Index of the worker.
+*/
+inline int worker_group(const std::vector<int> & bounds, int worker) noexcept
+{
+  return static_cast<int>(
+      std::upper_bound(bounds.begin(), bounds.end(), worker) - bounds.begin()) - 1;
+}
+
+/**
+\brief Hierarchical combination of one partial result per worker.
+Partial results of a group are combined by the last worker of the group to
+finish, while it is still running in the group domain. The caller only
+combines one value per group. Partial results are always combined in worker
+order.
+*/
+template <typename T, typename Combiner>
+class domain_combiner {
+public:
+
+  /**
+  \brief Construct a combiner for a set of partial results.
+  \param partials Partial results, one per worker.
+  \param bounds Bounds of the groups of workers.
+  \param combine_op Combination operation.
+  */
+  domain_combiner(std::vector<T> & partials, std::vector<int> bounds,
+      Combiner & combine_op) :
+    partials_{partials}, bounds_{std::move(bounds)}, combine_op_{combine_op},
+    pending_{new std::atomic<int>[bounds_.size()-1]}
+  {
+    for (std::size_t g = 0; g+1 < bounds_.size(); ++g) {
+      pending_[g].store(bounds_[g+1] - bounds_[g], std::memory_order_relaxed);
+    }
+  }
+
+  /**
+  \brief Notify that a worker has stored its partial result.
+  \param worker Index of the worker.
+  */
+  void done(int worker)
+  {
+    if (bounds_.size() < 3) return;
+    const int g = worker_group(bounds_, worker);
+    if (pending_[g].fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    auto first = std::next(partials_.begin(), bounds_[g]);
+    auto last = std::next(partials_.begin(), bounds_[g+1]);
+    *first = combine_partials(std::next(first), last, std::move(*first), 
+        combine_op_);
+  }
+
+  /**
+  \brief Combine the results of all groups.
+  \pre Every worker has called done().
+  */
+  T result()
+  {
+    if (bounds_.size() < 3) {
+      return combine_partials(std::next(partials_.begin()), partials_.end(),
+          std::move(partials_[0]), combine_op_);
+    }
+    T acc = std::move(partials_[0]);
+    for (std::size_t g = 0; g+1 < bounds_.size(); ++g) {
+      if (bounds_[g] == 0 || bounds_[g] == bounds_[g+1]) continue;
+      combine_partial(combine_op_, acc, partials_[bounds_[g]]);
+    }
+    return acc;
+  }
+
+private:
+  std::vector<T> & partials_;
+  std::vector<int> bounds_;
+  Combiner & combine_op_;
+  std::unique_ptr<std::atomic<int>[]> pending_;
+};
+
+/**
+\brief Make a hierarchical combiner for a set of partial results.
+*/
+template <typename T, typename Combiner>
+domain_combiner<T,Combiner> make_domain_combiner(std::vector<T> & partials,
+    std::vector<int> bounds, Combiner & combine_op)
+{
+  return {partials, std::move(bounds), combine_op};
+}
+
+} // namespace internal
+
+} // namespace grppi
+
+#endif
@@ -16,11 +16,253 @@
 #ifndef GRPPI_NATIVE_WORKER_POOL_H
 #define GRPPI_NATIVE_WORKER_POOL_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 namespace grppi {
 
+/**
+\brief Cache of parked threads.
+Every task is run by a thread of the cache that is waiting for work, or by a
+new thread if none is waiting. After running its task, a thread is parked
+until a new task arrives, so that threads are reused by later tasks instead
+of being created and joined for every task.
+*/
+class thread_cache {
+  public:
+
+    thread_cache() = default;
+
+    thread_cache(const thread_cache &) = delete;
+    thread_cache & operator=(const thread_cache &) = delete;
+
+    /**
+    \brief Destructs the cache after joining with all its threads.
+    \pre No task is running.
+    */
+    ~thread_cache() {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+      }
+      wakeup_.notify_all();
+      for (auto && t : threads_) { t.join(); }
+    }
+
+    /**
+    \brief Run a task in a thread of the cache.
+    The task is never delayed by other tasks, as a new thread is created when
+    no thread is parked.
+    \param task Task to be run.
+    \return A future that is ready once the task has finished and its thread
+    has been parked again.
+    */
+    std::future<void> run(std::function<void()> task) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.push_back({std::move(task), {}});
+      auto done = tasks_.back().done.get_future();
+      if (parked_ < tasks_.size()) {
+        ++parked_;
+        threads_.emplace_back([this] { serve(); });
+      }
+      wakeup_.notify_one();
+      return done;
+    }
+
+    /**
+    \brief Number of threads in the cache.
+    */
+    std::size_t size() const {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return threads_.size();
+    }
+
+  private:
+    void serve() {
+      std::unique_lock<std::mutex> lock{mutex_};
+      for (;;) {
+        wakeup_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) { return; }
+        auto job = std::move(tasks_.front());
+        tasks_.pop_front();
+        --parked_;
+        lock.unlock();
+        job.task();
+        job.task = nullptr;
+        lock.lock();
+        ++parked_;
+        job.done.set_value();
+      }
+    }
+
+  private:
+    struct job_type {
+      std::function<void()> task;
+      std::promise<void> done;
+    };
+
+    mutable std::mutex mutex_{};
+    std::condition_variable wakeup_{};
+    std::deque<job_type> tasks_{};
+    std::size_t parked_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> threads_{};
+};
+
+/**
+\brief Fixed set of threads running the subproblems of a fork.
+All threads are created at construction and stay parked until a subproblem
+is handed to them. Handing a subproblem to a thread does not allocate memory,
+as the subproblem is described by a slot owned by the caller.
+*/
+class fork_pool {
+  public:
+
+    /**
+    \brief Subproblem handed to a thread of the pool.
+    A posted slot must be waited for before it is destroyed.
+    */
+    class slot {
+      public:
+        /**
+        \brief Binds the slot to the invocation `task(index)`.
+        \tparam Task Type of the task.
+        \param task Task to be invoked. It must outlive the slot.
+        \param index Index passed to the task.
+        */
+        template <typename Task>
+        void bind(Task & task, std::size_t index) noexcept {
+          run_ = [](void * t, std::size_t i) { (*static_cast<Task*>(t))(i); };
+          task_ = &task;
+          index_ = index;
+        }
+
+      private:
+        friend class fork_pool;
+
+        void (*run_)(void *, std::size_t) = nullptr;
+        void * task_ = nullptr;
+        std::size_t index_ = 0;
+        bool posted_ = false;
+        bool done_ = false;
+        std::mutex mutex_{};
+        std::condition_variable finished_{};
+    };
+
+    /**
+    \brief Creates the threads of the pool.
+    Every thread stays registered in the execution policy until the pool is
+    destroyed.
+    \tparam E Execution policy type.
+    \param ex Execution policy. It must outlive the pool.
+    \param num_threads Number of threads for the pool.
+    */
+    template <typename E>
+    fork_pool(const E & ex, int num_threads) :
+        workers_(num_threads > 0 ? num_threads : 0)
+    {
+      threads_.reserve(workers_.size());
+      for (auto & w : workers_) {
+        threads_.emplace_back([this,&w,&ex] {
+          auto manager = ex.thread_manager();
+          serve(w);
+        });
+      }
+    }
+
+    fork_pool(const fork_pool &) = delete;
+    fork_pool & operator=(const fork_pool &) = delete;
+
+    /**
+    \brief Destructs the pool after joining with all its threads.
+    \pre Every posted slot has been waited for.
+    */
+    ~fork_pool() {
+      for (auto & w : workers_) {
+        {
+          std::lock_guard<std::mutex> lock{w.mutex};
+          w.stop = true;
+        }
+        w.wakeup.notify_one();
+      }
+      for (auto && t : threads_) { t.join(); }
+    }
+
+    /**
+    \brief Hands a subproblem to a parked thread, if there is one.
+    \param s Slot of the subproblem.
+    \return true if the subproblem was handed to a thread, false if every 
+    thread is busy and the caller has to run the subproblem itself.
+    */
+    bool try_post(slot & s) noexcept {
+      for (auto & w : workers_) {
+        bool idle = false;
+        if (!w.busy.load(std::memory_order_relaxed) &&
+            w.busy.compare_exchange_strong(idle, true))
+        {
+          s.posted_ = true;
+          {
+            std::lock_guard<std::mutex> lock{w.mutex};
+            w.job = &s;
+          }
+          w.wakeup.notify_one();
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+    \brief Waits until a posted subproblem has been run.
+    Does nothing if the slot was not posted.
+    \param s Slot of the subproblem.
+    */
+    void wait(slot & s) {
+      if (!s.posted_) { return; }
+      std::unique_lock<std::mutex> lock{s.mutex_};
+      s.finished_.wait(lock, [&s] { return s.done_; });
+    }
+
+  private:
+    struct worker {
+      std::atomic<bool> busy{false};
+      std::mutex mutex{};
+      std::condition_variable wakeup{};
+      slot * job = nullptr;
+      bool stop = false;
+    };
+
+    void serve(worker & w) {
+      for (;;) {
+        slot * job = nullptr;
+        {
+          std::unique_lock<std::mutex> lock{w.mutex};
+          w.wakeup.wait(lock, [&w] { return w.job != nullptr || w.stop; });
+          if (w.job == nullptr) { return; }
+          job = w.job;
+          w.job = nullptr;
+        }
+        job->run_(job->task_, job->index_);
+        w.busy.store(false);
+        // The slot may be destroyed as soon as its mutex is released
+        std::lock_guard<std::mutex> lock{job->mutex_};
+        job->done_ = true;
+        job->finished_.notify_one();
+      }
+    }
+
+  private:
+    std::vector<worker> workers_;
+    std::vector<std::thread> threads_{};
+};
+
 /**
 \brief Pool of worker threads.
 This class offers a simple pool of worker threads.
@@ -59,8 +301,29 @@ class worker_pool {
     */
     template <typename E, typename F, typename ... Args>
     void launch(const E & ex, F f, Args && ... args) {
-      workers_.emplace_back([=,&ex]() {
+      start(ex, [=,&ex]() {
+        auto manager = ex.thread_manager();
+        f(args...);
+      });
+    }
+
+    /**
+    \brief Launch the processing of a data chunk in the pool.
+    The thread is bound to the CPU of the chunk when the execution policy
+    keeps a fixed mapping of chunks to CPUs.
+    \tparam E Execution policy type.
+    \tparam F Type for launched function.
+    \tparam Args Type for launched function arguments.
+    \param ex Execution policy.
+    \param chunk Index of the chunk.
+    \param f Function to be launched.
+    \param args Arguments for launched function.
+    */
+    template <typename E, typename F, typename ... Args>
+    void launch_chunk(const E & ex, int chunk, F f, Args && ... args) {
+      start(ex, [=,&ex]() {
         auto manager = ex.thread_manager();
+        auto binding = ex.bind_to_chunk(chunk);
         f(args...);
       });
     }
@@ -68,7 +331,7 @@ class worker_pool {
     template <typename E, typename F, typename ... Args>
     void launch_tasks(const E & ex, F && f, Args && ... args) {
       for (int i=0; i<num_threads_; ++i) {
-        workers_.emplace_back([=,&ex]() {
+        start(ex, [=,&ex]() {
           auto manager = ex.thread_manager();
           f(args...);
         });
@@ -82,11 +345,26 @@ class worker_pool {
     void wait() noexcept {
       for (auto && w : workers_) { w.join(); }
       workers_.clear();
+      for (auto && t : cached_) { t.wait(); }
+      cached_.clear();
+    }
+
+  private:
+    // Tasks run in the thread cache of the policy, if it has one
+    template <typename E, typename F>
+    void start(const E & ex, F && f) {
+      if (auto * cache = ex.cached_threads()) {
+        cached_.push_back(cache->run(std::forward<F>(f)));
+      }
+      else {
+        workers_.emplace_back(std::forward<F>(f));
+      }
     }
 
   private:
     const int num_threads_;
     std::vector<std::thread> workers_;
+    std::vector<std::future<void>> cached_{};
 };
 
 }
@@ -20,10 +20,15 @@
 
 #include "../common/mpmc_queue.h"
 #include "../common/iterator.h"
+#include "../common/accumulate.h"
+#include "../common/inplace_divide_conquer.h"
 #include "../common/execution_traits.h"
 #include "../common/configuration.h"
+#include "../common/sequence_tracker.h"
 #include "grppi/seq/sequential_execution.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <type_traits>
 #include <tuple>
 
@@ -299,6 +304,27 @@ namespace grppi {
         Solver && solve_op,
         Combiner && combine_op) const;
 
+    /**
+    \brief Invoke \ref md_divide-conquer with problems solved in place.
+    \tparam Problem Type used for the problem (usually a lightweight view).
+    \tparam Divider Callable type for the divider operation.
+    \tparam Predicate Callable type for the stop condition predicate.
+    \tparam Solver Callable type for the solver operation.
+    \tparam Combiner Callable type for the combiner operation.
+    \param problem Problem to be solved.
+    \param divider_op Divider operation returning a std::array of subproblems.
+    \param predicate_op Predicate operation.
+    \param solver_op Solver operation.
+    \param combine_op Combiner operation.
+    */
+    template <typename Problem, typename Divider, typename Predicate,
+        typename Solver, typename Combiner>
+    auto inplace_divide_conquer(const Problem & problem,
+        Divider && divide_op,
+        Predicate && predicate_op,
+        Solver && solve_op,
+        Combiner && combine_op) const;
+
 
     /**
     \brief Invoke \ref md_pipeline.
@@ -500,11 +526,48 @@ namespace grppi {
     do_pipeline(Queue && input_queue, Reduce<Combiner, Identity> && reduce_obj,
         OtherTransformers && ... other_transform_ops) const;
 
+    template<typename Queue, typename TimeReduce,
+        typename ... OtherTransformers,
+        requires_time_reduce <TimeReduce> = 0>
+    void
+    do_pipeline(Queue && input_queue, TimeReduce && reduce_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Queue, typename Keyed,
+        typename ... OtherTransformers,
+        requires_keyed <Keyed> = 0>
+    void
+    do_pipeline(Queue && input_queue, Keyed && keyed_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Queue, typename FlatMap,
+        typename ... OtherTransformers,
+        requires_flat_map <FlatMap> = 0>
+    void do_pipeline(Queue && input_queue, FlatMap && flat_map_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Queue, typename Batch,
+        typename ... OtherTransformers,
+        requires_batch <Batch> = 0>
+    void do_pipeline(Queue && input_queue, Batch && batch_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Queue, typename Split,
+        typename ... OtherTransformers,
+        requires_split <Split> = 0>
+    void do_pipeline(Queue & input_queue, Split && split_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Queue, typename Join,
+        typename ... OtherTransformers,
+        requires_join <Join> = 0>
+    void do_pipeline(Queue & input_queue, Join && join_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
     template<typename Queue, typename Transformer, typename Predicate,
         template<typename T, typename P> class Iteration,
         typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_no_pattern <Transformer> = 0>
+        requires_iteration <Iteration<Transformer, Predicate>> = 0>
     void do_pipeline(Queue & input_queue,
         Iteration<Transformer, Predicate> & iteration_obj,
         OtherTransformers && ... other_transform_ops) const
@@ -516,17 +579,7 @@ namespace grppi {
     template<typename Queue, typename Transformer, typename Predicate,
         template<typename T, typename P> class Iteration,
         typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_no_pattern <Transformer> = 0>
-    void do_pipeline(Queue & input_queue,
-        Iteration<Transformer, Predicate> && iteration_obj,
-        OtherTransformers && ... other_transform_ops) const;
-
-    template<typename Queue, typename Transformer, typename Predicate,
-        template<typename T, typename P> class Iteration,
-        typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_pipeline <Transformer> = 0>
+        requires_iteration <Iteration<Transformer, Predicate>> = 0>
     void do_pipeline(Queue & input_queue,
         Iteration<Transformer, Predicate> && iteration_obj,
         OtherTransformers && ... other_transform_ops) const;
@@ -643,6 +696,15 @@ namespace grppi {
   constexpr bool
   supports_divide_conquer<parallel_execution_omp>() { return true; }
 
+/**
+\brief Determines if an execution policy supports the in place divide/conquer
+pattern.
+\note Specialization for parallel_execution_omp when GRPPI_OMP is enabled.
+*/
+  template<>
+  constexpr bool
+  supports_inplace_divide_conquer<parallel_execution_omp>() { return true; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note Specialization for parallel_execution_omp when GRPPI_OMP is enabled.
@@ -710,9 +772,8 @@ namespace grppi {
       }
     }
 
-    return seq.reduce(std::next(partial_results.begin()),
-        partial_results.size() - 1,
-        partial_results[0], std::forward<Combiner>(combine_op));
+    return internal::combine_partials(std::next(partial_results.begin()),
+        partial_results.end(), std::move(partial_results[0]), combine_op);
   }
 
   template<typename ... InputIterators, typename Identity,
@@ -762,9 +823,8 @@ namespace grppi {
       }
     }
 
-    return seq.reduce(partial_results.begin(),
-        partial_results.size(), std::forward<Identity>(identity),
-        std::forward<Combiner>(combine_op));
+    return internal::combine_partials(std::next(partial_results.begin()),
+        partial_results.end(), std::move(partial_results[0]), combine_op);
   }
 
   template<typename ... InputIterators, typename OutputIterator,
@@ -807,6 +867,45 @@ namespace grppi {
     }
   }
 
+  template <typename Problem, typename Divider, typename Predicate,
+      typename Solver, typename Combiner>
+  auto parallel_execution_omp::inplace_divide_conquer(
+      const Problem & problem,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const
+  {
+    auto fork = [](auto n, auto & task) {
+      for (std::size_t i = 1; i < n; ++i) {
+#pragma omp task firstprivate(i) shared(task)
+        task(i);
+      }
+      task(0);
+#pragma omp taskwait
+    };
+
+    using result_type = std::decay_t<decltype(solve_op(problem))>;
+    if constexpr (std::is_void<result_type>::value) {
+#pragma omp parallel
+      {
+#pragma omp single nowait
+        internal::inplace_divide_conquer(problem, divide_op, predicate_op,
+            solve_op, combine_op, fork);
+      }
+    }
+    else {
+      result_type result;
+#pragma omp parallel
+      {
+#pragma omp single nowait
+        result = internal::inplace_divide_conquer(problem, divide_op, 
+            predicate_op, solve_op, combine_op, fork);
+      }
+      return result;
+    }
+  }
+
   template<typename Input, typename Divider, typename Predicate, typename Solver, typename Combiner>
   auto parallel_execution_omp::divide_conquer(
       Input && input,
@@ -1334,121 +1433,44 @@ namespace grppi {
     using namespace std;
     using input_type = typename Queue::value_type;
     using input_value_type = typename input_type::first_type;
-    auto filter_queue = make_queue<input_type>();
 
-    if (is_ordered()) {
-      auto filter_task = [&]() {
-        {
-          auto item{input_queue.pop()};
-          while (item.first) {
-            if (filter_obj.keep()) {
-              if (filter_obj(*item.first)) {
-                filter_queue.push(item);
-              }
-              else {
-                filter_queue.push(make_pair(input_value_type{}, item.second));
-              }
-            }
-            else {
-              if (!filter_obj(*item.first)) {
-                filter_queue.push(item);
-              }
-              else {
-                filter_queue.push(make_pair(input_value_type{}, item.second));
-              }
-            }
-            item = input_queue.pop();
-          }
-          filter_queue.push(make_pair(input_value_type{}, -1));
-        }
+    decltype(auto) output_queue =
+        get_output_queue<input_type>(other_transform_ops...);
+
+    // Discarded items are not sent downstream. When ordered, kept items are
+    // renumbered here and discarded ones are only tracked as skipped numbers.
+    auto filter_task = [&]() {
+      internal::sequence_tracker<input_value_type> tracker;
+      auto emit = [&](input_value_type && value, long order) {
+        output_queue.push(make_pair(move(value), order));
       };
-
-      decltype(auto) output_queue =
-          get_output_queue<input_type>(other_transform_ops...);
-
-
-      auto reorder_task = [&]() {
-        vector<input_type> elements;
-        int current = 0;
-        long order = 0;
-        auto item = filter_queue.pop();
-        for (;;) {
-          if (!item.first && item.second == -1) { break; }
-          if (item.second == current) {
-            if (item.first) {
-              output_queue.push(make_pair(item.first, order++));
-            }
-            current++;
-          }
-          else {
-            elements.push_back(item);
-          }
-          auto it = find_if(elements.begin(), elements.end(),
-              [&](auto x) { return x.second == current; });
-          if (it != elements.end()) {
-            if (it->first) {
-              output_queue.push(make_pair(it->first, order));
-              order++;
-            }
-            elements.erase(it);
-            current++;
-          }
-          item = filter_queue.pop();
+      long order = 0;
+      auto item{input_queue.pop()};
+      while (item.first) {
+        const bool matches = filter_obj(*item.first);
+        const bool kept = (matches == filter_obj.keep());
+        if (!is_ordered()) {
+          if (kept) { emit(move(item.first), order++); }
         }
-
-        while (elements.size() > 0) {
-          auto it = find_if(elements.begin(), elements.end(),
-              [&](auto x) { return x.second == current; });
-          if (it != elements.end()) {
-            if (it->first) {
-              output_queue.push(make_pair(it->first, order));
-              order++;
-            }
-            elements.erase(it);
-            current++;
-          }
-          item = filter_queue.pop();
+        else if (kept) {
+          tracker.keep(item.second, move(item.first), emit);
         }
-
-        output_queue.push(item);
-      };
-
-
-#pragma omp task shared(filter_queue, filter_obj, input_queue)
-      {
-        filter_task();
-      }
-
-#pragma omp task shared (output_queue, filter_queue)
-      {
-        reorder_task();
+        else {
+          tracker.skip(item.second, emit);
+        }
+        item = input_queue.pop();
       }
+      output_queue.push(make_pair(input_value_type{}, -1));
+    };
 
-      do_pipeline(output_queue,
-          forward<OtherTransformers>(other_transform_ops)...);
-
-#pragma omp taskwait
+#pragma omp task shared(output_queue, filter_obj, input_queue)
+    {
+      filter_task();
     }
-    else {
-      auto filter_task = [&]() {
-        auto item = input_queue.pop();
-        while (item.first) {
-          if (filter_obj(*item.first)) {
-            filter_queue.push(item);
-          }
-          item = input_queue.pop();
-        }
-        filter_queue.push(make_pair(input_value_type{}, -1));
-      };
 
-#pragma omp task shared(filter_queue, filter_obj, input_queue)
-      {
-        filter_task();
-      }
-      do_pipeline(filter_queue,
-          std::forward<OtherTransformers>(other_transform_ops)...);
+    do_pipeline(output_queue,
+        forward<OtherTransformers>(other_transform_ops)...);
 #pragma omp taskwait
-    }
   }
 
 
@@ -1493,71 +1515,520 @@ namespace grppi {
 #pragma omp taskwait
   }
 
-  template<typename Queue, typename Transformer, typename Predicate,
-      template<typename T, typename P> class Iteration,
+  template<typename Queue, typename TimeReduce,
       typename ... OtherTransformers,
-      requires_iteration <Iteration<Transformer, Predicate>>,
-      requires_no_pattern <Transformer>>
+      requires_time_reduce <TimeReduce>>
   void parallel_execution_omp::do_pipeline(
-      Queue & input_queue,
-      Iteration<Transformer, Predicate> && iteration_obj,
+      Queue && input_queue,
+      TimeReduce && reduce_obj,
       OtherTransformers && ... other_transform_ops) const
   {
     using namespace std;
 
     using input_item_type = typename decay_t<Queue>::value_type;
+    using output_item_value_type =
+        grppi::optional<typename decay_t<TimeReduce>::input_type>;
+    using output_item_type = pair<output_item_value_type, long>;
+
     decltype(auto) output_queue =
-        get_output_queue<input_item_type>(other_transform_ops...);
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    auto reduce_task = [&]() {
+      constexpr sequential_execution seq;
+      long order = 0;
+      auto emit_closed = [&]() {
+        while (reduce_obj.reduction_needed()) {
+          output_queue.push(make_pair(reduce_obj.reduce_window(seq), order++));
+        }
+      };
+      for (input_item_type item{input_queue.pop()}; item.first;
+          item = input_queue.pop()) {
+        reduce_obj.add_item(*item.first);
+        emit_closed();
+      }
+      reduce_obj.flush();
+      emit_closed();
+      output_queue.push(make_pair(output_item_value_type{}, -1));
+    };
 
+#pragma omp task shared(reduce_obj, input_queue, output_queue)
+    {
+      reduce_task();
+    }
+    do_pipeline(output_queue,
+        std::forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
+  }
 
-    auto iteration_task = [&]() {
-      for (;;) {
-        auto item = input_queue.pop();
-        if (!item.first) { break; }
-        auto value = iteration_obj.transform(*item.first);
-        auto new_item = input_item_type{value, item.second};
-        if (iteration_obj.predicate(value)) {
-          output_queue.push(new_item);
+  template<typename Queue, typename FlatMap,
+      typename ... OtherTransformers,
+      requires_flat_map <FlatMap>>
+  void parallel_execution_omp::do_pipeline(
+      Queue && input_queue,
+      FlatMap && flat_map_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using namespace std;
+
+    using input_item_type = typename decay_t<Queue>::value_type;
+    using input_value_type = typename input_item_type::first_type;
+    using output_type = typename decay_t<FlatMap>::output_type;
+    using output_value_type = grppi::optional<output_type>;
+    using output_item_type = pair<output_value_type, long>;
+
+    decltype(auto) output_queue =
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    // Outputs are numbered as they are produced. When ordered, items are
+    // released in input order first, so that outputs follow the input order.
+    auto flat_map_task = [&]() {
+      long order = 0;
+      auto emit = [&](output_type && value) {
+        output_queue.push(make_pair(output_value_type{move(value)}, order++));
+      };
+      auto apply = [&](input_value_type && item, long) {
+        flat_map_obj(*item, emit);
+      };
+      internal::sequence_tracker<input_value_type> tracker;
+      for (auto item{input_queue.pop()}; item.first;
+          item = input_queue.pop()) {
+        if (is_ordered()) {
+          tracker.keep(item.second, move(item.first), apply);
         }
         else {
-          input_queue.push(new_item);
+          flat_map_obj(*item.first, emit);
         }
       }
-      while (!input_queue.empty()) {
-        auto item = input_queue.pop();
-        auto value = iteration_obj.transform(*item.first);
-        auto new_item = input_item_type{value, item.second};
-        if (iteration_obj.predicate(value)) {
-          output_queue.push(new_item);
+      output_queue.push(make_pair(output_value_type{}, -1));
+    };
+
+#pragma omp task shared(flat_map_obj, input_queue, output_queue)
+    {
+      flat_map_task();
+    }
+    do_pipeline(output_queue,
+        std::forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
+  }
+
+  template<typename Queue, typename Batch,
+      typename ... OtherTransformers,
+      requires_batch <Batch>>
+  void parallel_execution_omp::do_pipeline(
+      Queue && input_queue,
+      Batch && batch_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using namespace std;
+
+    using input_item_type = typename decay_t<Queue>::value_type;
+    using input_value_type = typename input_item_type::first_type;
+    using output_value_type =
+        grppi::optional<typename decay_t<Batch>::output_type>;
+    using output_item_type = pair<output_value_type, long>;
+
+    decltype(auto) output_queue =
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    // Full batches are emitted by the stage task, while expired batches are
+    // emitted by a timer task. Both emit under the batch lock.
+    using batch_type = decay_t<Batch>;
+    mutex batch_mutex;
+    condition_variable batch_cv;
+    bool done = false;
+    long order = 0;
+    auto emit_batch = [&]() {
+      output_queue.push(make_pair(
+          output_value_type{batch_obj.take_batch()}, order++));
+    };
+    auto add = [&](input_value_type && item, long) {
+      unique_lock<mutex> lock{batch_mutex};
+      const bool started = batch_obj.empty();
+      batch_obj.add_item(move(*item));
+      if (batch_obj.full()) { emit_batch(); }
+      else if (started) { batch_cv.notify_one(); }
+    };
+
+    auto batch_task = [&]() {
+      internal::sequence_tracker<input_value_type> tracker;
+      for (auto item{input_queue.pop()}; item.first;
+          item = input_queue.pop()) {
+        if (is_ordered()) { tracker.keep(item.second, move(item.first), add); }
+        else { add(move(item.first), item.second); }
+      }
+      unique_lock<mutex> lock{batch_mutex};
+      if (!batch_obj.empty()) { emit_batch(); }
+      output_queue.push(make_pair(output_value_type{}, -1));
+      done = true;
+      batch_cv.notify_one();
+    };
+
+    auto timer_task = [&]() {
+      unique_lock<mutex> lock{batch_mutex};
+      while (!done) {
+        if (batch_obj.empty()) { batch_cv.wait(lock); }
+        else if (batch_obj.batch_ready()) { emit_batch(); }
+        else { batch_cv.wait_until(lock, batch_obj.deadline()); }
+      }
+    };
+
+#pragma omp task shared(batch_task)
+    {
+      batch_task();
+    }
+    if (batch_obj.timeout() > batch_type::clock_type::duration::zero()) {
+#pragma omp task shared(timer_task)
+      {
+        timer_task();
+      }
+    }
+    do_pipeline(output_queue,
+        std::forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
+  }
+
+  template<typename Queue, typename Split,
+      typename ... OtherTransformers,
+      requires_split <Split>>
+  void parallel_execution_omp::do_pipeline(
+      Queue & input_queue,
+      Split && split_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using namespace std;
+
+    using split_type = decay_t<Split>;
+    using input_item_type = typename Queue::value_type;
+    using input_value_type = typename input_item_type::first_type;
+    constexpr auto nbranches = split_type::size();
+
+    // Every branch numbers its own items
+    vector<mpmc_queue<input_item_type>> branch_queues;
+    branch_queues.reserve(nbranches);
+    for (size_t i = 0; i < nbranches; ++i) {
+      branch_queues.push_back(make_queue<input_item_type>());
+    }
+
+    auto route_task = [&]() {
+      vector<long> order(nbranches, 0);
+      auto route = [&](input_value_type && item, long) {
+        if constexpr (split_type::is_broadcast) {
+          for (size_t i = 0; i < nbranches; ++i) {
+            branch_queues[i].push(make_pair(item, order[i]++));
+          }
+        }
+        else {
+          auto i = split_obj.route(*item);
+          branch_queues[i].push(make_pair(move(item), order[i]++));
+        }
+      };
+      internal::sequence_tracker<input_value_type> tracker;
+      for (auto item{input_queue.pop()}; item.first;
+          item = input_queue.pop()) {
+        if (is_ordered()) {
+          tracker.keep(item.second, move(item.first), route);
+        }
+        else {
+          route(move(item.first), item.second);
+        }
+      }
+      for (auto & queue : branch_queues) {
+        queue.push(make_pair(input_value_type{}, -1));
+      }
+    };
+
+    if constexpr (sizeof...(OtherTransformers) == 0) {
+      for (size_t i = 0; i < nbranches; ++i) {
+#pragma omp task shared(split_obj, branch_queues) firstprivate(i)
+        {
+          split_obj.apply_to(i, [&](auto & branch) {
+            do_pipeline(branch_queues[i], branch);
+          });
+        }
+      }
+      route_task();
+#pragma omp taskwait
+    }
+    else {
+      using output_type = typename split_type::template output_type<
+          typename input_value_type::value_type>;
+      static_assert(!is_void<output_type>::value,
+          "Branches of an intermediate split must produce a result");
+      using output_value_type = grppi::optional<output_type>;
+      using output_item_type = pair<output_value_type, long>;
+
+      decltype(auto) output_queue =
+          get_output_queue<output_item_type>(other_transform_ops...);
+
+      vector<mpmc_queue<output_item_type>> merge_queues;
+      merge_queues.reserve(nbranches);
+      for (size_t i = 0; i < nbranches; ++i) {
+        merge_queues.push_back(make_queue<output_item_type>());
+      }
+
+      // Outputs of a branch are released in order and renumbered as merged
+      atomic<long> order{0};
+      atomic<size_t> done_branches{0};
+      auto merge_task = [&](size_t i) {
+        auto emit = [&](output_value_type && value, long) {
+          output_queue.push(make_pair(move(value), order++));
+        };
+        internal::sequence_tracker<output_value_type> tracker;
+        for (auto item{merge_queues[i].pop()}; item.first;
+            item = merge_queues[i].pop()) {
+          if (is_ordered()) {
+            tracker.keep(item.second, move(item.first), emit);
+          }
+          else {
+            emit(move(item.first), item.second);
+          }
+        }
+        if (++done_branches == nbranches) {
+          output_queue.push(make_pair(output_value_type{}, -1));
+        }
+      };
+
+#pragma omp task shared(route_task)
+      {
+        route_task();
+      }
+      for (size_t i = 0; i < nbranches; ++i) {
+#pragma omp task shared(split_obj, branch_queues, merge_queues) firstprivate(i)
+        {
+          split_obj.apply_to(i, [&](auto & branch) {
+            do_pipeline(branch_queues[i], branch, merge_queues[i]);
+          });
+          merge_queues[i].push(make_pair(output_value_type{}, -1));
+        }
+#pragma omp task shared(merge_task) firstprivate(i)
+        {
+          merge_task(i);
+        }
+      }
+      do_pipeline(output_queue,
+          forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
+    }
+  }
+
+  template<typename Queue, typename Join,
+      typename ... OtherTransformers,
+      requires_join <Join>>
+  void parallel_execution_omp::do_pipeline(
+      Queue & input_queue,
+      Join && join_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using namespace std;
+    static_assert(sizeof...(OtherTransformers) > 0,
+        "A join cannot be the last stage of a pipeline");
+
+    using join_type = decay_t<Join>;
+    using input_item_type = typename Queue::value_type;
+    using input_value_type = typename input_item_type::first_type;
+    using left_item_type =
+        pair<grppi::optional<typename join_type::left_type>, long>;
+    using right_item_type =
+        pair<grppi::optional<typename join_type::right_type>, long>;
+    using output_value_type =
+        grppi::optional<typename join_type::output_type>;
+    using output_item_type = pair<output_value_type, long>;
+
+    decltype(auto) output_queue =
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    auto left_queue = make_queue<input_item_type>();
+    auto right_queue = make_queue<input_item_type>();
+    auto left_output = make_queue<left_item_type>();
+    auto right_output = make_queue<right_item_type>();
+
+    // Both branches number items in the same way
+    auto route_task = [&]() {
+      long order = 0;
+      auto route = [&](input_value_type && item, long) {
+        left_queue.push(make_pair(item, order));
+        right_queue.push(make_pair(move(item), order));
+        order++;
+      };
+      internal::sequence_tracker<input_value_type> tracker;
+      for (auto item{input_queue.pop()}; item.first;
+          item = input_queue.pop()) {
+        if (is_ordered()) {
+          tracker.keep(item.second, move(item.first), route);
         }
         else {
-          input_queue.push(new_item);
+          route(move(item.first), item.second);
+        }
+      }
+      left_queue.push(make_pair(input_value_type{}, -1));
+      right_queue.push(make_pair(input_value_type{}, -1));
+    };
+
+    // Pairs by position keep the order of their position
+    mutex join_mutex;
+    long order = 0;
+    int done_branches = 0;
+    auto join_task = [&](auto & queue, auto add) {
+      for (auto item{queue.pop()}; item.first; item = queue.pop()) {
+        lock_guard<mutex> lock{join_mutex};
+        auto out = add(item.second, move(*item.first));
+        if (out) {
+          const long seq = (join_type::by_sequence && is_ordered()) ?
+              item.second : order++;
+          output_queue.push(make_pair(output_value_type{move(*out)}, seq));
         }
       }
-      output_queue.push(input_item_type{{}, -1});
+      lock_guard<mutex> lock{join_mutex};
+      if (++done_branches == 2) {
+        join_obj.clear();
+        output_queue.push(make_pair(output_value_type{}, -1));
+      }
+    };
+    auto left_task = [&]() {
+      do_pipeline(left_queue, join_obj.left(), left_output);
+      left_output.push(left_item_type{{}, -1});
+    };
+    auto right_task = [&]() {
+      do_pipeline(right_queue, join_obj.right(), right_output);
+      right_output.push(right_item_type{{}, -1});
+    };
+    auto join_left_task = [&]() {
+      join_task(left_output, [&](long seq, auto && value) {
+        return join_obj.add_left(seq, move(value));
+      });
+    };
+    auto join_right_task = [&]() {
+      join_task(right_output, [&](long seq, auto && value) {
+        return join_obj.add_right(seq, move(value));
+      });
     };
 
-#pragma omp task shared(iteration_obj, input_queue, output_queue)
+#pragma omp task shared(route_task)
+    {
+      route_task();
+    }
+#pragma omp task shared(left_task)
     {
-      iteration_task();
+      left_task();
+    }
+#pragma omp task shared(right_task)
+    {
+      right_task();
+    }
+#pragma omp task shared(join_left_task)
+    {
+      join_left_task();
+    }
+#pragma omp task shared(join_right_task)
+    {
+      join_right_task();
     }
     do_pipeline(output_queue,
-        std::forward<OtherTransformers>(other_transform_ops)...);
+        forward<OtherTransformers>(other_transform_ops)...);
 #pragma omp taskwait
+  }
+
+  template<typename Queue, typename Keyed,
+      typename ... OtherTransformers,
+      requires_keyed <Keyed>>
+  void parallel_execution_omp::do_pipeline(
+      Queue && input_queue,
+      Keyed && keyed_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using namespace std;
+
+    using output_item_value_type =
+        grppi::optional<typename decay_t<Keyed>::output_type>;
+    using output_item_type = pair<output_item_value_type, long>;
 
+    decltype(auto) output_queue =
+        get_output_queue<output_item_type>(other_transform_ops...);
+
+    // Keys are processed by a single task, going through every shard
+    auto keyed_task = [&]() {
+      long order = 0;
+      auto item{input_queue.pop()};
+      while (item.first) {
+        auto out = keyed_obj(keyed_obj.shard(*item.first), *item.first);
+        if (out) {
+          output_queue.push(make_pair(std::move(out), order++));
+        }
+        item = input_queue.pop();
+      }
+      output_queue.push(make_pair(output_item_value_type{}, -1));
+    };
+
+#pragma omp task shared(keyed_obj, input_queue, output_queue)
+    {
+      keyed_task();
+    }
+    do_pipeline(output_queue,
+        std::forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
   }
 
   template<typename Queue, typename Transformer, typename Predicate,
       template<typename T, typename P> class Iteration,
       typename ... OtherTransformers,
-      requires_iteration <Iteration<Transformer, Predicate>>,
-      requires_pipeline <Transformer>>
+      requires_iteration <Iteration<Transformer, Predicate>>>
   void parallel_execution_omp::do_pipeline(
-      Queue &,
-      Iteration<Transformer, Predicate> &&,
-      OtherTransformers && ...) const
+      Queue & input_queue,
+      Iteration<Transformer, Predicate> && iteration_obj,
+      OtherTransformers && ... other_transform_ops) const
   {
-    static_assert(!is_pipeline<Transformer>, "Not implemented");
+    using namespace std;
+
+    using input_item_type = typename decay_t<Queue>::value_type;
+    using input_value_type = typename input_item_type::first_type;
+    decltype(auto) output_queue =
+        get_output_queue<input_item_type>(other_transform_ops...);
+
+    // Every replica loops on its item until the predicate holds. With several
+    // ordered replicas, items keep their sequence number and are released in
+    // order by a collector.
+    atomic<int> done_threads{0};
+    const int ntasks = iteration_obj.cardinality();
+    const bool reorder = is_ordered() && ntasks > 1;
+    auto results_queue = make_queue<input_item_type>();
+    auto & replica_queue = reorder ? results_queue : output_queue;
+    for (int i = 0; i < ntasks; ++i) {
+#pragma omp task shared(done_threads, iteration_obj, input_queue, replica_queue)
+      {
+        for (auto item{input_queue.pop()}; item.first;
+            item = input_queue.pop()) {
+          auto value = iteration_obj.transform(*item.first);
+          while (!iteration_obj.predicate(value)) {
+            value = iteration_obj.transform(value);
+          }
+          replica_queue.push(
+              make_pair(input_value_type{move(value)}, item.second));
+        }
+        if (++done_threads == ntasks) {
+          replica_queue.push(make_pair(input_value_type{}, -1));
+        }
+        else {
+          input_queue.push(input_item_type{});
+        }
+      }
+    }
+    if (reorder) {
+#pragma omp task shared(results_queue, output_queue)
+      {
+        internal::sequence_tracker<input_value_type> tracker;
+        auto emit = [&](input_value_type && value, long order) {
+          output_queue.push(make_pair(move(value), order));
+        };
+        for (auto item{results_queue.pop()}; item.first;
+            item = results_queue.pop()) {
+          tracker.keep(item.second, move(item.first), emit);
+        }
+        output_queue.push(make_pair(input_value_type{}, -1));
+      }
+    }
+    do_pipeline(output_queue,
+        std::forward<OtherTransformers>(other_transform_ops)...);
+#pragma omp taskwait
   }
 
   template<typename Queue, typename ... Transformers,
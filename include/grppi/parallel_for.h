@@ -0,0 +1,90 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_PARALLEL_FOR_H
+#define GRPPI_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <utility>
+
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/index_space.h"
+#include "grppi/common/tiled_for.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup parallel_for_pattern Parallel for pattern
+\brief Interface for applyinng the \ref md_parallel-for.
+@{
+*/
+
+/**
+\brief Invoke \ref md_parallel-for over an index space.
+The first dimension of the space is evenly split among workers.
+\tparam Execution Execution type.
+\tparam N Number of dimensions of the index space.
+\tparam Body Callable type for the body operation.
+\param ex Execution policy object.
+\param space Index space.
+\param body_op Body operation. It takes either `N` indices or a 
+`grppi::tile<N>`.
+*/
+template <typename Execution, std::size_t N, typename Body>
+void parallel_for(const Execution & ex,
+                  const index_space<N> & space,
+                  Body && body_op)
+{
+  static_assert(supports_map<Execution>(),
+                "parallel_for not supported on execution type");
+  const auto workers = static_cast<std::size_t>(
+      std::max(1, ex.concurrency_degree()));
+  internal::tiled_for(ex, space, internal::default_tiling(space, workers),
+      std::forward<Body>(body_op));
+}
+
+/**
+\brief Invoke \ref md_parallel-for over a tiled index space.
+\tparam Execution Execution type.
+\tparam N Number of dimensions of the index space.
+\tparam Body Callable type for the body operation.
+\param ex Execution policy object.
+\param space Index space.
+\param tiles Tiling of the space (see grppi::static_tiles() and 
+grppi::dynamic_tiles()).
+\param body_op Body operation. It takes either `N` indices or a 
+`grppi::tile<N>`.
+*/
+template <typename Execution, std::size_t N, typename Body>
+void parallel_for(const Execution & ex,
+                  const index_space<N> & space,
+                  const tiling<N> & tiles,
+                  Body && body_op)
+{
+  static_assert(supports_map<Execution>(),
+                "parallel_for not supported on execution type");
+  internal::tiled_for(ex, space, tiles, std::forward<Body>(body_op));
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "grppi/common/callable_traits.h"
+#include "grppi/common/cancellation.h"
 #include "grppi/common/execution_traits.h"
 #include "grppi/common/pipeline_pattern.h"
 
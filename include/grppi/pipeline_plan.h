@@ -0,0 +1,64 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_PIPELINE_PLAN_H
+#define GRPPI_PIPELINE_PLAN_H
+
+#include <type_traits>
+#include <utility>
+
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/patterns.h"
+#include "grppi/common/pipeline_plan.h"
+
+namespace grppi {
+
+/**
+\addtogroup stream_patterns
+@{
+\defgroup pipeline_plan_pattern Pipeline plan pattern
+\brief Interface for applying the \ref md_pipeline repeatedly.
+@{
+*/
+
+/**
+\brief Build a \ref md_pipeline once, to be run on many data streams.
+\tparam Execution Execution type.
+\tparam Transformers Callable types for each stage.
+\param ex Execution policy object.
+\param transform_ops Stages of the pipeline.
+\return A grppi::pipeline_plan whose run() takes the stream generator.
+*/
+template <typename Execution, typename ... Transformers,
+          requires_execution_supported<std::decay_t<Execution>> = 0>
+auto make_pipeline_plan(
+    const Execution & ex,
+    Transformers && ... transform_ops)
+{
+  static_assert(supports_pipeline<std::decay_t<Execution>>(),
+      "pipeline pattern is not supported by execution type");
+  return pipeline_plan<std::decay_t<Execution>,
+      std::decay_t<Transformers>...>{ex,
+      std::forward<Transformers>(transform_ops)...};
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
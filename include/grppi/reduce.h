@@ -21,6 +21,8 @@
 #include "grppi/common/range_concept.h"
 #include "grppi/common/iterator_traits.h"
 #include "grppi/common/execution_traits.h"
+#include "grppi/common/lazy_view.h"
+#include "grppi/common/reduction.h"
 
 namespace grppi {
 
@@ -46,7 +48,8 @@ on a data sequence with sequential execution.
 \return The result of the reduction.
 */
 template <typename Execution, typename InRange, typename Result, typename Combiner,
-    meta::requires_<range_concept,InRange> = 0>
+    meta::requires_<range_concept,InRange> = 0,
+    requires_no_reduction_op<Result> = 0>
 auto reduce(const Execution & ex,
             InRange && rin,
             Result && identity,
@@ -76,7 +79,8 @@ on a data sequence with sequential execution.
 \return The result of the reduction.
 */
 template <typename Execution, typename InputIt, typename Result, typename Combiner,
-          requires_iterator<InputIt> = 0>
+          requires_iterator<InputIt> = 0,
+          requires_no_reduction_op<Result> = 0>
 auto reduce(const Execution & ex, 
             InputIt first, InputIt last, 
             Result && identity,
@@ -105,7 +109,8 @@ on a data sequence with sequential execution.
 \return The result of the reduction.
 */
 template <typename Execution, typename InputIt, typename Result, typename Combiner,
-    requires_iterator<InputIt> = 0>
+    requires_iterator<InputIt> = 0,
+    requires_no_reduction_op<Result> = 0>
 auto reduce(const Execution & ex,
             InputIt first, std::size_t size,
             Result && identity,
@@ -119,6 +124,85 @@ auto reduce(const Execution & ex,
                    std::forward<Result>(identity), std::forward<Combiner>(combine_op));
 }
 
+/**
+\brief Invoke \ref md_reduce with identity value
+on a lazy view, fusing all the stages of the view into the reduction.
+\tparam Execution Execution type.
+\tparam View Lazy view type for the input.
+\tparam Result Type for the identity value.
+\tparam Combiner Callable type for the combiner operation.
+\param ex Execution policy object.
+\param view Lazy view over the input sequences.
+\param identity Identity value for the combiner operation.
+\param combiner_op Combiner operation for the reduction.
+\return The result of the reduction.
+\note Elements discarded by filter stages in the view are not combined.
+*/
+template <typename Execution, typename View, typename Result, typename Combiner,
+    requires_lazy_view<View> = 0,
+    requires_no_reduction_op<Result> = 0>
+auto reduce(const Execution & ex,
+            View && view,
+            Result && identity,
+            Combiner && combine_op)
+{
+  static_assert(supports_map_reduce<Execution>(),
+                "reduce on lazy views requires map/reduce on execution type");
+  return ex.map_reduce(view.begin(), view.size(),
+                       std::forward<Result>(identity),
+                       view.transformer(),
+                       view.combiner(std::forward<Combiner>(combine_op)));
+}
+
+/**
+\brief Invoke \ref md_reduce with multiple reductions
+on a data sequence, computing all of them in a single pass.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Reductions Reduction types (see grppi::reduction()).
+\param ex Execution policy object.
+\param rin Input range.
+\param reduction_ops Reductions to be applied.
+\return A tuple with the result of every reduction.
+*/
+template <typename Execution, typename InRange, typename ... Reductions,
+    meta::requires_<range_concept,InRange> = 0,
+    requires_reduction_ops<Reductions...> = 0>
+auto reduce(const Execution & ex,
+            InRange && rin,
+            Reductions && ... reduction_ops)
+{
+  static_assert(supports_map_reduce<Execution>(),
+                "multiple reduce requires map/reduce on execution type");
+  return internal::multi_reduce(ex, rin.begin(), rin.size(),
+      std::make_tuple(std::forward<Reductions>(reduction_ops)...));
+}
+
+/**
+\brief Invoke \ref md_reduce with multiple reductions
+on a data sequence, computing all of them in a single pass.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Reductions Reduction types (see grppi::reduction()).
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param reduction_ops Reductions to be applied.
+\return A tuple with the result of every reduction.
+*/
+template <typename Execution, typename InputIt, typename ... Reductions,
+    requires_iterator<InputIt> = 0,
+    requires_reduction_ops<Reductions...> = 0>
+auto reduce(const Execution & ex,
+            InputIt first, InputIt last,
+            Reductions && ... reduction_ops)
+{
+  static_assert(supports_map_reduce<Execution>(),
+                "multiple reduce requires map/reduce on execution type");
+  return internal::multi_reduce(ex, first, std::distance(first,last),
+      std::make_tuple(std::forward<Reductions>(reduction_ops)...));
+}
+
 /**
 @}
 @}
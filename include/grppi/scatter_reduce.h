@@ -0,0 +1,177 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_SCATTER_REDUCE_H
+#define GRPPI_SCATTER_REDUCE_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "grppi/common/range_concept.h"
+#include "grppi/common/iterator_traits.h"
+#include "grppi/common/execution_traits.h"
+#include "grppi/common/scatter_reduction.h"
+
+namespace grppi {
+
+/**
+\addtogroup data_patterns
+@{
+\defgroup scatter_reduce_pattern Scatter/reduce pattern
+\brief Interface for applyinng the \ref md_scatter-reduce.
+@{
+*/
+
+/**
+\brief Invoke \ref md_scatter-reduce on a data sequence.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Identity Type for the identity value (and the bins).
+\tparam Indexer Callable type for the bin selection operation.
+\tparam Transformer Callable type for the transformation operation.
+\tparam Combiner Callable type for the combination operation.
+\param ex Execution policy object.
+\param rin Input range.
+\param num_bins Number of bins.
+\param identity Identity value for the combination operation.
+\param index_op Operation returning the bin index for an element.
+\param transform_op Transformation applied to every element.
+\param combine_op Combination operation.
+\return A vector with the result of every bin.
+\pre For every element `x` in the input `index_op(x) < num_bins`.
+*/
+template <typename Execution, typename InRange, typename Identity,
+    typename Indexer, typename Transformer, typename Combiner,
+    meta::requires_<range_concept,InRange> = 0>
+auto scatter_reduce(const Execution & ex,
+                    InRange && rin,
+                    std::size_t num_bins,
+                    Identity && identity,
+                    Indexer && index_op,
+                    Transformer && transform_op,
+                    Combiner && combine_op)
+{
+  static_assert(supports_map<Execution>(),
+                "scatter/reduce not supported on execution type");
+  return internal::scatter_reduce(ex, rin.begin(), rin.size(), num_bins,
+      std::forward<Identity>(identity), std::forward<Indexer>(index_op),
+      std::forward<Transformer>(transform_op),
+      std::forward<Combiner>(combine_op));
+}
+
+/**
+\brief Invoke \ref md_scatter-reduce on a data sequence.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Identity Type for the identity value (and the bins).
+\tparam Indexer Callable type for the bin selection operation.
+\tparam Transformer Callable type for the transformation operation.
+\tparam Combiner Callable type for the combination operation.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param num_bins Number of bins.
+\param identity Identity value for the combination operation.
+\param index_op Operation returning the bin index for an element.
+\param transform_op Transformation applied to every element.
+\param combine_op Combination operation.
+\return A vector with the result of every bin.
+\pre For every element `x` in the input `index_op(x) < num_bins`.
+*/
+template <typename Execution, typename InputIt, typename Identity,
+    typename Indexer, typename Transformer, typename Combiner,
+    requires_iterator<InputIt> = 0>
+auto scatter_reduce(const Execution & ex,
+                    InputIt first, InputIt last,
+                    std::size_t num_bins,
+                    Identity && identity,
+                    Indexer && index_op,
+                    Transformer && transform_op,
+                    Combiner && combine_op)
+{
+  static_assert(supports_map<Execution>(),
+                "scatter/reduce not supported on execution type");
+  return internal::scatter_reduce(ex, first, std::distance(first,last),
+      num_bins, std::forward<Identity>(identity),
+      std::forward<Indexer>(index_op),
+      std::forward<Transformer>(transform_op),
+      std::forward<Combiner>(combine_op));
+}
+
+/**
+\brief Invoke \ref md_scatter-reduce counting the elements falling in
+every bin.
+\tparam Execution Execution type.
+\tparam InRange Range type for the input range.
+\tparam Indexer Callable type for the bin selection operation.
+\param ex Execution policy object.
+\param rin Input range.
+\param num_bins Number of bins.
+\param index_op Operation returning the bin index for an element.
+\return A vector with the number of elements in every bin.
+\pre For every element `x` in the input `index_op(x) < num_bins`.
+*/
+template <typename Execution, typename InRange, typename Indexer,
+    meta::requires_<range_concept,InRange> = 0>
+auto histogram(const Execution & ex,
+               InRange && rin,
+               std::size_t num_bins,
+               Indexer && index_op)
+{
+  static_assert(supports_map<Execution>(),
+                "histogram not supported on execution type");
+  return internal::scatter_reduce(ex, rin.begin(), rin.size(), num_bins,
+      std::size_t{0}, std::forward<Indexer>(index_op),
+      [](const auto &) { return std::size_t{1}; },
+      std::plus<std::size_t>{});
+}
+
+/**
+\brief Invoke \ref md_scatter-reduce counting the elements falling in
+every bin.
+\tparam Execution Execution type.
+\tparam InputIt Iterator type used for input sequence.
+\tparam Indexer Callable type for the bin selection operation.
+\param ex Execution policy object.
+\param first Iterator to the first element in the input sequence.
+\param last Iterator to one past the end of the input sequence.
+\param num_bins Number of bins.
+\param index_op Operation returning the bin index for an element.
+\return A vector with the number of elements in every bin.
+\pre For every element `x` in the input `index_op(x) < num_bins`.
+*/
+template <typename Execution, typename InputIt, typename Indexer,
+    requires_iterator<InputIt> = 0>
+auto histogram(const Execution & ex,
+               InputIt first, InputIt last,
+               std::size_t num_bins,
+               Indexer && index_op)
+{
+  static_assert(supports_map<Execution>(),
+                "histogram not supported on execution type");
+  return internal::scatter_reduce(ex, first, std::distance(first,last),
+      num_bins, std::size_t{0}, std::forward<Indexer>(index_op),
+      [](const auto &) { return std::size_t{1}; },
+      std::plus<std::size_t>{});
+}
+
+/**
+@}
+@}
+*/
+}
+
+#endif
@@ -19,6 +19,8 @@
 #include "../common/mpmc_queue.h"
 #include "../common/iterator.h"
 #include "../common/callable_traits.h"
+#include "../common/accumulate.h"
+#include "../common/inplace_divide_conquer.h"
 #include "../common/execution_traits.h"
 #include "../common/patterns.h"
 #include "../common/pack_traits.h"
@@ -192,6 +194,27 @@ namespace grppi {
         Solver && solve_op,
         Combiner && combine_op) const;
 
+    /**
+    \brief Invoke \ref md_divide-conquer with problems solved in place.
+    \tparam Problem Type used for the problem (usually a lightweight view).
+    \tparam Divider Callable type for the divider operation.
+    \tparam Predicate Callable type for the stop condition predicate.
+    \tparam Solver Callable type for the solver operation.
+    \tparam Combiner Callable type for the combiner operation.
+    \param problem Problem to be solved.
+    \param divider_op Divider operation returning a std::array of subproblems.
+    \param predicate_op Predicate operation.
+    \param solver_op Solver operation.
+    \param combine_op Combiner operation.
+    */
+    template <typename Problem, typename Divider, typename Predicate,
+        typename Solver, typename Combiner>
+    auto inplace_divide_conquer(const Problem & problem,
+        Divider && divide_op,
+        Predicate && predicate_op,
+        Solver && solve_op,
+        Combiner && combine_op) const;
+
 
     /**
     \brief Invoke \ref md_pipeline.
@@ -235,6 +258,35 @@ namespace grppi {
     }
 
 
+    /**
+    \brief Invoke \ref md_pipeline on a single item of a stream.
+    Allows other execution policies to run a set of stages sequentially
+    within one of their own stages.
+    \tparam Item Type of the data item.
+    \tparam Transformers Types of the stages.
+    \param item Data item.
+    \param transform_ops Stages applied to the item. The last one is a
+    consumer.
+    */
+    template<typename Item, typename ... Transformers>
+    void pipeline_step(Item && item, Transformers && ... transform_ops) const
+    {
+      do_pipeline(std::forward<Item>(item),
+          std::forward<Transformers>(transform_ops)...);
+    }
+
+    /**
+    \brief Closes a set of stages at the end of a stream.
+    Results still held by the stages are sent to the following ones.
+    \tparam Transformers Types of the stages.
+    \param transform_ops Stages that were applied with pipeline_step().
+    */
+    template<typename ... Transformers>
+    void pipeline_flush(Transformers && ... transform_ops) const
+    {
+      end_pipeline(std::forward<Transformers>(transform_ops)...);
+    }
+
     /**
     \brief Invoke \ref md_stream_pool.
     \tparam Population Type for the initial population.
@@ -374,17 +426,7 @@ namespace grppi {
     template<typename Item, typename Transformer, typename Predicate,
         template<typename T, typename P> class Iteration,
         typename ...OtherTransformers,
-        requires_iteration<Iteration<Transformer, Predicate>> = 0,
-        requires_no_pattern<Transformer> = 0>
-    void do_pipeline(Item && item,
-        Iteration<Transformer, Predicate> && iteration_obj,
-        OtherTransformers && ... other_transform_ops) const;
-
-    template<typename Item, typename Transformer, typename Predicate,
-        template<typename T, typename P> class Iteration,
-        typename ...OtherTransformers,
-        requires_iteration<Iteration<Transformer, Predicate>> = 0,
-        requires_pipeline<Transformer> = 0>
+        requires_iteration<Iteration<Transformer, Predicate>> = 0>
     void do_pipeline(Item && item,
         Iteration<Transformer, Predicate> && iteration_obj,
         OtherTransformers && ... other_transform_ops) const;
@@ -412,6 +454,48 @@ namespace grppi {
         std::tuple<Transformers...> && transform_ops,
         std::index_sequence<I...>) const;
 
+    template<typename Item, typename TimeReduce,
+        typename ... OtherTransformers,
+        requires_time_reduce<TimeReduce> = 0>
+    void do_pipeline(Item && item, TimeReduce && reduce_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Item, typename Keyed,
+        typename ... OtherTransformers,
+        requires_keyed<Keyed> = 0>
+    void do_pipeline(Item && item, Keyed && keyed_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Item, typename FlatMap,
+        typename ... OtherTransformers,
+        requires_flat_map<FlatMap> = 0>
+    void do_pipeline(Item && item, FlatMap && flat_map_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Item, typename Batch,
+        typename ... OtherTransformers,
+        requires_batch<Batch> = 0>
+    void do_pipeline(Item && item, Batch && batch_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Item, typename Split,
+        typename ... OtherTransformers,
+        requires_split<Split> = 0>
+    void do_pipeline(Item && item, Split && split_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    template<typename Item, typename Join,
+        typename ... OtherTransformers,
+        requires_join<Join> = 0>
+    void do_pipeline(Item && item, Join && join_obj,
+        OtherTransformers && ... other_transform_ops) const;
+
+    void end_pipeline() const {}
+
+    template<typename Transformer, typename ... OtherTransformers>
+    void end_pipeline(Transformer && transform_op,
+        OtherTransformers && ... other_transform_ops) const;
+
   };
 
 /// Determine if a type is a sequential execution policy.
@@ -464,6 +548,15 @@ namespace grppi {
   constexpr bool
   supports_divide_conquer<sequential_execution>() { return true; }
 
+/**
+\brief Determines if an execution policy supports the in place divide/conquer
+pattern.
+\note Specialization for sequential_execution.
+*/
+  template<>
+  constexpr bool
+  supports_inplace_divide_conquer<sequential_execution>() { return true; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note Specialization for sequential_execution.
@@ -505,7 +598,7 @@ namespace grppi {
     const auto last = std::next(first, sequence_size);
     auto result{identity};
     while (first != last) {
-      result = combine_op(result, *first++);
+      internal::combine_into(combine_op, result, *first++);
     }
     return result;
   }
@@ -521,7 +614,7 @@ namespace grppi {
     const auto last = std::next(std::get<0>(firsts), sequence_size);
     auto result{identity};
     while (std::get<0>(firsts) != last) {
-      result = combine_op(result, apply_deref_increment(
+      internal::combine_into(combine_op, result, apply_deref_increment(
           std::forward<Transformer>(transform_op), firsts));
     }
     return result;
@@ -571,6 +664,22 @@ namespace grppi {
   }
 
 
+  template <typename Problem, typename Divider, typename Predicate,
+      typename Solver, typename Combiner>
+  auto sequential_execution::inplace_divide_conquer(
+      const Problem & problem,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const
+  {
+    auto fork = [](auto n, auto & task) {
+      for (std::size_t i = 0; i < n; ++i) { task(i); }
+    };
+    return internal::inplace_divide_conquer(problem, divide_op, predicate_op,
+        solve_op, combine_op, fork);
+  }
+
   template<typename Input, typename Divider, typename Solver, typename Combiner>
   auto sequential_execution::divide_conquer(
       Input && input,
@@ -610,6 +719,7 @@ namespace grppi {
       if (!x) { break; }
       do_pipeline(*x, std::forward<Transformers>(transform_ops)...);
     }
+    end_pipeline(std::forward<Transformers>(transform_ops)...);
   }
 
   template<typename Population, typename Selection, typename Evolution,
@@ -715,15 +825,14 @@ namespace grppi {
     if (reduce_obj.reduction_needed()) {
       auto red = reduce_obj.reduce_window(*this);
       do_pipeline(red,
-          std::forward<OtherTransformers...>(other_transform_ops)...);
+          std::forward<OtherTransformers>(other_transform_ops)...);
     }
   }
 
   template<typename Item, typename Transformer, typename Predicate,
       template<typename T, typename P> class Iteration,
       typename ... OtherTransformers,
-      requires_iteration<Iteration<Transformer, Predicate>>,
-      requires_no_pattern<Transformer>>
+      requires_iteration<Iteration<Transformer, Predicate>>>
   void sequential_execution::do_pipeline(
       Item && item,
       Iteration<Transformer, Predicate> && iteration_obj,
@@ -734,20 +843,7 @@ namespace grppi {
       new_item = iteration_obj.transform(new_item);
     }
     do_pipeline(new_item,
-        std::forward<OtherTransformers...>(other_transform_ops)...);
-  }
-
-  template<typename Item, typename Transformer, typename Predicate,
-      template<typename T, typename P> class Iteration,
-      typename ... OtherTransformers,
-      requires_iteration<Iteration<Transformer, Predicate>>,
-      requires_pipeline<Transformer>>
-  void sequential_execution::do_pipeline(
-      Item &&,
-      Iteration<Transformer, Predicate> &&,
-      OtherTransformers && ...) const
-  {
-    static_assert(!is_pipeline<Transformer>, "Not implemented");
+        std::forward<OtherTransformers>(other_transform_ops)...);
   }
 
   template<typename Item, typename ... Transformers,
@@ -767,6 +863,174 @@ namespace grppi {
             sizeof...(Transformers) + sizeof...(OtherTransformers)>());
   }
 
+  template<typename Item, typename TimeReduce,
+      typename ... OtherTransformers,
+      requires_time_reduce<TimeReduce>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      TimeReduce && reduce_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    reduce_obj.add_item(std::forward<Item>(item));
+    while (reduce_obj.reduction_needed()) {
+      auto red = reduce_obj.reduce_window(*this);
+      do_pipeline(red,
+          std::forward<OtherTransformers>(other_transform_ops)...);
+    }
+  }
+
+  template<typename Item, typename Keyed,
+      typename ... OtherTransformers,
+      requires_keyed<Keyed>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      Keyed && keyed_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    auto out = keyed_obj(keyed_obj.shard(item), item);
+    if (out) {
+      do_pipeline(*out,
+          std::forward<OtherTransformers>(other_transform_ops)...);
+    }
+  }
+
+  template<typename Item, typename FlatMap,
+      typename ... OtherTransformers,
+      requires_flat_map<FlatMap>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      FlatMap && flat_map_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    using output_type = typename std::decay_t<FlatMap>::output_type;
+    flat_map_obj(item, [&](output_type && out) {
+      do_pipeline(out,
+          std::forward<OtherTransformers>(other_transform_ops)...);
+    });
+  }
+
+  template<typename Item, typename Batch,
+      typename ... OtherTransformers,
+      requires_batch<Batch>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      Batch && batch_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    batch_obj.add_item(std::forward<Item>(item));
+    if (batch_obj.batch_ready()) {
+      do_pipeline(batch_obj.take_batch(),
+          std::forward<OtherTransformers>(other_transform_ops)...);
+    }
+  }
+
+  template<typename Item, typename Split,
+      typename ... OtherTransformers,
+      requires_split<Split>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      Split && split_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    auto merge = [&](auto && out) {
+      do_pipeline(std::forward<decltype(out)>(out),
+          std::forward<OtherTransformers>(other_transform_ops)...);
+    };
+    auto apply = [&](auto & branch) {
+      if constexpr (sizeof...(OtherTransformers) == 0) {
+        do_pipeline(item, branch);
+      }
+      else {
+        do_pipeline(item, branch, merge);
+      }
+    };
+    if constexpr (std::decay_t<Split>::is_broadcast) {
+      split_obj.for_each(apply);
+    }
+    else {
+      split_obj.apply_to(split_obj.route(item), apply);
+    }
+  }
+
+  template<typename Item, typename Join,
+      typename ... OtherTransformers,
+      requires_join<Join>>
+  void sequential_execution::do_pipeline(
+      Item && item,
+      Join && join_obj,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    static_assert(sizeof...(OtherTransformers) > 0,
+        "A join cannot be the last stage of a pipeline");
+    auto emit = [&](auto && out) {
+      if (out) {
+        do_pipeline(std::move(*out),
+            std::forward<OtherTransformers>(other_transform_ops)...);
+      }
+    };
+    do_pipeline(item, join_obj.left(), [&](auto && value) {
+      emit(join_obj.add_left(std::forward<decltype(value)>(value)));
+    });
+    do_pipeline(item, join_obj.right(), [&](auto && value) {
+      emit(join_obj.add_right(std::forward<decltype(value)>(value)));
+    });
+  }
+
+  template<typename Transformer, typename ... OtherTransformers>
+  void sequential_execution::end_pipeline(
+      Transformer && transform_op,
+      OtherTransformers && ... other_transform_ops) const
+  {
+    // Time windows still open at the end of the stream are closed and
+    // their results flow through the following stages.
+    if constexpr (is_time_reduce<Transformer>) {
+      transform_op.flush();
+      while (transform_op.reduction_needed()) {
+        auto red = transform_op.reduce_window(*this);
+        do_pipeline(red,
+            std::forward<OtherTransformers>(other_transform_ops)...);
+      }
+    }
+    // So is the last partial batch
+    else if constexpr (is_batch<Transformer>) {
+      if (!transform_op.empty()) {
+        do_pipeline(transform_op.take_batch(),
+            std::forward<OtherTransformers>(other_transform_ops)...);
+      }
+    }
+    // So are the stages of every branch
+    else if constexpr (is_split<Transformer>) {
+      auto merge = [&](auto && out) {
+        do_pipeline(std::forward<decltype(out)>(out),
+            std::forward<OtherTransformers>(other_transform_ops)...);
+      };
+      transform_op.for_each([&](auto & branch) {
+        if constexpr (sizeof...(OtherTransformers) == 0) {
+          end_pipeline(branch);
+        }
+        else {
+          end_pipeline(branch, merge);
+        }
+      });
+    }
+    else if constexpr (is_join<Transformer>) {
+      auto emit = [&](auto && out) {
+        if (out) {
+          do_pipeline(std::move(*out),
+              std::forward<OtherTransformers>(other_transform_ops)...);
+        }
+      };
+      end_pipeline(transform_op.left(), [&](auto && value) {
+        emit(transform_op.add_left(std::forward<decltype(value)>(value)));
+      });
+      end_pipeline(transform_op.right(), [&](auto && value) {
+        emit(transform_op.add_right(std::forward<decltype(value)>(value)));
+      });
+      transform_op.clear();
+    }
+    end_pipeline(std::forward<OtherTransformers>(other_transform_ops)...);
+  }
+
   template<typename Item, typename ... Transformers, std::size_t ... I>
   void sequential_execution::do_pipeline_nested(
       Item && item,
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_STREAM_GRAPH_H
+#define GRPPI_STREAM_GRAPH_H
+
+#include <type_traits>
+
+#include "grppi/common/patterns.h"
+
+namespace grppi {
+
+/**
+\addtogroup stream_patterns
+@{
+\defgroup stream_graph_pattern Stream graph patterns
+\brief Interface for applying the \ref md_stream-graph.
+@{
+*/
+
+/**
+\brief Invoke a split of a data stream
+that can be composed in other streaming patterns.
+Every item is sent to one branch and the outputs of the branches are
+merged in arrival order.
+\tparam Router Callable type selecting the branch of an item.
+\tparam Branches Types of the branches.
+\param router_op Operation returning either a boolean, selecting the first
+branch when true and the second when false, or the index of the branch.
+\param branches Streaming stages of every branch.
+*/
+template <typename Router, typename ... Branches>
+auto split(Router && router_op, Branches && ... branches)
+{
+  static_assert(sizeof...(Branches) > 1, "A split needs several branches");
+  return split_t<std::decay_t<Router>, std::decay_t<Branches>...>{
+      std::forward<Router>(router_op), std::forward<Branches>(branches)...};
+}
+
+/**
+\brief Router for a split sending items to its branches in turn.
+*/
+inline auto round_robin()
+{
+  return round_robin_t{};
+}
+
+/**
+\brief Invoke a broadcast of a data stream
+that can be composed in other streaming patterns.
+Every item is sent to all the branches and their outputs are merged in
+arrival order.
+\tparam Branches Types of the branches.
+\param branches Streaming stages of every branch.
+*/
+template <typename ... Branches>
+auto broadcast(Branches && ... branches)
+{
+  static_assert(sizeof...(Branches) > 1,
+      "A broadcast needs several branches");
+  return split_t<internal::broadcast_router, std::decay_t<Branches>...>{
+      internal::broadcast_router{}, std::forward<Branches>(branches)...};
+}
+
+/**
+\brief Invoke a zip of two branches of a data stream
+that can be composed in other streaming patterns.
+Every item is sent to both branches and their outputs are paired by
+position.
+\tparam Left Type of the first branch.
+\tparam Right Type of the second branch.
+\param left Streaming stage of the first branch.
+\param right Streaming stage of the second branch.
+*/
+template <typename Left, typename Right>
+auto zip(Left && left, Right && right)
+{
+  return join_t<internal::sequence_key, std::decay_t<Left>,
+      std::decay_t<Right>>{internal::sequence_key{},
+      std::forward<Left>(left), std::forward<Right>(right)};
+}
+
+/**
+\brief Invoke a join by key of two branches of a data stream
+that can be composed in other streaming patterns.
+Every item is sent to both branches and their outputs with the same key
+are paired in arrival order.
+\tparam Key Callable type returning the key of an output.
+\tparam Left Type of the first branch.
+\tparam Right Type of the second branch.
+\param key_op Key extractor for the outputs of both branches.
+\param left Streaming stage of the first branch.
+\param right Streaming stage of the second branch.
+*/
+template <typename Key, typename Left, typename Right>
+auto join(Key && key_op, Left && left, Right && right)
+{
+  return join_t<std::decay_t<Key>, std::decay_t<Left>, std::decay_t<Right>>{
+      std::forward<Key>(key_op),
+      std::forward<Left>(left), std::forward<Right>(right)};
+}
+
+/**
+@}
+@}
+*/
+
+}
+
+#endif
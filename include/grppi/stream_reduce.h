@@ -52,6 +52,100 @@ auto reduce(int window_size, int offset,
        std::forward<Combiner>(combine_op));
 }
 
+/**
+\brief Invoke \ref md_stream-reduce on a stream with an invertible 
+combination.
+Items leaving a window are removed from the reduction with the inverse
+combination, so that every item is combined and removed once, whatever the
+window size.
+\tparam Identity Type of the identity value used by the combiner.
+\tparam Combiner Callable type used for data items combination.
+\tparam Inverse Callable type used for removing a data item.
+\param window_size Number of consecutive items to be reduced.
+\param offset Number of items after of which a new reduction is started.
+\param identity Identity value for the combination.
+\param combine_op Combination operation.
+\param inverse_op Inverse combination operation, such that
+`inverse_op(combine_op(x,y),y)` is equal to `x`.
+*/
+template <typename Identity, typename Combiner, typename Inverse>
+auto reduce(int window_size, int offset, 
+                   Identity identity, 
+                   Combiner && combine_op,
+                   Inverse && inverse_op)
+{
+  using combiner_type = invertible_combiner<std::decay_t<Combiner>,
+      std::decay_t<Inverse>>;
+  return reduce_t<combiner_type,Identity>(
+       window_size, offset, identity, 
+       combiner_type{std::forward<Combiner>(combine_op), 
+           std::forward<Inverse>(inverse_op)});
+}
+
+/**
+\brief Invoke \ref md_stream-reduce on a stream over windows of event time
+that can be composed in other streaming patterns.
+Windows are emitted as soon as the watermark, the highest timestamp seen
+minus the allowed lateness, passes their end. Remaining windows are emitted
+at the end of the stream.
+\tparam Duration Duration type for window size, slide and lateness.
+\tparam Identity Type of the identity value used by the combiner.
+\tparam Combiner Callable type used for data items combination.
+\tparam Timestamp Callable type used for extracting timestamps.
+\param window Duration of every window.
+\param slide Time between consecutive window starts. Windows are tumbling when
+equal to the window size and sliding when smaller.
+\param lateness Time that items may arrive behind the highest timestamp seen.
+\param identity Identity value for the combination.
+\param combine_op Combination operation.
+\param timestamp_op Operation returning the timestamp of a data item, either as
+a `std::chrono::time_point` or as a `std::chrono::duration` since an epoch.
+*/
+template <typename Duration, typename Identity, typename Combiner,
+          typename Timestamp>
+auto time_reduce(Duration window, Duration slide, Duration lateness,
+                 Identity identity, 
+                 Combiner && combine_op,
+                 Timestamp && timestamp_op)
+{
+  return time_reduce_t<std::decay_t<Combiner>,Identity,
+      std::decay_t<Timestamp>,Duration>(
+       window, slide, lateness, identity, 
+       std::forward<Combiner>(combine_op),
+       std::forward<Timestamp>(timestamp_op));
+}
+
+/**
+\brief Invoke \ref md_stream-reduce on a stream partitioned by key,
+that can be composed in other streaming patterns.
+Windows are formed by the items of each key. Keys are distributed among a
+number of replicas, so that windows of different keys are reduced in
+parallel.
+\tparam KeyExtractor Callable type for the key extraction operation.
+\tparam Identity Type of the identity value used by the combiner.
+\tparam Combiner Callable type used for data items combination.
+\param ntasks Number of replicas.
+\param key_op Operation returning the key of an item. Keys must be hashable.
+\param window_size Number of consecutive items of a key to be reduced.
+\param offset Number of items of a key after of which a new reduction is
+started.
+\param identity Identity value for the combination.
+\param combine_op Combination operation.
+*/
+template <typename KeyExtractor, typename Identity, typename Combiner>
+auto keyed_reduce(int ntasks, KeyExtractor && key_op,
+                  int window_size, int offset,
+                  Identity identity,
+                  Combiner && combine_op)
+{
+  using combiner_type = std::decay_t<Combiner>;
+  using reducer_type = reduce_t<combiner_type,Identity>;
+  return keyed_t<std::decay_t<KeyExtractor>,reducer_type>{
+      ntasks, std::forward<KeyExtractor>(key_op),
+      reducer_type{window_size, offset, identity,
+          combiner_type{std::forward<Combiner>(combine_op)}}};
+}
+
 /**
 @}
 @}
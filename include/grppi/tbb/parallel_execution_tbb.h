@@ -21,6 +21,10 @@
 #include "../common/optional.h"
 #include "../common/mpmc_queue.h"
 #include "../common/iterator.h"
+#include "../common/accumulate.h"
+#include "../common/inplace_divide_conquer.h"
+#include "../common/memoized_divide_conquer.h"
+#include "../common/optional.h"
 #include "../common/patterns.h"
 #include "../common/farm_pattern.h"
 #include "../common/execution_traits.h"
@@ -29,6 +33,10 @@
 #include "../seq/sequential_execution.h"
 #include "../native/parallel_execution_native.h"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 #include <tuple>
 
@@ -36,6 +44,81 @@
 
 namespace grppi {
 
+namespace internal {
+
+/**
+\brief Memoization table with in-flight deduplication for TBB.
+The first task looking for a key computes its result. Any other task looking
+for the same key joins that computation instead of blocking, so that waiting
+tasks never deadlock the TBB scheduler.
+*/
+template <typename Key, typename Result>
+class tbb_memo {
+public:
+
+  explicit tbb_memo(std::size_t min_shards) : entries_{min_shards} {}
+
+  /**
+  \brief Get the result for a key, computing it if needed.
+  \param key Key of the problem.
+  \param compute_op Callable object computing the result.
+  */
+  template <typename Compute>
+  Result get_or_compute(const Key & key, Compute && compute_op)
+  {
+    auto & e = entries_.find_or_insert(key).first;
+    tbb::collaborative_call_once(e.flag, [&]() { e.value = compute_op(); });
+    return *e.value;
+  }
+
+  /// Get the number of memoized problems.
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  struct entry {
+    tbb::collaborative_once_flag flag;
+    grppi::optional<Result> value;
+  };
+
+  sharded_map<Key, entry> entries_;
+};
+
+/**
+\brief Body for tbb::parallel_reduce accumulating in place.
+Every subrange is combined into the accumulator of its body and split
+bodies are joined moving their accumulators.
+*/
+template <typename Result, typename Combiner>
+struct tbb_reduce_body {
+  tbb_reduce_body(const Result & identity, const Combiner & combine_op) :
+    value{identity}, identity_{identity}, combine_op_{combine_op}
+  {}
+
+  tbb_reduce_body(tbb_reduce_body & other, tbb::split) :
+    value{other.identity_}, identity_{other.identity_},
+    combine_op_{other.combine_op_}
+  {}
+
+  template <typename Range>
+  void operator()(const Range & range) {
+    for (auto it = range.begin(); it != range.end(); ++it) {
+      combine_into(combine_op_, value, *it);
+    }
+  }
+
+  void join(tbb_reduce_body & rhs) {
+    combine_partial(combine_op_, value, rhs.value);
+  }
+
+  Result value;
+
+private:
+  const Result & identity_;
+  const Combiner & combine_op_;
+};
+
+}
+
 /** 
  \brief TBB parallel execution policy.
 
@@ -244,6 +327,51 @@ namespace grppi {
         Solver && solve_op,
         Combiner && combine_op) const;
 
+    /**
+    \brief Invoke \ref md_divide-conquer with problems solved in place.
+    \tparam Problem Type used for the problem (usually a lightweight view).
+    \tparam Divider Callable type for the divider operation.
+    \tparam Predicate Callable type for the stop condition predicate.
+    \tparam Solver Callable type for the solver operation.
+    \tparam Combiner Callable type for the combiner operation.
+    \param problem Problem to be solved.
+    \param divider_op Divider operation returning a std::array of subproblems.
+    \param predicate_op Predicate operation.
+    \param solver_op Solver operation.
+    \param combine_op Combiner operation.
+    */
+    template <typename Problem, typename Divider, typename Predicate,
+        typename Solver, typename Combiner>
+    auto inplace_divide_conquer(const Problem & problem,
+        Divider && divide_op,
+        Predicate && predicate_op,
+        Solver && solve_op,
+        Combiner && combine_op) const;
+
+    /**
+    \brief Invoke \ref md_divide-conquer memoizing the result of every problem.
+    \tparam Input Type used for the input problem.
+    \tparam KeyExtractor Callable type for the key extractor operation.
+    \tparam Divider Callable type for the divider operation.
+    \tparam Predicate Callable type for the stop condition predicate.
+    \tparam Solver Callable type for the solver operation.
+    \tparam Combiner Callable type for the combiner operation.
+    \param input Input problem to be solved.
+    \param key_op Key extractor operation.
+    \param divider_op Divider operation.
+    \param predicate_op Predicate operation.
+    \param solver_op Solver operation.
+    \param combine_op Combiner operation.
+    */
+    template <typename Input, typename KeyExtractor, typename Divider, 
+        typename Predicate, typename Solver, typename Combiner>
+    auto memoized_divide_conquer(const Input & input,
+        KeyExtractor && key_op,
+        Divider && divide_op,
+        Predicate && predicate_op,
+        Solver && solve_op,
+        Combiner && combine_op) const;
+
     /**
     \brief Invoke \ref md_pipeline.
     \tparam Generator Callable type for the generator operation.
@@ -463,8 +591,7 @@ namespace grppi {
     template<typename Input, typename Transformer, typename Predicate,
         template<typename T, typename P> class Iteration,
         typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_no_pattern <Transformer> = 0>
+        requires_iteration <Iteration<Transformer, Predicate>> = 0>
     auto make_filter(Iteration<Transformer, Predicate> & iteration_obj,
         OtherTransformers && ... other_transform_ops) const
     {
@@ -475,16 +602,7 @@ namespace grppi {
     template<typename Input, typename Transformer, typename Predicate,
         template<typename T, typename P> class Iteration,
         typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_no_pattern <Transformer> = 0>
-    auto make_filter(Iteration<Transformer, Predicate> && iteration_obj,
-        OtherTransformers && ... other_transform_ops) const;
-
-    template<typename Input, typename Transformer, typename Predicate,
-        template<typename T, typename P> class Iteration,
-        typename ... OtherTransformers,
-        requires_iteration <Iteration<Transformer, Predicate>> = 0,
-        requires_pipeline <Transformer> = 0>
+        requires_iteration <Iteration<Transformer, Predicate>> = 0>
     auto make_filter(Iteration<Transformer, Predicate> && iteration_obj,
         OtherTransformers && ... other_transform_ops) const;
 
@@ -583,6 +701,24 @@ namespace grppi {
   constexpr bool
   supports_divide_conquer<parallel_execution_tbb>() { return true; }
 
+/**
+\brief Determines if an execution policy supports the in place divide/conquer
+pattern.
+\note Specialization for parallel_execution_tbb when GRPPI_TBB is enabled.
+*/
+  template<>
+  constexpr bool
+  supports_inplace_divide_conquer<parallel_execution_tbb>() { return true; }
+
+/**
+\brief Determines if an execution policy supports the memoized divide/conquer
+pattern.
+\note Specialization for parallel_execution_tbb when GRPPI_TBB is enabled.
+*/
+  template<>
+  constexpr bool
+  supports_memoized_divide_conquer<parallel_execution_tbb>() { return true; }
+
 /**
 \brief Determines if an execution policy supports the pipeline pattern.
 \note Specialization for parallel_execution_omp when GRPPI_TBB is enabled.
@@ -621,15 +757,14 @@ namespace grppi {
       Identity && identity,
       Combiner && combine_op) const
   {
-    constexpr sequential_execution seq;
-    return tbb::parallel_reduce(
+    using result_type = std::decay_t<Identity>;
+    internal::tbb_reduce_body<result_type, std::decay_t<Combiner>>
+        body{identity, combine_op};
+    tbb::parallel_reduce(
         tbb::blocked_range<InputIterator>(first,
             std::next(first, sequence_size)),
-        identity,
-        [combine_op, seq](const auto & range, auto value) {
-          return seq.reduce(range.begin(), range.size(), value, combine_op);
-        },
-        combine_op);
+        body);
+    return std::move(body.value);
   }
 
   template<typename ... InputIterators, typename Identity,
@@ -670,9 +805,8 @@ namespace grppi {
 
     g.wait();
 
-    return seq.reduce(partial_results.begin(),
-        partial_results.size(), std::forward<Identity>(identity),
-        std::forward<Combiner>(combine_op));
+    return internal::combine_partials(std::next(partial_results.begin()),
+        partial_results.end(), std::move(partial_results[0]), combine_op);
   }
 
   template<typename ... InputIterators, typename OutputIterator,
@@ -722,6 +856,53 @@ namespace grppi {
         std::forward<Combiner>(combine_op), num_threads);
   }
 
+  template <typename Problem, typename Divider, typename Predicate,
+      typename Solver, typename Combiner>
+  auto parallel_execution_tbb::inplace_divide_conquer(
+      const Problem & problem,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const
+  {
+    auto fork = [](auto n, auto & task) {
+      tbb::task_group g;
+      for (std::size_t i = 1; i < n; ++i) {
+        g.run([&task, i]() { task(i); });
+      }
+      task(0);
+      g.wait();
+    };
+    return internal::inplace_divide_conquer(problem, divide_op, predicate_op,
+        solve_op, combine_op, fork);
+  }
+
+  template <typename Input, typename KeyExtractor, typename Divider, 
+      typename Predicate, typename Solver, typename Combiner>
+  auto parallel_execution_tbb::memoized_divide_conquer(
+      const Input & input,
+      KeyExtractor && key_op,
+      Divider && divide_op,
+      Predicate && predicate_op,
+      Solver && solve_op,
+      Combiner && combine_op) const
+  {
+    using key_type = std::decay_t<decltype(key_op(input))>;
+    using result_type = std::decay_t<decltype(solve_op(input))>;
+    internal::tbb_memo<key_type, result_type> memo{
+        4 * static_cast<std::size_t>(concurrency_degree_)};
+    auto fork = [](std::size_t n, auto && task) {
+      tbb::task_group g;
+      for (std::size_t i = 1; i < n; ++i) {
+        g.run([&task, i]() { task(i); });
+      }
+      if (n > 0) { task(0); }
+      g.wait();
+    };
+    return internal::memoized_divide_conquer(input, key_op, divide_op,
+        predicate_op, solve_op, combine_op, memo, fork);
+  }
+
   template<typename Input, typename Divider, typename Predicate, typename Solver, typename Combiner>
   auto parallel_execution_tbb::divide_conquer(
       Input && input,
@@ -807,7 +988,7 @@ namespace grppi {
         int cardinality, F && f,
         std::index_sequence<N...>)
     {
-      std::tuple pipe{make_node(g, cardinality, std::get<N>(f)) ...};
+      auto pipe = std::make_tuple(make_node(g, cardinality, std::get<N>(f)) ...);
       return pipe;
     }
 
@@ -840,7 +1021,7 @@ namespace grppi {
         P && pred)
     {
       using namespace oneapi::tbb::flow;
-      using input_type = typename P::input_type;
+      using input_type = std::decay_t<typename std::decay_t<P>::input_type>;
       using node_type = multifunction_node<input_type, std::tuple<input_type>>;
       using ports_type = typename node_type::output_ports_type;
       auto node = std::make_unique<node_type>(g, cardinality,
@@ -867,7 +1048,7 @@ namespace grppi {
         R && red)
     {
       using namespace oneapi::tbb::flow;
-      using input_type = typename R::input_type;
+      using input_type = typename std::decay_t<R>::input_type;
       using node_type = multifunction_node<input_type, std::tuple<input_type>>;
       using ports_type = typename node_type::output_ports_type;
 
@@ -882,18 +1063,163 @@ namespace grppi {
       return node;
     }
 
+    template<typename R,
+        requires_time_reduce<R> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int cardinality,
+        R && red)
+    {
+      using namespace oneapi::tbb::flow;
+      using input_type = typename std::decay_t<R>::input_type;
+      using node_type = multifunction_node<input_type, std::tuple<input_type>>;
+      using ports_type = typename node_type::output_ports_type;
+
+      auto node = std::make_unique<node_type>(g, cardinality,
+          [&](const input_type & item, ports_type & ports) {
+        red.add_item(item);
+        constexpr sequential_execution seq;
+        while (red.reduction_needed()) {
+          std::get<0>(ports).try_put(red.reduce_window(seq));
+        }
+      });
+      return node;
+    }
+
+    template<typename K,
+        requires_keyed<K> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        K && keyed)
+    {
+      using namespace oneapi::tbb::flow;
+      using input_type = typename std::decay_t<K>::input_type;
+      using output_type = typename std::decay_t<K>::output_type;
+      using node_type = multifunction_node<input_type, std::tuple<output_type>>;
+      using ports_type = typename node_type::output_ports_type;
+
+      // Keys are processed by a serial node, going through every shard
+      auto node = std::make_unique<node_type>(g, serial,
+          [&](const input_type & item, ports_type & ports) {
+        auto out = keyed(keyed.shard(item), item);
+        if (out) { std::get<0>(ports).try_put(*out); }
+      });
+      return node;
+    }
+
+    template<typename F,
+        requires_flat_map<F> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        F && flat_map_obj)
+    {
+      using namespace oneapi::tbb::flow;
+      using input_type = typename std::decay_t<F>::input_type;
+      using output_type = typename std::decay_t<F>::output_type;
+      using node_type = multifunction_node<input_type, std::tuple<output_type>>;
+      using ports_type = typename node_type::output_ports_type;
+
+      auto node = std::make_unique<node_type>(g, serial,
+          [&](const input_type & item, ports_type & ports) {
+        flat_map_obj(item, [&](output_type && out) {
+          std::get<0>(ports).try_put(out);
+        });
+      });
+      return node;
+    }
+
+    /**
+    \brief Batching node with a timer thread.
+    Batches are emitted by the node body when they are full, and by the
+    timer thread when their timeout expires. Both emit under the node lock.
+    The timer thread is only started if the batch has a timeout.
+    */
+    template<typename B>
+    class batch_node : public oneapi::tbb::flow::multifunction_node<
+        typename B::input_type, std::tuple<typename B::output_type>>
+    {
+    public:
+      using input_type = typename B::input_type;
+      using output_type = typename B::output_type;
+      using base_type = oneapi::tbb::flow::multifunction_node<input_type,
+          std::tuple<output_type>>;
+      using ports_type = typename base_type::output_ports_type;
+
+      batch_node(oneapi::tbb::flow::graph & g, B & batch_obj) :
+        base_type{g, oneapi::tbb::flow::serial,
+            [this](const input_type & item, ports_type &) { add(item); }},
+        batch_{batch_obj}
+      {
+        if (batch_.timeout() > B::clock_type::duration::zero()) {
+          timer_ = std::thread{[this]() { run_timer(); }};
+        }
+      }
+
+      ~batch_node() { stop_timer(); }
+
+      /**
+      \brief Stops the timer thread.
+      \post No batch is emitted by the timer thread.
+      */
+      void stop_timer() {
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          done_ = true;
+        }
+        wakeup_.notify_one();
+        if (timer_.joinable()) { timer_.join(); }
+      }
+
+    private:
+      void add(const input_type & item) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const bool started = batch_.empty();
+        batch_.add_item(item);
+        if (batch_.full()) { emit(); }
+        else if (started) { wakeup_.notify_one(); }
+      }
+
+      void run_timer() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!done_) {
+          if (batch_.empty()) { wakeup_.wait(lock); }
+          else if (batch_.batch_ready()) { emit(); }
+          else { wakeup_.wait_until(lock, batch_.deadline()); }
+        }
+      }
+
+      void emit() {
+        std::get<0>(this->output_ports()).try_put(batch_.take_batch());
+      }
+
+    private:
+      B & batch_;
+      std::mutex mutex_{};
+      std::condition_variable wakeup_{};
+      bool done_ = false;
+      std::thread timer_{};
+    };
+
+    template<typename B,
+        requires_batch<B> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        B && batch_obj)
+    {
+      return std::make_unique<batch_node<std::decay_t<B>>>(g, batch_obj);
+    }
+
     template<typename I,
         requires_iteration<I> = 0>
     decltype(auto) make_node(oneapi::tbb::flow::graph & g,
-        int cardinality,
+        [[maybe_unused]] int cardinality,
         I && iter)
     {
       using namespace oneapi::tbb::flow;
-      using input_type = typename I::input_type;
-      using output_type = typename I::output_type;
+      using input_type = typename std::decay_t<I>::input_type;
+      using output_type = typename std::decay_t<I>::output_type;
       using node_type = function_node<input_type, output_type>;
 
-      auto node = std::make_unique<node_type>(g, cardinality,
+      auto node = std::make_unique<node_type>(g, iter.cardinality(),
           [&](const input_type & item) {
             auto x = item;
             do {
@@ -905,12 +1231,205 @@ namespace grppi {
 
     }
 
+    // Branches may contain other splits or joins
+    template<typename S,
+        requires_split<S> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        S && split_obj);
+
+    template<typename J,
+        requires_join<J> = 0>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        J && join_obj);
+
+    template<std::size_t, typename T>
+    using port_type = T;
+
+    template<typename S, std::size_t ... I>
+    auto make_router(oneapi::tbb::flow::graph & g, S & split_obj,
+        std::index_sequence<I...>)
+    {
+      using namespace oneapi::tbb::flow;
+      using input_type = internal::stage_input_t<S>;
+      using node_type = multifunction_node<input_type,
+          std::tuple<port_type<I,input_type>...>>;
+      using ports_type = typename node_type::output_ports_type;
+
+      // Items are routed by a serial node, as routers may keep state
+      return std::make_unique<node_type>(g, serial,
+          [&split_obj](const input_type & item, ports_type & ports) {
+        if constexpr (std::decay_t<S>::is_broadcast) {
+          (std::get<I>(ports).try_put(item), ...);
+        }
+        else {
+          const auto i = split_obj.route(item);
+          ((i == I ? (std::get<I>(ports).try_put(item), 0) : 0), ...);
+        }
+      });
+    }
+
+    template<typename R, typename B, std::size_t ... I>
+    void link_branches(R & router, B & branches, std::index_sequence<I...>)
+    {
+      (oneapi::tbb::flow::make_edge(oneapi::tbb::flow::output_port<I>(router),
+          *get_first(std::get<I>(branches))), ...);
+    }
+
+    template<typename B, typename M, std::size_t ... I>
+    void merge_branches(B & branches, M & merge, std::index_sequence<I...>)
+    {
+      (oneapi::tbb::flow::make_edge(*get_last(std::get<I>(branches)), merge),
+          ...);
+    }
+
+    template<typename S,
+        requires_split<S>>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        S && split_obj)
+    {
+      using namespace oneapi::tbb::flow;
+      using split_type = std::decay_t<S>;
+      using input_type = internal::stage_input_t<split_type>;
+      using output_type =
+          typename split_type::template output_type<input_type>;
+      constexpr auto indices = std::make_index_sequence<split_type::size()>{};
+
+      auto router = make_router(g, split_obj, indices);
+      auto branches = std::apply([&](auto & ... branch) {
+        return std::make_tuple(make_node(g, 1, branch)...);
+      }, split_obj.branches());
+      link_branches(*router, branches, indices);
+      if constexpr (std::is_void_v<output_type>) {
+        return std::make_tuple(std::move(router), std::move(branches));
+      }
+      else {
+        // Outputs of the branches are merged as they arrive
+        auto merge = std::make_unique<broadcast_node<output_type>>(g);
+        merge_branches(branches, *merge, indices);
+        return std::make_tuple(std::move(router), std::move(branches),
+            std::move(merge));
+      }
+    }
+
+    template<typename J,
+        requires_join<J>>
+    decltype(auto) make_node(oneapi::tbb::flow::graph & g,
+        int,
+        J && join_obj)
+    {
+      using namespace oneapi::tbb::flow;
+      using join_type = std::decay_t<J>;
+      using input_type = typename join_type::input_type;
+      using left_type = typename join_type::left_type;
+      using right_type = typename join_type::right_type;
+      using output_type = typename join_type::output_type;
+      using router_type = multifunction_node<input_type,
+          std::tuple<input_type,input_type>>;
+      using left_node_type = multifunction_node<left_type,
+          std::tuple<output_type>>;
+      using right_node_type = multifunction_node<right_type,
+          std::tuple<output_type>>;
+
+      auto router = std::make_unique<router_type>(g, serial,
+          [](const input_type & item,
+              typename router_type::output_ports_type & ports) {
+        std::get<0>(ports).try_put(item);
+        std::get<1>(ports).try_put(item);
+      });
+      auto branches = std::make_tuple(make_node(g, 1, join_obj.left()),
+          make_node(g, 1, join_obj.right()));
+      link_branches(*router, branches, std::make_index_sequence<2>{});
+
+      // Outputs are paired in arrival order by one node for every branch
+      auto join_mutex = std::make_shared<std::mutex>();
+      auto left = std::make_unique<left_node_type>(g, serial,
+          [&join_obj,join_mutex](const left_type & item,
+              typename left_node_type::output_ports_type & ports) {
+        std::lock_guard<std::mutex> lock{*join_mutex};
+        auto out = join_obj.add_left(item);
+        if (out) { std::get<0>(ports).try_put(*out); }
+      });
+      auto right = std::make_unique<right_node_type>(g, serial,
+          [&join_obj,join_mutex](const right_type & item,
+              typename right_node_type::output_ports_type & ports) {
+        std::lock_guard<std::mutex> lock{*join_mutex};
+        auto out = join_obj.add_right(item);
+        if (out) { std::get<0>(ports).try_put(*out); }
+      });
+      make_edge(*get_last(std::get<0>(branches)), *left);
+      make_edge(*get_last(std::get<1>(branches)), *right);
+
+      auto merge = std::make_unique<broadcast_node<output_type>>(g);
+      make_edge(*left, *merge);
+      make_edge(*right, *merge);
+      return std::make_tuple(std::move(router), std::move(branches),
+          std::make_tuple(std::move(left), std::move(right)),
+          std::move(merge));
+    }
+
+    template<typename S, typename N, std::size_t ... I>
+    void end_pipeline(oneapi::tbb::flow::graph & g,
+        S && stages, N && nodes,
+        std::index_sequence<I...>);
+
+    /**
+    \brief Closes the time windows or the last batch of a stage at the end
+    of the stream.
+    Results are sent to the node successors and the graph is waited for, so
+    that stages are closed in order.
+    */
+    template<typename S, typename N>
+    void end_stage(oneapi::tbb::flow::graph & g, S && stage, N && node)
+    {
+      if constexpr (is_time_reduce<S>) {
+        stage.flush();
+        constexpr sequential_execution seq;
+        while (stage.reduction_needed()) {
+          std::get<0>(node->output_ports()).try_put(stage.reduce_window(seq));
+        }
+        g.wait_for_all();
+      }
+      else if constexpr (is_batch<S>) {
+        node->stop_timer();
+        if (!stage.empty()) {
+          std::get<0>(node->output_ports()).try_put(stage.take_batch());
+        }
+        g.wait_for_all();
+      }
+      else if constexpr (is_pipeline<S>) {
+        constexpr std::size_t pipe_size = std::decay_t<S>::size();
+        end_pipeline(g, std::move(stage).transformers(), node,
+            std::make_index_sequence<pipe_size>{});
+      }
+      else if constexpr (is_split<S>) {
+        end_pipeline(g, stage.branches(), std::get<1>(node),
+            std::make_index_sequence<std::decay_t<S>::size()>{});
+      }
+      else if constexpr (is_join<S>) {
+        end_stage(g, stage.left(), std::get<0>(std::get<1>(node)));
+        end_stage(g, stage.right(), std::get<1>(std::get<1>(node)));
+        stage.clear();
+      }
+    }
+
+    template<typename S, typename N, std::size_t ... I>
+    void end_pipeline(oneapi::tbb::flow::graph & g,
+        S && stages, N && nodes,
+        std::index_sequence<I...>)
+    {
+      (end_stage(g, std::get<I>(stages), std::get<I>(nodes)), ...);
+    }
+
     template<typename I, typename T, std::size_t ... N>
     auto pipeline_impl(oneapi::tbb::flow::graph & g,
         T && t,
         std::index_sequence<N...> seq)
     {
-      auto r = std::tuple{make_node(g, 1, std::get<N>(std::forward<T>(t))) ...};
+      auto r = std::make_tuple(
+          make_node(g, 1, std::get<N>(std::forward<T>(t))) ...);
       if constexpr (sizeof...(N) > 1) {
         link_pipe_stages<1, seq.size()>(r);
       }
@@ -933,14 +1452,20 @@ namespace grppi {
         std::make_unique<oneapi::tbb::flow::input_node<gen_value_type>>(
             *pipe_graph, [&](oneapi::tbb::flow_control & fc) {
               auto r = generate_op();
-              if (!r) { fc.stop(); }
+              if (!r) {
+                fc.stop();
+                return gen_value_type{};
+              }
               return *r;
             }
         );
 
+    // Stage objects must outlive the graph, as nodes may refer to them.
+    // Only plain callables are moved from into their nodes.
+    auto stages = std::tuple{std::forward<Transformers>(transform_ops)...};
     auto p = detail::pipeline_impl<gen_value_type>(
         *pipe_graph,
-        std::tuple{std::forward<Transformers>(transform_ops)...},
+        std::move(stages),
         std::make_index_sequence<sizeof...(Transformers)>{});
 
     oneapi::tbb::flow::make_edge(*first, *detail::get_first(p));
@@ -948,6 +1473,8 @@ namespace grppi {
     first->activate();
 
     pipe_graph->wait_for_all();
+    detail::end_pipeline(*pipe_graph, stages, p,
+        std::make_index_sequence<sizeof...(Transformers)>{});
   }
 
   template<typename Population, typename Selection, typename Evolution,
@@ -1331,8 +1858,7 @@ auto parallel_execution_tbb::make_filter(
 template <typename Input, typename Transformer, typename Predicate,
           template <typename T, typename P> class Iteration,
           typename ... OtherTransformers,
-          requires_iteration<Iteration<Transformer,Predicate>>,
-          requires_no_pattern<Transformer>>
+          requires_iteration<Iteration<Transformer,Predicate>>>
 auto parallel_execution_tbb::make_filter(
     Iteration<Transformer,Predicate> && iteration_obj,
     OtherTransformers && ... other_transform_ops) const
@@ -1356,18 +1882,6 @@ auto parallel_execution_tbb::make_filter(
           std::forward<OtherTransformers>(other_transform_ops)...);
 }
 
-template <typename Input, typename Transformer, typename Predicate,
-          template <typename T, typename P> class Iteration,
-          typename ... OtherTransformers,
-          requires_iteration<Iteration<Transformer,Predicate>>,
-          requires_pipeline<Transformer>>
-auto parallel_execution_tbb::make_filter(
-    Iteration<Transformer,Predicate> &&,
-    OtherTransformers && ...) const
-{
-  static_assert(!is_pipeline<Transformer>, "Not implemented");
-}
-
 
 
 template <typename Input, typename ... Transformers,
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRPPI_WORKER_LOCAL_H
+#define GRPPI_WORKER_LOCAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "grppi/common/accumulate.h"
+
+namespace grppi {
+
+namespace internal {
+
+/// Get a new unique identifier for a worker_local object.
+inline std::uint64_t next_worker_local_id() noexcept
+{
+  static std::atomic<std::uint64_t> counter{0};
+  return ++counter;
+}
+
+/// Entry in the per thread cache of worker local values.
+struct worker_local_entry {
+  std::uint64_t id = 0;
+  void * slot = nullptr;
+};
+
+constexpr std::size_t worker_local_cache_size = 8;
+
+/**
+\brief Get the cache of worker local values of the calling thread.
+The cache is direct mapped by object identifier, so that looking up the
+value of a thread takes constant time without synchronization.
+*/
+inline worker_local_entry * worker_local_cache() noexcept
+{
+  thread_local worker_local_entry cache[worker_local_cache_size];
+  return cache;
+}
+
+}
+
+/**
+\brief Storage with a separate value for every worker thread.
+A worker_local object may be used from the callables of any pattern and with
+any execution policy. Every thread gets its own value, which is constructed
+the first time the thread asks for it. After the pattern has finished, the
+values may be visited or combined.
+\tparam T Type of the values.
+\note Values are bound to threads, not to tasks. With back-ends where a 
+thread may interleave several tasks (e.g. TBB), a value must not be kept 
+across a call that may run other tasks.
+*/
+template <typename T>
+class worker_local {
+public:
+
+  /**
+  \brief Construct a worker_local object whose values are value initialized.
+  */
+  worker_local() : init_op_{[]() { return T{}; }} {}
+
+  /**
+  \brief Construct a worker_local object whose values are built from an
+  initialization function.
+  \tparam Init Callable type for the initialization.
+  \param init_op Initialization function returning the initial value of 
+  every thread.
+  */
+  template <typename Init, std::enable_if_t<
+      !std::is_same<std::decay_t<Init>, worker_local>::value, int> = 0>
+  explicit worker_local(Init && init_op) : 
+    init_op_{std::forward<Init>(init_op)} 
+  {}
+
+  worker_local(const worker_local &) = delete;
+  worker_local & operator=(const worker_local &) = delete;
+
+  /**
+  \brief Get the value of the calling thread.
+  The value is constructed if the thread did not have a value yet.
+  */
+  T & local()
+  {
+    auto & entry = internal::worker_local_cache()[
+        id_ % internal::worker_local_cache_size];
+    if (entry.id != id_) {
+      entry.slot = find_or_create();
+      entry.id = id_;
+    }
+    return static_cast<slot *>(entry.slot)->value;
+  }
+
+  /**
+  \brief Get the number of values constructed so far.
+  */
+  std::size_t size() const 
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return slots_.size();
+  }
+
+  /**
+  \brief Apply a function to every value.
+  \param op Function taking a value.
+  \pre No thread is accessing its value.
+  */
+  template <typename Function>
+  void for_each(Function && op)
+  {
+    for (auto & s : slots_) { op(s.value); }
+  }
+
+  /**
+  \brief Apply a function to every value.
+  \param op Function taking a value.
+  \pre No thread is accessing its value.
+  */
+  template <typename Function>
+  void for_each(Function && op) const
+  {
+    for (auto & s : slots_) { op(s.value); }
+  }
+
+  /**
+  \brief Combine all the values.
+  \param combine_op Combination operation. As values are visited in no 
+  particular order, it must be associative and commutative.
+  \return The combination of all values, or a new initial value if no
+  value was constructed.
+  \pre No thread is accessing its value.
+  */
+  template <typename Combiner>
+  T combine(Combiner && combine_op) const
+  {
+    if (slots_.empty()) return init_op_();
+    auto first = slots_.begin();
+    T result = first->value;
+    for (++first; first != slots_.end(); ++first) {
+      internal::combine_into(combine_op, result, first->value);
+    }
+    return result;
+  }
+
+  /**
+  \brief Destroy all the values.
+  Threads get a new value the next time they ask for it.
+  \pre No thread is accessing its value.
+  */
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    slots_.clear();
+    owners_.clear();
+    id_ = internal::next_worker_local_id();
+  }
+
+private:
+
+  // Values are kept in different cache lines to avoid false sharing
+  struct alignas(64) slot {
+    slot(T && v) : value{std::move(v)} {}
+    T value;
+  };
+
+  slot * find_or_create()
+  {
+    const auto owner = std::this_thread::get_id();
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto it = owners_.find(owner);
+      if (it != owners_.end()) return it->second;
+    }
+    // Only the calling thread inserts its own value, so it may be built
+    // without holding the lock.
+    T value = init_op_();
+    std::lock_guard<std::mutex> lock{mutex_};
+    slots_.emplace_back(std::move(value));
+    auto * s = &slots_.back();
+    owners_.emplace(owner, s);
+    return s;
+  }
+
+  std::function<T()> init_op_;
+  std::uint64_t id_ = internal::next_worker_local_id();
+  mutable std::mutex mutex_;
+  std::deque<slot> slots_;
+  std::unordered_map<std::thread::id, slot *> owners_;
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// Standard library
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// grppi
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/pipeline_plan.h"
+#include "grppi/seq/sequential_execution.h"
+#include "grppi/native/parallel_execution_native.h"
+
+// Generator of a small stream of integers
+class small_stream {
+public:
+  small_stream(int size) : size_{size} {}
+
+  grppi::optional<int> operator()() {
+    if (current_ < size_) { return current_++; }
+    return {};
+  }
+
+private:
+  int size_;
+  int current_ = 0;
+};
+
+template <typename Run>
+double time_runs(int runs, Run && run) {
+  using namespace std::chrono;
+  auto start = steady_clock::now();
+  for (int i=0; i<runs; ++i) { run(); }
+  auto elapsed = steady_clock::now() - start;
+  return duration<double, std::micro>{elapsed}.count() / runs;
+}
+
+void print_message(const std::string & prog, const std::string & msg) {
+  using namespace std;
+
+  cerr << msg << endl;
+  cerr << "Usage: " << prog << " runs items" << endl;
+  cerr << "  runs: Number of runs of the pipeline" << endl;
+  cerr << "  items: Number of items in every run" << endl;
+}
+
+int main(int argc, char **argv) {
+
+  using namespace std;
+
+  if (argc < 3) {
+    print_message(argv[0], "Invalid number of arguments.");
+    return -1;
+  }
+
+  int runs = stoi(argv[1]);
+  int items = stoi(argv[2]);
+  if (runs <= 0 || items < 0) {
+    print_message(argv[0], "Invalid number of runs or items.");
+    return -1;
+  }
+
+  grppi::parallel_execution_native ex{4, true};
+  long sum = 0;
+  auto square = [](int x) { return x * x; };
+  auto accumulate = [&sum](int x) { sum += x; };
+
+  auto pipeline_time = time_runs(runs, [&]() {
+    grppi::pipeline(ex,
+      small_stream{items},
+      grppi::farm(4, square),
+      accumulate);
+  });
+
+  auto plan = grppi::make_pipeline_plan(ex,
+    grppi::farm(4, square),
+    accumulate);
+  auto plan_time = time_runs(runs, [&]() {
+    plan.run(small_stream{items});
+  });
+
+  cout << "pipeline: " << pipeline_time << " us/run" << endl;
+  cout << "pipeline_plan: " << plan_time << " us/run" << endl;
+  cout << "checksum: " << sum << endl;
+
+  return 0;
+}
@@ -29,40 +29,6 @@
 // Samples shared utilities
 #include "../../util/util.h"
 
-template <typename T>
-class row_span {
-public:
-  row_span(std::vector<T> & v, int cols, int r) : vec_{v}, cols_{cols}, row_{r} {}
-  T operator[](int i) const { return vec_[row_*cols_+i]; }
-
-private:
-  std::vector<T> & vec_;
-  int cols_;
-  int row_;
-};
-
-template <typename T>
-class col_span {
-public:
-  col_span(std::vector<T> & v, int cols, int c) : vec_{v}, cols_{cols}, col_{c} {}
-  T operator[](int i) const { return vec_[i*cols_+col_]; }
-
-private:
-  std::vector<T> & vec_;
-  int cols_;
-  int col_;
-};
-
-template <typename C, typename I>
-int row_index(I it, C & cont, int ncols) {
-  return std::distance(cont.begin(), it) / ncols;
-}
-
-template <typename C, typename I>
-int col_index(I it, C & cont, int ncols) {
-  return std::distance(cont.begin(), it) % ncols;
-}
-
 void matrix_mult(grppi::dynamic_execution & e, int n) {
   using namespace std;
 
@@ -77,17 +43,19 @@ void matrix_mult(grppi::dynamic_execution & e, int n) {
     [&]() { return gen(rdev); });
   std::vector<double> c(n*n);
 
-  grppi::stencil(e, make_tuple(begin(a),begin(b)), end(a), begin(c),
-    [=](auto, auto nh) {
-      double r = 0;
-      for (int k=0;k<n;++k) { r+= nh.first[k] * nh.second[k]; }
-      return r;
-    },
-    [&](auto it1, auto it2) {
-      return make_pair(
-        row_span<double>{a, n, row_index(it1,a,n)},
-        col_span<double>{b, n, col_index(it2,b,n)}
-      );
+  // Each tile of c is computed from a block of rows of a and a block of 
+  // columns of b, so that both blocks are reused from cache.
+  constexpr int tile_size = 64;
+  grppi::parallel_for(e, grppi::make_index_space(n, n),
+    grppi::dynamic_tiles(tile_size, tile_size),
+    [&](const grppi::tile<2> & t) {
+      for (auto i = t.begin(0); i < t.end(0); ++i) {
+        for (auto j = t.begin(1); j < t.end(1); ++j) {
+          double r = 0;
+          for (int k=0;k<n;++k) { r += a[i*n+k] * b[k*n+j]; }
+          c[i*n+j] = r;
+        }
+      }
     }
   );
 
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/async_pipeline.h"
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class async_pipeline_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> w{};
+
+  // Invocation counter
+  std::atomic<int> invocations_op{0};
+  std::atomic<int> invocations_sk{0};
+  std::atomic<int> sum{0};
+
+  void setup_futures() {
+    for (int i=0; i<10; ++i) { v.push_back(i); }
+  }
+
+  template <typename E>
+  void run_futures(const E & e) {
+    auto p = grppi::make_async_pipeline(e,
+      [this](int x) {
+        invocations_op++;
+        return x * 2;
+      },
+      [](int x) { return x + 1; });
+
+    vector<future<int>> results;
+    for (auto x : v) { results.push_back(p.push(x)); }
+    for (auto & r : results) { w.push_back(r.get()); }
+    p.close();
+  }
+
+  void check_futures() {
+    EXPECT_EQ(10, invocations_op);
+    EXPECT_EQ((vector<int>{1,3,5,7,9,11,13,15,17,19}), w);
+  }
+
+  void setup_callbacks() {
+    for (int i=0; i<100; ++i) { v.push_back(i); }
+  }
+
+  template <typename E>
+  void run_callbacks(const E & e) {
+    auto p = grppi::make_async_pipeline(e,
+      [this](int x) {
+        invocations_op++;
+        return x * 2;
+      },
+      [this](int x) {
+        invocations_sk++;
+        sum += x;
+      });
+
+    auto producer = [&](int first) {
+      for (size_t i=first; i<v.size(); i+=2) { EXPECT_TRUE(p.push(v[i])); }
+    };
+    thread t1{producer, 0};
+    thread t2{producer, 1};
+    t1.join();
+    t2.join();
+    p.close();
+  }
+
+  void check_callbacks() {
+    EXPECT_EQ(100, invocations_op);
+    EXPECT_EQ(100, invocations_sk);
+    EXPECT_EQ(9900, sum);
+  }
+
+  template <typename E>
+  void run_requests(const E & e) {
+    auto p = grppi::make_async_pipeline(e,
+      [this](int x) {
+        invocations_op++;
+        return x * x;
+      });
+
+    // Every request waits for its result before the next one is sent
+    for (int i=0; i<5; ++i) { w.push_back(p.push(i).get()); }
+    p.close();
+    EXPECT_TRUE(p.is_closed());
+    EXPECT_FALSE(p.push(5).valid());
+    EXPECT_FALSE(p.try_push(6).valid());
+  }
+
+  void check_requests() {
+    EXPECT_EQ(5, invocations_op);
+    EXPECT_EQ((vector<int>{0,1,4,9,16}), w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(async_pipeline_test, executions,);
+
+TYPED_TEST(async_pipeline_test, static_futures) //NOLINT
+{
+  this->setup_futures();
+  this->run_futures(this->execution_);
+  this->check_futures();
+}
+
+TYPED_TEST(async_pipeline_test, dyn_futures) //NOLINT
+{
+  this->setup_futures();
+  this->run_futures(this->dyn_execution_);
+  this->check_futures();
+}
+
+TYPED_TEST(async_pipeline_test, static_callbacks) //NOLINT
+{
+  this->setup_callbacks();
+  this->run_callbacks(this->execution_);
+  this->check_callbacks();
+}
+
+TYPED_TEST(async_pipeline_test, dyn_callbacks) //NOLINT
+{
+  this->setup_callbacks();
+  this->run_callbacks(this->dyn_execution_);
+  this->check_callbacks();
+}
+
+TYPED_TEST(async_pipeline_test, static_requests) //NOLINT
+{
+  this->run_requests(this->execution_);
+  this->check_requests();
+}
+
+TYPED_TEST(async_pipeline_test, dyn_requests) //NOLINT
+{
+  this->run_requests(this->dyn_execution_);
+  this->check_requests();
+}
+
+TEST(async_pipeline_native, ordered_farm) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  auto p = grppi::make_async_pipeline(ex,
+    grppi::farm(4, [](int x) { return x + 1; }),
+    [](int x) { return x * 3; });
+
+  vector<future<int>> results;
+  for (int i=0; i<500; ++i) { results.push_back(p.push(i)); }
+  for (int i=0; i<500; ++i) { EXPECT_EQ((i+1)*3, results[i].get()); }
+}
+
+TEST(async_pipeline_native, drain_on_close) //NOLINT
+{
+  parallel_execution_native ex{4, false};
+  std::atomic<int> count{0};
+  {
+    auto p = grppi::make_async_pipeline(ex,
+      grppi::farm(4, [](int x) { return x; }),
+      [&](int) { count++; });
+    for (int i=0; i<500; ++i) { p.push(i); }
+  }
+  EXPECT_EQ(500, count);
+}
+
+TEST(async_pipeline_native, futures_need_ordering) //NOLINT
+{
+  parallel_execution_native ex{4, false};
+  EXPECT_THROW(grppi::make_async_pipeline(ex, [](int x) { return x; }),
+      std::invalid_argument);
+}
+
+TEST(async_pipeline_native, dyn_futures_need_ordering) //NOLINT
+{
+  parallel_execution_native ex{4, false};
+  grppi::dynamic_execution dyn{ex};
+  EXPECT_THROW(grppi::make_async_pipeline(dyn, [](int x) { return x; }),
+      std::invalid_argument);
+}
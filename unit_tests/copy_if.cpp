@@ -0,0 +1,175 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/copy_if.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class copy_if_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> w{};
+  size_t written{};
+
+  // Invocation counter
+  std::atomic<int> invocations_predicate{0};
+
+  template <typename E>
+  void run_even(const E & e) {
+    auto last = grppi::copy_if(e, v, w, [this](int x) {
+      invocations_predicate++;
+      return x % 2 == 0;
+    });
+    written = std::distance(w.begin(), last);
+  }
+
+  template <typename E>
+  void run_even_iterators(const E & e) {
+    auto last = grppi::copy_if(e, begin(v), end(v), begin(w), [this](int x) {
+      invocations_predicate++;
+      return x % 2 == 0;
+    });
+    written = std::distance(w.begin(), last);
+  }
+
+  void setup_empty() {
+  }
+
+  void check_empty() {
+    EXPECT_EQ(0, invocations_predicate);
+    EXPECT_EQ(0u, written);
+  }
+
+  void setup_single() {
+    v = vector<int>{4};
+    w = vector<int>(1);
+  }
+
+  void check_single() {
+    EXPECT_EQ(1, invocations_predicate);
+    EXPECT_EQ(1u, written);
+    EXPECT_EQ(4, w[0]);
+  }
+
+  void setup_multiple() {
+    v = vector<int>{5,2,8,3,3,6,10,1,0,7,4};
+    w = vector<int>(v.size(), -1);
+  }
+
+  void check_multiple() {
+    EXPECT_EQ(11, invocations_predicate);
+    EXPECT_EQ(6u, written);
+    EXPECT_EQ((vector<int>{2,8,6,10,0,4,-1,-1,-1,-1,-1}), w);
+  }
+
+  void setup_large() {
+    v = vector<int>(100001);
+    iota(v.begin(), v.end(), 0);
+    reverse(v.begin(), v.end());
+    w = vector<int>(v.size());
+  }
+
+  void check_large() {
+    EXPECT_EQ(100001, invocations_predicate);
+    vector<int> expected;
+    std::copy_if(v.begin(), v.end(), back_inserter(expected),
+        [](int x) { return x % 2 == 0; });
+    ASSERT_EQ(expected.size(), written);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), w.begin()));
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(copy_if_test, executions,);
+
+TYPED_TEST(copy_if_test, static_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_even(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(copy_if_test, dyn_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_even(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(copy_if_test, static_single) //NOLINT
+{
+  this->setup_single();
+  this->run_even(this->execution_);
+  this->check_single();
+}
+
+TYPED_TEST(copy_if_test, dyn_single) //NOLINT
+{
+  this->setup_single();
+  this->run_even(this->dyn_execution_);
+  this->check_single();
+}
+
+TYPED_TEST(copy_if_test, static_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->run_even(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(copy_if_test, dyn_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->run_even(this->dyn_execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(copy_if_test, static_multiple_iterators) //NOLINT
+{
+  this->setup_multiple();
+  this->run_even_iterators(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(copy_if_test, static_large) //NOLINT
+{
+  this->setup_large();
+  this->run_even(this->execution_);
+  this->check_large();
+}
+
+TYPED_TEST(copy_if_test, dyn_large) //NOLINT
+{
+  this->setup_large();
+  this->run_even(this->dyn_execution_);
+  this->check_large();
+}
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <numeric>
 
 #include <gtest/gtest.h>
@@ -131,6 +134,99 @@ public:
       });
   }
 
+  template <typename E, typename C>
+  auto run_adaptive_vecsum(const E & e, C & cutoff) {
+    return grppi::divide_conquer(e, v,
+      // Divide
+      [this](auto & v) { 
+        invocations_divide++; 
+        auto mid = std::next(v.begin(), v.size()/2);
+        return std::vector<std::vector<int>>{{v.begin(), mid}, {mid, v.end()}};
+      },
+      // Predicate
+      [](auto & v) { return v.size()<=2; },
+      // Solve base case
+      [this](auto problem) { 
+        invocations_base++; 
+        return std::accumulate(problem.begin(), problem.end(), 0);
+      }, 
+      // Combine
+      [](auto p1, auto p2) { return p1 + p2; },
+      cutoff);
+  }
+
+  template <typename E, typename C>
+  auto run_adaptive_fibonacci(const E & e, int n, C & cutoff) {
+    return grppi::divide_conquer(e, n,
+      // Divide
+      [](int x) { return std::vector<int>{x-1, x-2}; },
+      // Predicate
+      [](int x) { return x<2; },
+      // Solve base case
+      [this](int x) { 
+        invocations_base++; 
+        return x;
+      }, 
+      // Combine
+      [](int x, int y) { return x + y; },
+      cutoff);
+  }
+
+  // A problem without size(), so that the size estimator is required
+  struct span { int first; int last; };
+
+  // Sizes of the problems seen by the cutoff controller
+  std::mutex estimated_mutex{};
+  vector<std::size_t> estimated{};
+
+  template <typename E>
+  auto run_adaptive_spans(const E & e) {
+    auto cutoff = grppi::make_adaptive_cutoff(
+      [this](const span & s) {
+        const auto size = static_cast<std::size_t>(s.last - s.first);
+        std::lock_guard<std::mutex> lock{estimated_mutex};
+        estimated.push_back(size);
+        return size;
+      }, 1e9);
+    // A large overhead makes the learned cutoff the upper bound
+    cutoff.set_task_overhead(std::chrono::milliseconds{1});
+    cutoff.record(1, std::chrono::nanoseconds{1});
+    out = grppi::divide_conquer(e, span{0, 1024},
+      // Divide
+      [](const span & s) {
+        const int mid = (s.first + s.last) / 2;
+        return std::vector<span>{{s.first, mid}, {mid, s.last}};
+      },
+      // Predicate
+      [](const span & s) { return s.last - s.first <= 1; },
+      // Solve base case
+      [this](const span & s) {
+        invocations_base++;
+        return s.first;
+      },
+      // Combine
+      [](int x, int y) { return x + y; },
+      cutoff);
+    return cutoff.cutoff();
+  }
+
+  void check_adaptive_spans(std::size_t cutoff) {
+    EXPECT_EQ(1024*1023/2, out);
+    EXPECT_EQ(1024, invocations_base);
+    ASSERT_LT(0u, cutoff);
+    // Problems are halved, so that tasks have the largest power of two size
+    // not greater than the cutoff. Smaller problems are only seen by the
+    // sequential recursion, and never by the controller.
+    std::size_t task_size = 1;
+    while (task_size * 2 <= cutoff) { task_size *= 2; }
+    const auto tasks = count(estimated.begin(), estimated.end(), task_size);
+    EXPECT_LT(0, tasks);
+    EXPECT_EQ(0, count_if(estimated.begin(), estimated.end(),
+        [&](std::size_t x) { return x < task_size; }));
+    EXPECT_EQ(0, count_if(estimated.begin(), estimated.end(),
+        [&](std::size_t x) { return x > task_size && x <= cutoff; }));
+  }
+
   void setup_empty() {
   }
 
@@ -172,6 +268,22 @@ public:
     out = 0;
   }
 
+  void setup_adaptive() {
+    v = vector<int>(4096);
+    std::iota(v.begin(), v.end(), 0);
+    out = 0;
+  }
+
+  template <typename C>
+  void check_adaptive(const C & cutoff) {
+    EXPECT_EQ(4096*4095/2, this->out);
+    EXPECT_LT(0, this->invocations_base);
+    EXPECT_LT(0u, cutoff.samples());
+    EXPECT_LT(0u, cutoff.cutoff());
+    EXPECT_GE(4096u, cutoff.cutoff());
+    EXPECT_LT(0, cutoff.task_overhead().count());
+  }
+
   void check_multiple_triple_div() {
     EXPECT_EQ(2, this->invocations_divide);
     EXPECT_EQ(7, this->invocations_predicate);
@@ -259,3 +371,51 @@ TYPED_TEST(divideconquer_test, static_multiple_triple_div_4_threads) //NOLINT
   this->out =  this->run_vecsum_chunked(this->execution_);
   this->check_multiple_triple_div();
 }
+
+TYPED_TEST(divideconquer_test, static_adaptive) //NOLINT
+{
+  this->setup_adaptive();
+  grppi::adaptive_cutoff<> cutoff;
+  this->out = this->run_adaptive_vecsum(this->execution_, cutoff);
+  this->check_adaptive(cutoff);
+}
+
+TYPED_TEST(divideconquer_test, dyn_adaptive) //NOLINT
+{
+  this->setup_adaptive();
+  grppi::adaptive_cutoff<> cutoff;
+  this->out = this->run_adaptive_vecsum(this->dyn_execution_, cutoff);
+  this->check_adaptive(cutoff);
+}
+
+TYPED_TEST(divideconquer_test, static_adaptive_reused) //NOLINT
+{
+  grppi::adaptive_cutoff<> cutoff;
+  for (int i=0; i<3; ++i) {
+    this->setup_adaptive();
+    this->out = this->run_adaptive_vecsum(this->execution_, cutoff);
+  }
+  this->check_adaptive(cutoff);
+}
+
+TYPED_TEST(divideconquer_test, static_adaptive_sequential_below_cutoff) //NOLINT
+{
+  auto cutoff = this->run_adaptive_spans(this->execution_);
+  this->check_adaptive_spans(cutoff);
+}
+
+TYPED_TEST(divideconquer_test, dyn_adaptive_sequential_below_cutoff) //NOLINT
+{
+  auto cutoff = this->run_adaptive_spans(this->dyn_execution_);
+  this->check_adaptive_spans(cutoff);
+}
+
+TYPED_TEST(divideconquer_test, static_adaptive_estimator) //NOLINT
+{
+  auto cutoff = grppi::make_adaptive_cutoff(
+      [](int n) { return std::size_t{1} << n; });
+  this->out = this->run_adaptive_fibonacci(this->execution_, 20, cutoff);
+  EXPECT_EQ(6765, this->out);
+  EXPECT_LT(0u, cutoff.samples());
+  EXPECT_LT(0u, cutoff.cutoff());
+}
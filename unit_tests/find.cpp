@@ -0,0 +1,284 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "grppi/find.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class find_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Variables
+  long position{};
+  bool any{};
+  bool all{};
+  bool none{};
+  grppi::optional<bool> cancellable_any{};
+  grppi::optional<bool> cancellable_all{};
+  grppi::optional<vector<int>::iterator> cancellable_find{};
+
+  // Vectors
+  vector<int> v{};
+
+  // Invocation counter
+  std::atomic<int> invocations_predicate{0};
+
+  template <typename E>
+  void run_find(const E & e) {
+    auto it = grppi::find_if(e, begin(v), end(v), 
+      [this](int x) { 
+        invocations_predicate++;
+        return x > 100; 
+      });
+    position = distance(begin(v), it);
+  }
+
+  template <typename E>
+  void run_find_range(const E & e) {
+    auto it = grppi::find_if(e, v, [](int x) { return x > 100; });
+    position = distance(begin(v), it);
+  }
+
+  template <typename E>
+  void run_quantifiers(const E & e) {
+    any = grppi::any_of(e, v, [](int x) { return x > 100; });
+    all = grppi::all_of(e, begin(v), end(v), [](int x) { return x > 100; });
+    none = grppi::none_of(e, v, [](int x) { return x > 100; });
+  }
+
+  template <typename E>
+  void run_cancellable(const E & e, const cancellation_token & token) {
+    auto predicate = [this](int x) {
+      invocations_predicate++;
+      return x > 100; 
+    };
+    cancellable_any = grppi::any_of(e, v, predicate, token);
+    cancellable_all = grppi::all_of(e, begin(v), end(v), predicate, token);
+    cancellable_find = grppi::find_if(e, begin(v), end(v), predicate, token);
+  }
+
+  template <typename E>
+  void run_cancelled(const E & e) {
+    cancellation_token token;
+    token.cancel();
+    run_cancellable(e, token);
+  }
+
+  template <typename E>
+  void run_not_cancelled(const E & e) {
+    run_cancellable(e, cancellation_token{});
+  }
+
+  void setup_empty() {}
+
+  void check_find_empty() {
+    EXPECT_EQ(0, position);
+    EXPECT_EQ(0, invocations_predicate);
+  }
+
+  void check_quantifiers_empty() {
+    EXPECT_FALSE(any);
+    EXPECT_TRUE(all);
+    EXPECT_TRUE(none);
+  }
+
+  void setup_not_found() {
+    v = vector<int>(1000, 1);
+  }
+
+  void check_find_not_found() {
+    EXPECT_EQ(1000, position);
+    EXPECT_EQ(1000, invocations_predicate);
+  }
+
+  void check_quantifiers_not_found() {
+    EXPECT_FALSE(any);
+    EXPECT_FALSE(all);
+    EXPECT_TRUE(none);
+  }
+
+  void setup_found() {
+    v = vector<int>(1000, 1);
+    v[600] = 200;
+    v[601] = 300;
+    v[900] = 400;
+  }
+
+  void check_find_found() {
+    EXPECT_EQ(600, position);
+  }
+
+  void check_quantifiers_found() {
+    EXPECT_TRUE(any);
+    EXPECT_FALSE(all);
+    EXPECT_FALSE(none);
+  }
+
+  void check_cancelled() {
+    EXPECT_FALSE(cancellable_any);
+    EXPECT_FALSE(cancellable_all);
+    EXPECT_FALSE(cancellable_find);
+    EXPECT_EQ(0, invocations_predicate);
+  }
+
+  void check_not_cancelled() {
+    ASSERT_TRUE(cancellable_any);
+    EXPECT_TRUE(*cancellable_any);
+    ASSERT_TRUE(cancellable_all);
+    EXPECT_FALSE(*cancellable_all);
+    ASSERT_TRUE(cancellable_find);
+    EXPECT_EQ(600, distance(begin(v), *cancellable_find));
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(find_test, executions,);
+
+TYPED_TEST(find_test, static_empty_find) //NOLINT
+{
+  this->setup_empty();
+  this->run_find(this->execution_);
+  this->check_find_empty();
+}
+
+TYPED_TEST(find_test, dyn_empty_find) //NOLINT
+{
+  this->setup_empty();
+  this->run_find(this->dyn_execution_);
+  this->check_find_empty();
+}
+
+TYPED_TEST(find_test, static_empty_quantifiers) //NOLINT
+{
+  this->setup_empty();
+  this->run_quantifiers(this->execution_);
+  this->check_quantifiers_empty();
+}
+
+TYPED_TEST(find_test, dyn_empty_quantifiers) //NOLINT
+{
+  this->setup_empty();
+  this->run_quantifiers(this->dyn_execution_);
+  this->check_quantifiers_empty();
+}
+
+TYPED_TEST(find_test, static_not_found_find) //NOLINT
+{
+  this->setup_not_found();
+  this->run_find(this->execution_);
+  this->check_find_not_found();
+}
+
+TYPED_TEST(find_test, dyn_not_found_find) //NOLINT
+{
+  this->setup_not_found();
+  this->run_find(this->dyn_execution_);
+  this->check_find_not_found();
+}
+
+TYPED_TEST(find_test, static_not_found_quantifiers) //NOLINT
+{
+  this->setup_not_found();
+  this->run_quantifiers(this->execution_);
+  this->check_quantifiers_not_found();
+}
+
+TYPED_TEST(find_test, dyn_not_found_quantifiers) //NOLINT
+{
+  this->setup_not_found();
+  this->run_quantifiers(this->dyn_execution_);
+  this->check_quantifiers_not_found();
+}
+
+TYPED_TEST(find_test, static_found_find) //NOLINT
+{
+  this->setup_found();
+  this->run_find(this->execution_);
+  this->check_find_found();
+}
+
+TYPED_TEST(find_test, dyn_found_find) //NOLINT
+{
+  this->setup_found();
+  this->run_find(this->dyn_execution_);
+  this->check_find_found();
+}
+
+TYPED_TEST(find_test, static_found_find_range) //NOLINT
+{
+  this->setup_found();
+  this->run_find_range(this->execution_);
+  this->check_find_found();
+}
+
+TYPED_TEST(find_test, dyn_found_find_range) //NOLINT
+{
+  this->setup_found();
+  this->run_find_range(this->dyn_execution_);
+  this->check_find_found();
+}
+
+TYPED_TEST(find_test, static_found_quantifiers) //NOLINT
+{
+  this->setup_found();
+  this->run_quantifiers(this->execution_);
+  this->check_quantifiers_found();
+}
+
+TYPED_TEST(find_test, dyn_found_quantifiers) //NOLINT
+{
+  this->setup_found();
+  this->run_quantifiers(this->dyn_execution_);
+  this->check_quantifiers_found();
+}
+
+TYPED_TEST(find_test, static_cancelled) //NOLINT
+{
+  this->setup_found();
+  this->run_cancelled(this->execution_);
+  this->check_cancelled();
+}
+
+TYPED_TEST(find_test, dyn_cancelled) //NOLINT
+{
+  this->setup_found();
+  this->run_cancelled(this->dyn_execution_);
+  this->check_cancelled();
+}
+
+TYPED_TEST(find_test, static_not_cancelled) //NOLINT
+{
+  this->setup_found();
+  this->run_not_cancelled(this->execution_);
+  this->check_not_cancelled();
+}
+
+TYPED_TEST(find_test, dyn_not_cancelled) //NOLINT
+{
+  this->setup_found();
+  this->run_not_cancelled(this->dyn_execution_);
+  this->check_not_cancelled();
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <numeric>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "grppi/first_touch.h"
+#include "grppi/map.h"
+#include "grppi/reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class first_touch_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  first_touch_vector<double> v{};
+  size_t size{};
+
+  template <typename E>
+  void run_make(const E & e) {
+    v = grppi::make_first_touch_vector(e, size, 1.5);
+  }
+
+  void setup_empty() {
+    size = 0;
+  }
+
+  void setup_multiple() {
+    size = 10001;
+  }
+
+  void check_values() {
+    EXPECT_EQ(size, v.size());
+    EXPECT_EQ(1.5 * size, std::accumulate(v.begin(), v.end(), 0.0));
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(first_touch_test, executions,);
+
+TYPED_TEST(first_touch_test, static_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_make(this->execution_);
+  this->check_values();
+}
+
+TYPED_TEST(first_touch_test, dyn_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_make(this->dyn_execution_);
+  this->check_values();
+}
+
+TYPED_TEST(first_touch_test, static_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->run_make(this->execution_);
+  this->check_values();
+}
+
+TYPED_TEST(first_touch_test, dyn_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->run_make(this->dyn_execution_);
+  this->check_values();
+}
+
+TEST(first_touch_native, chunk_affinity) //NOLINT
+{
+  parallel_execution_native ex{4};
+  EXPECT_FALSE(ex.is_chunk_affinity_enabled());
+  ex.enable_chunk_affinity();
+  auto copy = ex;
+  EXPECT_TRUE(copy.is_chunk_affinity_enabled());
+
+#ifdef __linux__
+  cpu_set_t before;
+  sched_getaffinity(0, sizeof(before), &before);
+#endif
+
+  auto v = grppi::make_first_touch_vector<int>(ex, 1001, 0);
+  grppi::map(ex, v, v, [](int x) { return x + 2; });
+  auto sum = grppi::reduce(ex, v, 0, [](int x, int y) { return x + y; });
+  EXPECT_EQ(2002, sum);
+
+#ifdef __linux__
+  cpu_set_t after;
+  sched_getaffinity(0, sizeof(after), &after);
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#endif
+}
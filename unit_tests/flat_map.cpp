@@ -0,0 +1,229 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/flat_map.h"
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class flat_map_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<string> lines{};
+  vector<string> words{};
+  vector<int> v{};
+  vector<int> w{};
+  vector<size_t> sizes{};
+
+  // entry counter
+  size_t idx_in = 0;
+
+  // Invocation counter
+  std::atomic<int> invocations_in{0};
+  std::atomic<int> invocations_op{0};
+  std::atomic<int> invocations_sk{0};
+
+  void setup_split() {
+    lines = vector<string>{"alpha beta", "", "gamma", "delta epsilon zeta"};
+  }
+
+  template <typename E>
+  void run_split(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<string> {
+        invocations_in++;
+        if (idx_in < lines.size()) { return lines[idx_in++]; }
+        return {};
+      },
+      grppi::flat_map([this](const string & line, sink<string> & out) {
+        invocations_op++;
+        string::size_type first = 0;
+        while (first < line.size()) {
+          auto last = line.find(' ', first);
+          if (last == string::npos) { last = line.size(); }
+          out(line.substr(first, last - first));
+          first = last + 1;
+        }
+      }),
+      [this](string word) {
+        invocations_sk++;
+        words.push_back(word);
+      });
+  }
+
+  void check_split() {
+    EXPECT_EQ(5, invocations_in);
+    EXPECT_EQ(4, invocations_op);
+    EXPECT_EQ(6, invocations_sk);
+    EXPECT_EQ((vector<string>{"alpha", "beta", "gamma", "delta", "epsilon",
+        "zeta"}), words);
+  }
+
+  void setup_batch() {
+    for (int i=0; i<10; ++i) { v.push_back(i); }
+  }
+
+  template <typename E>
+  void run_batch(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_in++;
+        if (idx_in < v.size()) { return v[idx_in++]; }
+        return {};
+      },
+      grppi::batch<int>(3),
+      [this](vector<int> items) {
+        invocations_op++;
+        sizes.push_back(items.size());
+        return items;
+      },
+      grppi::unbatch<int>(),
+      [this](int x) {
+        invocations_sk++;
+        w.push_back(x);
+      });
+  }
+
+  void check_batch() {
+    EXPECT_EQ(11, invocations_in);
+    EXPECT_EQ(4, invocations_op);
+    EXPECT_EQ(10, invocations_sk);
+    EXPECT_EQ((vector<size_t>{3,3,3,1}), sizes);
+    EXPECT_EQ(v, w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(flat_map_test, executions,);
+
+TYPED_TEST(flat_map_test, static_split) //NOLINT
+{
+  this->setup_split();
+  this->run_split(this->execution_);
+  this->check_split();
+}
+
+TYPED_TEST(flat_map_test, dyn_split) //NOLINT
+{
+  this->setup_split();
+  this->run_split(this->dyn_execution_);
+  this->check_split();
+}
+
+TYPED_TEST(flat_map_test, static_batch) //NOLINT
+{
+  this->setup_batch();
+  this->run_batch(this->execution_);
+  this->check_batch();
+}
+
+TYPED_TEST(flat_map_test, dyn_batch) //NOLINT
+{
+  this->setup_batch();
+  this->run_batch(this->dyn_execution_);
+  this->check_batch();
+}
+
+TEST(flat_map_native, ordered_after_farm) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  vector<int> w;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      if (idx < 200) { return idx++; }
+      return {};
+    },
+    grppi::farm(4, [](int x) { return x; }),
+    grppi::flat_map([](int x, sink<int> & out) {
+      for (int i=0; i<x%3; ++i) { out(x); }
+    }),
+    [&](int x) { w.push_back(x); });
+
+  vector<int> expected;
+  for (int x=0; x<200; ++x) {
+    for (int i=0; i<x%3; ++i) { expected.push_back(x); }
+  }
+  EXPECT_EQ(expected, w);
+}
+
+template <typename E>
+void check_batch_timeout(const E & ex)
+{
+  using namespace std::chrono_literals;
+  vector<vector<int>> batches;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      // The first batch expires while the generator is waiting
+      if (idx == 2) { std::this_thread::sleep_for(200ms); }
+      if (idx < 4) { return idx++; }
+      return {};
+    },
+    grppi::batch<int>(10, 20ms),
+    [&](vector<int> items) { batches.push_back(items); });
+
+  EXPECT_EQ((vector<vector<int>>{{0,1}, {2,3}}), batches);
+}
+
+TEST(flat_map_native, batch_timeout) //NOLINT
+{
+  check_batch_timeout(parallel_execution_native{4, true});
+}
+
+#ifdef GRPPI_OMP
+TEST(flat_map_omp, batch_timeout) //NOLINT
+{
+  check_batch_timeout(parallel_execution_omp{4, true});
+}
+#endif
+
+#ifdef GRPPI_TBB
+TEST(flat_map_tbb, batch_timeout) //NOLINT
+{
+  check_batch_timeout(parallel_execution_tbb{4, true});
+}
+#endif
+
+#ifdef GRPPI_FF
+TEST(flat_map_ff, batch_timeout_unsupported) //NOLINT
+{
+  using namespace std::chrono_literals;
+  parallel_execution_ff ex{4, true};
+  EXPECT_THROW(grppi::pipeline(ex,
+      []() -> grppi::optional<int> { return {}; },
+      grppi::batch<int>(10, 20ms),
+      [](vector<int>) {}),
+    std::invalid_argument);
+}
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/gather_scatter.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class gather_scatter_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<size_t> idx{};
+  vector<int> w{};
+  vector<int> expected{};
+
+  template <typename E>
+  void run_gather(const E & e) {
+    grppi::gather(e, idx, v, w);
+  }
+
+  template <typename E>
+  void run_gather_iterators(const E & e) {
+    grppi::gather(e, begin(idx), end(idx), begin(v), begin(w));
+  }
+
+  template <typename E>
+  void run_scatter(const E & e) {
+    grppi::scatter(e, v, idx, w);
+  }
+
+  template <typename E>
+  void run_scatter_iterators(const E & e) {
+    grppi::scatter(e, begin(v), end(v), begin(idx), begin(w));
+  }
+
+  template <typename E>
+  void run_permute_roundtrip(const E & e) {
+    vector<int> tmp(v.size());
+    grppi::permute(e, v, idx, tmp);
+    grppi::inverse_permute(e, tmp, idx, w);
+  }
+
+  void setup_empty() {
+  }
+
+  void check_empty() {
+    EXPECT_TRUE(w.empty());
+  }
+
+  void setup_gather() {
+    v = vector<int>{10,11,12,13,14};
+    idx = vector<size_t>{4,0,0,2,3,1,4};
+    w = vector<int>(idx.size());
+    expected = vector<int>{14,10,10,12,13,11,14};
+  }
+
+  void setup_scatter() {
+    v = vector<int>{10,11,12,13,14};
+    idx = vector<size_t>{3,0,4,1,2};
+    w = vector<int>(v.size());
+    expected = vector<int>{11,13,14,10,12};
+  }
+
+  void setup_large_permutation() {
+    const size_t n = 100000;
+    v = vector<int>(n);
+    iota(v.begin(), v.end(), 0);
+    idx = vector<size_t>(n);
+    iota(idx.begin(), idx.end(), 0);
+    shuffle(idx.begin(), idx.end(), std::mt19937{42});
+    w = vector<int>(n);
+    expected = v;
+  }
+
+  void setup_large_gather() {
+    setup_large_permutation();
+    expected = vector<int>(idx.begin(), idx.end());
+  }
+
+  void check_expected() {
+    EXPECT_EQ(expected, w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(gather_scatter_test, executions,);
+
+TYPED_TEST(gather_scatter_test, static_empty_gather) //NOLINT
+{
+  this->setup_empty();
+  this->run_gather(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(gather_scatter_test, dyn_empty_gather) //NOLINT
+{
+  this->setup_empty();
+  this->run_gather(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(gather_scatter_test, static_gather) //NOLINT
+{
+  this->setup_gather();
+  this->run_gather(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, dyn_gather) //NOLINT
+{
+  this->setup_gather();
+  this->run_gather(this->dyn_execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, static_gather_iterators) //NOLINT
+{
+  this->setup_gather();
+  this->run_gather_iterators(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, static_scatter) //NOLINT
+{
+  this->setup_scatter();
+  this->run_scatter(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, dyn_scatter) //NOLINT
+{
+  this->setup_scatter();
+  this->run_scatter(this->dyn_execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, static_scatter_iterators) //NOLINT
+{
+  this->setup_scatter();
+  this->run_scatter_iterators(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, static_large_gather) //NOLINT
+{
+  this->setup_large_gather();
+  this->run_gather(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, dyn_large_gather) //NOLINT
+{
+  this->setup_large_gather();
+  this->run_gather(this->dyn_execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, static_permute_roundtrip) //NOLINT
+{
+  this->setup_large_permutation();
+  this->run_permute_roundtrip(this->execution_);
+  this->check_expected();
+}
+
+TYPED_TEST(gather_scatter_test, dyn_permute_roundtrip) //NOLINT
+{
+  this->setup_large_permutation();
+  this->run_permute_roundtrip(this->dyn_execution_);
+  this->check_expected();
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/incremental_reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class incremental_reduce_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<string> w{};
+
+  void setup_empty() {}
+
+  void setup_multiple() {
+    v = vector<int>(1000);
+    iota(v.begin(), v.end(), 0);
+  }
+
+  void setup_strings() {
+    w = vector<string>(100);
+    for (int i = 0; i < 100; ++i) { w[i] = string(1, 'a' + i % 26); }
+  }
+
+  template <typename E>
+  void run_empty(const E & e) {
+    auto sum = grppi::make_incremental_reduce(v, 0, 
+        [](int x, int y) { return x + y; }, 16);
+    EXPECT_EQ(0u, sum.block_count());
+    EXPECT_EQ(0, sum.value(e));
+    sum.invalidate(0, 10);
+    EXPECT_EQ(0u, sum.dirty_blocks());
+    EXPECT_EQ(0, sum.value(e));
+  }
+
+  template <typename E>
+  void run_sum(const E & e) {
+    auto sum = grppi::make_incremental_reduce(begin(v), end(v), 0L, 
+        [](long x, int y) { return x + y; }, 64);
+    EXPECT_EQ(16u, sum.block_count());
+    EXPECT_EQ(16u, sum.dirty_blocks());
+    EXPECT_EQ(999L*1000L/2, sum.value(e));
+    EXPECT_EQ(0u, sum.dirty_blocks());
+
+    v[3] += 10;
+    v[500] += 20;
+    v[999] += 30;
+    sum.invalidate(3);
+    sum.invalidate(500);
+    sum.invalidate(999);
+    EXPECT_EQ(3u, sum.dirty_blocks());
+    EXPECT_EQ(999L*1000L/2 + 60, sum.value(e));
+
+    for (int i = 60; i < 200; ++i) { v[i] += 1; }
+    sum.invalidate(60, 200);
+    EXPECT_EQ(4u, sum.dirty_blocks());
+    EXPECT_EQ(999L*1000L/2 + 200, sum.value(e));
+    EXPECT_EQ(999L*1000L/2 + 200, sum.value(e));
+  }
+
+  template <typename E>
+  void run_concat(const E & e) {
+    auto concat = grppi::make_incremental_map_reduce(w, string{},
+        [](const string & s) { return s + s; },
+        [](string x, const string & y) { return x + y; }, 7);
+    auto expected = [this]() {
+      string result;
+      for (auto & s : w) { result += s + s; }
+      return result;
+    };
+    EXPECT_EQ(expected(), concat.value(e));
+
+    w[0] = "x";
+    w[50] = "y";
+    w[99] = "z";
+    concat.invalidate(0);
+    concat.invalidate(50);
+    concat.invalidate(99, 120);
+    EXPECT_EQ(expected(), concat.value(e));
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(incremental_reduce_test, executions,);
+
+TYPED_TEST(incremental_reduce_test, static_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_empty(this->execution_);
+}
+
+TYPED_TEST(incremental_reduce_test, dyn_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_empty(this->dyn_execution_);
+}
+
+TYPED_TEST(incremental_reduce_test, static_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sum(this->execution_);
+}
+
+TYPED_TEST(incremental_reduce_test, dyn_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sum(this->dyn_execution_);
+}
+
+TYPED_TEST(incremental_reduce_test, static_concat) //NOLINT
+{
+  this->setup_strings();
+  this->run_concat(this->execution_);
+}
+
+TYPED_TEST(incremental_reduce_test, dyn_concat) //NOLINT
+{
+  this->setup_strings();
+  this->run_concat(this->dyn_execution_);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+#include "grppi/divideconquer.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class inplace_divideconquer_test : public ::testing::Test {
+public:
+  T execution_{};
+  grppi::dynamic_execution dyn_execution_{execution_};
+
+  // Variables
+  long out{};
+
+  // Vectors
+  vector<int> v{};
+
+  // Invocation counter
+  std::atomic<int> invocations_divide{0};
+  std::atomic<int> invocations_base{0};
+  std::atomic<int> invocations_merge{0};
+
+  template <typename E>
+  void run_sort(const E & e) {
+    grppi::inplace_divide_conquer(e, make_iterator_range(v),
+      // Divide
+      [this](const auto & r) {
+        invocations_divide++;
+        return grppi::split<2>(r);
+      },
+      // Predicate
+      [](const auto & r) { return r.size() <= 8; },
+      // Solve base case
+      [this](const auto & r) {
+        invocations_base++;
+        std::sort(r.begin(), r.end());
+      },
+      // Merge
+      [this](const auto & r, const auto & parts) {
+        invocations_merge++;
+        std::inplace_merge(r.begin(), parts[1].begin(), r.end());
+      });
+  }
+
+  template <typename E>
+  auto run_sum(const E & e) {
+    return grppi::inplace_divide_conquer(e, index_range{0, v.size()},
+      // Divide
+      [this](const index_range & r) {
+        invocations_divide++;
+        return grppi::split<3>(r);
+      },
+      // Predicate
+      [](const index_range & r) { return r.size() <= 10; },
+      // Solve base case
+      [this](const index_range & r) {
+        invocations_base++;
+        long sum = 0;
+        for (auto i = r.first; i < r.last; ++i) { sum += v[i]; }
+        return sum;
+      },
+      // Merge in place
+      [this](long & acc, long x) {
+        invocations_merge++;
+        acc += x;
+      });
+  }
+
+  void setup_single() {
+    v = vector<int>{42};
+  }
+
+  void check_single_sort() {
+    EXPECT_EQ(0, invocations_divide);
+    EXPECT_EQ(1, invocations_base);
+    EXPECT_EQ(0, invocations_merge);
+    EXPECT_EQ(vector<int>{42}, v);
+  }
+
+  void check_single_sum() {
+    EXPECT_EQ(0, invocations_divide);
+    EXPECT_EQ(1, invocations_base);
+    EXPECT_EQ(42, out);
+  }
+
+  void setup_multiple() {
+    v.resize(90);
+    iota(v.begin(), v.end(), 0);
+    reverse(v.begin(), v.end());
+  }
+
+  void check_multiple_sort() {
+    EXPECT_EQ(15, invocations_divide);
+    EXPECT_EQ(16, invocations_base);
+    EXPECT_EQ(15, invocations_merge);
+    EXPECT_TRUE(is_sorted(v.begin(), v.end()));
+  }
+
+  void check_multiple_sum() {
+    EXPECT_EQ(4, invocations_divide);
+    EXPECT_EQ(9, invocations_base);
+    EXPECT_EQ(8, invocations_merge);
+    EXPECT_EQ(89*90/2, out);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(inplace_divideconquer_test, executions_noff,);
+
+TYPED_TEST(inplace_divideconquer_test, static_single_sort) //NOLINT
+{
+  this->setup_single();
+  this->run_sort(this->execution_);
+  this->check_single_sort();
+}
+
+TYPED_TEST(inplace_divideconquer_test, dyn_single_sort) //NOLINT
+{
+  this->setup_single();
+  this->run_sort(this->dyn_execution_);
+  this->check_single_sort();
+}
+
+TYPED_TEST(inplace_divideconquer_test, static_multiple_sort) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sort(this->execution_);
+  this->check_multiple_sort();
+}
+
+TYPED_TEST(inplace_divideconquer_test, dyn_multiple_sort) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sort(this->dyn_execution_);
+  this->check_multiple_sort();
+}
+
+TYPED_TEST(inplace_divideconquer_test, static_single_sum) //NOLINT
+{
+  this->setup_single();
+  this->out = this->run_sum(this->execution_);
+  this->check_single_sum();
+}
+
+TYPED_TEST(inplace_divideconquer_test, dyn_single_sum) //NOLINT
+{
+  this->setup_single();
+  this->out = this->run_sum(this->dyn_execution_);
+  this->check_single_sum();
+}
+
+TYPED_TEST(inplace_divideconquer_test, static_multiple_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->out = this->run_sum(this->execution_);
+  this->check_multiple_sum();
+}
+
+TYPED_TEST(inplace_divideconquer_test, dyn_multiple_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->out = this->run_sum(this->dyn_execution_);
+  this->check_multiple_sum();
+}
+
+TEST(inplace_divideconquer_native, threads_created_once) //NOLINT
+{
+  grppi::parallel_execution_native ex{4};
+  vector<int> v(65536);
+  iota(v.begin(), v.end(), 0);
+  reverse(v.begin(), v.end());
+  // Thread ids may be reused, thread local storage is not
+  static thread_local bool visited = false;
+  std::atomic<int> threads{0};
+
+  grppi::inplace_divide_conquer(ex, make_iterator_range(v),
+    [](const auto & r) { return grppi::split<2>(r); },
+    [](const auto & r) { return r.size() <= 8; },
+    [&](const auto & r) {
+      if (!visited) {
+        visited = true;
+        threads++;
+      }
+      std::sort(r.begin(), r.end());
+    },
+    [](const auto & r, const auto & parts) {
+      std::inplace_merge(r.begin(), parts[1].begin(), r.end());
+    });
+
+  EXPECT_TRUE(is_sorted(v.begin(), v.end()));
+  EXPECT_LE(threads, 4);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/stream_reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+#include "grppi/common/optional.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+using keyed_item = pair<int,int>;
+
+template<typename T>
+class keyed_farm_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<keyed_item> v{};
+  vector<keyed_item> w{};
+
+  // entry counter
+  size_t idx_in = 0;
+
+  // Invocation counter
+  std::atomic<int> invocations_in{0};
+  std::atomic<int> invocations_sk{0};
+
+  void setup_count() {
+    for (int i=0; i<100; ++i) {
+      v.emplace_back(i*i % 7, i);
+    }
+  }
+
+  template<typename E>
+  void run_count(const E & e)
+  {
+    grppi::pipeline(e,
+        [this]() -> grppi::optional<keyed_item> {
+          invocations_in++;
+          if (idx_in < v.size()) { return v[idx_in++]; }
+          return {};
+        },
+        grppi::keyed_farm(4,
+            [](const keyed_item & x) { return x.first; },
+            [count = 0](const keyed_item & x) mutable {
+              return keyed_item{x.first, ++count};
+            }
+        ),
+        [this](keyed_item x) {
+          invocations_sk++;
+          w.push_back(x);
+        }
+    );
+  }
+
+  void check_count()
+  {
+    EXPECT_EQ(101, invocations_in);
+    EXPECT_EQ(100, invocations_sk);
+    vector<int> counts(7);
+    for (auto & x : v) {
+      x.second = ++counts[x.first];
+    }
+    EXPECT_EQ(v, w);
+  }
+
+  void setup_reduce() {
+    v = vector<keyed_item>{{1,1}, {2,10}, {1,2}, {2,20}, {1,3}, {3,100},
+        {2,30}, {1,4}, {2,40}, {3,200}};
+  }
+
+  template<typename E>
+  void run_reduce(const E & e)
+  {
+    grppi::pipeline(e,
+        [this]() -> grppi::optional<keyed_item> {
+          invocations_in++;
+          if (idx_in < v.size()) { return v[idx_in++]; }
+          return {};
+        },
+        grppi::keyed_reduce(3,
+            [](const keyed_item & x) { return x.first; },
+            2, 2, keyed_item{0,0},
+            [](keyed_item acc, const keyed_item & x) {
+              return keyed_item{x.first, acc.second + x.second};
+            }
+        ),
+        [this](keyed_item x) {
+          invocations_sk++;
+          w.push_back(x);
+        }
+    );
+  }
+
+  void check_reduce()
+  {
+    EXPECT_EQ(11, invocations_in);
+    EXPECT_EQ(5, invocations_sk);
+    EXPECT_EQ((vector<keyed_item>{{1,3}, {2,30}, {1,7}, {2,70}, {3,300}}), w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(keyed_farm_test, executions,);
+
+TYPED_TEST(keyed_farm_test, static_count) //NOLINT
+{
+  this->setup_count();
+  this->run_count(this->execution_);
+  this->check_count();
+}
+
+TYPED_TEST(keyed_farm_test, dyn_count) //NOLINT
+{
+  this->setup_count();
+  this->run_count(this->dyn_execution_);
+  this->check_count();
+}
+
+TYPED_TEST(keyed_farm_test, static_reduce) //NOLINT
+{
+  this->setup_reduce();
+  this->run_reduce(this->execution_);
+  this->check_reduce();
+}
+
+TYPED_TEST(keyed_farm_test, dyn_reduce) //NOLINT
+{
+  this->setup_reduce();
+  this->run_reduce(this->dyn_execution_);
+  this->check_reduce();
+}
+
+TEST(keyed_farm_native, unordered_reduce) //NOLINT
+{
+  parallel_execution_native ex{4, false};
+  vector<keyed_item> w;
+  int idx = 0;
+  grppi::pipeline(ex,
+      [&]() -> grppi::optional<keyed_item> {
+        if (idx < 1000) {
+          auto x = keyed_item{idx % 10, idx};
+          idx++;
+          return x;
+        }
+        return {};
+      },
+      grppi::keyed_reduce(4,
+          [](const keyed_item & x) { return x.first; },
+          10, 10, keyed_item{0,0},
+          [](keyed_item acc, const keyed_item & x) {
+            return keyed_item{x.first, acc.second + x.second};
+          }
+      ),
+      [&](keyed_item x) { w.push_back(x); }
+  );
+
+  ASSERT_EQ(100u, w.size());
+  sort(w.begin(), w.end());
+  for (int k=0; k<10; ++k) {
+    for (int i=0; i<10; ++i) {
+      // Window i of key k holds the items k + 10*m for m in [10*i, 10*i+10)
+      EXPECT_EQ((keyed_item{k, 10*k + 1000*i + 450}), w[10*k+i]);
+    }
+  }
+}
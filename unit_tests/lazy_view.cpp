@@ -0,0 +1,239 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "grppi/map.h"
+#include "grppi/reduce.h"
+#include "grppi/mapreduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class lazy_view_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Variables
+  int output{};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> v2{};
+  vector<int> w{};
+
+  // Invocation counter
+  std::atomic<int> invocations_transformer{0};
+
+  template <typename E>
+  auto run_square_sum(const E & e) {
+    return grppi::reduce(e,
+      grppi::lazy(v).map([this](int x) {
+        invocations_transformer++;
+        return x*x;
+      }),
+      0,
+      [](int x, int y) { return x + y; }
+    );
+  }
+
+  template <typename E>
+  auto run_scalar_product(const E & e) {
+    return grppi::reduce(e,
+      grppi::lazy(grppi::zip(v,v2)).map([this](int x1, int x2) {
+        invocations_transformer++;
+        return x1 * x2;
+      }),
+      0,
+      [](int x, int y) { return x + y; }
+    );
+  }
+
+  template <typename E>
+  auto run_even_square_sum(const E & e) {
+    return grppi::reduce(e,
+      grppi::lazy(v)
+        .filter([](int x) { return x % 2 == 0; })
+        .map([this](int x) {
+          invocations_transformer++;
+          return x*x;
+        }),
+      0,
+      [](int x, int y) { return x + y; }
+    );
+  }
+
+  template <typename E>
+  auto run_map_reduce_chain(const E & e) {
+    return grppi::map_reduce(e,
+      grppi::lazy(grppi::zip(v,v2))
+        .map([](int x1, int x2) { return x1 + x2; })
+        .filter([](int x) { return x > 6; }),
+      0,
+      [this](int x) {
+        invocations_transformer++;
+        return 2*x;
+      },
+      [](int x, int y) { return x + y; }
+    );
+  }
+
+  template <typename E>
+  void run_map_chain(const E & e) {
+    grppi::map(e,
+      grppi::lazy(grppi::zip(v,v2)).map([](int x1, int x2) { return x1 * x2; }),
+      w,
+      [this](int x) {
+        invocations_transformer++;
+        return x + 1;
+      }
+    );
+  }
+
+  void setup_empty() {
+    output = 0;
+  }
+
+  void check_empty() {
+    EXPECT_EQ(0, invocations_transformer);
+    EXPECT_EQ(0, output);
+  }
+
+  void setup_multiple() {
+    v = vector<int>{1,2,3,4,5};
+    v2 = vector<int>{2,4,6,8,10};
+    w = vector<int>(5);
+    output = 0;
+  }
+
+  void check_square_sum() {
+    EXPECT_EQ(5, invocations_transformer);
+    EXPECT_EQ(55, output);
+  }
+
+  void check_scalar_product() {
+    EXPECT_EQ(5, invocations_transformer);
+    EXPECT_EQ(110, output);
+  }
+
+  void check_even_square_sum() {
+    EXPECT_EQ(2, invocations_transformer);
+    EXPECT_EQ(20, output);
+  }
+
+  void check_map_reduce_chain() {
+    EXPECT_EQ(3, invocations_transformer);
+    EXPECT_EQ(2*(9+12+15), output);
+  }
+
+  void check_map_chain() {
+    EXPECT_EQ(5, invocations_transformer);
+    EXPECT_EQ((vector<int>{3,9,19,33,51}), w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(lazy_view_test, executions,);
+
+TYPED_TEST(lazy_view_test, static_empty_square_sum) //NOLINT
+{
+  this->setup_empty();
+  this->output = this->run_square_sum(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(lazy_view_test, dyn_empty_square_sum) //NOLINT
+{
+  this->setup_empty();
+  this->output = this->run_square_sum(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(lazy_view_test, static_multiple_square_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_square_sum(this->execution_);
+  this->check_square_sum();
+}
+
+TYPED_TEST(lazy_view_test, dyn_multiple_square_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_square_sum(this->dyn_execution_);
+  this->check_square_sum();
+}
+
+TYPED_TEST(lazy_view_test, static_multiple_scalar_product) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_scalar_product(this->execution_);
+  this->check_scalar_product();
+}
+
+TYPED_TEST(lazy_view_test, dyn_multiple_scalar_product) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_scalar_product(this->dyn_execution_);
+  this->check_scalar_product();
+}
+
+TYPED_TEST(lazy_view_test, static_multiple_even_square_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_even_square_sum(this->execution_);
+  this->check_even_square_sum();
+}
+
+TYPED_TEST(lazy_view_test, dyn_multiple_even_square_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_even_square_sum(this->dyn_execution_);
+  this->check_even_square_sum();
+}
+
+TYPED_TEST(lazy_view_test, static_multiple_map_reduce_chain) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_map_reduce_chain(this->execution_);
+  this->check_map_reduce_chain();
+}
+
+TYPED_TEST(lazy_view_test, dyn_multiple_map_reduce_chain) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_map_reduce_chain(this->dyn_execution_);
+  this->check_map_reduce_chain();
+}
+
+TYPED_TEST(lazy_view_test, static_multiple_map_chain) //NOLINT
+{
+  this->setup_multiple();
+  this->run_map_chain(this->execution_);
+  this->check_map_chain();
+}
+
+TYPED_TEST(lazy_view_test, dyn_multiple_map_chain) //NOLINT
+{
+  this->setup_multiple();
+  this->run_map_chain(this->dyn_execution_);
+  this->check_map_chain();
+}
@@ -38,6 +38,7 @@ public:
   // Vectors
   vector<int> v{};
   vector<int> v2{};
+  vector<int> w{};
 
   // Invocation counter
   std::atomic<int> invocations_transformer{0};
@@ -139,6 +140,30 @@ public:
     output = 0;
   }
 
+  // In-place combiner for elements and partial results
+  struct append {
+    void operator()(vector<int> & acc, int x) const { acc.push_back(x); }
+    void operator()(vector<int> & acc, vector<int> && x) const {
+      acc.insert(acc.end(), x.begin(), x.end());
+    }
+  };
+
+  template <typename E>
+  auto run_square_append(const E & e) {
+    return grppi::map_reduce(e, v, vector<int>{},
+      [this](int x) {
+        invocations_transformer++;
+        return x*x;
+      },
+      append{}
+    );
+  }
+
+  void check_square_append() {
+    EXPECT_EQ(5, this->invocations_transformer);
+    EXPECT_EQ((vector<int>{1,4,9,16,25}), this->w);
+  }
+
   void check_multiple() {
     EXPECT_EQ(5, this->invocations_transformer);
     EXPECT_EQ(55, this->output);
@@ -338,3 +363,17 @@ TYPED_TEST(map_reduce_test, dyn_multiple_scalar_product_tuple_size_range) //NOLI
   this->output = this->run_scalar_product_tuple_range(this->dyn_execution_);
   this->check_multiple_scalar_product();
 }
+
+TYPED_TEST(map_reduce_test, static_multiple_square_append) //NOLINT
+{
+  this->setup_multiple();
+  this->w = this->run_square_append(this->execution_);
+  this->check_square_append();
+}
+
+TYPED_TEST(map_reduce_test, dyn_multiple_square_append) //NOLINT
+{
+  this->setup_multiple();
+  this->w = this->run_square_append(this->dyn_execution_);
+  this->check_square_append();
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/divideconquer.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+using memoized_executions = ::testing::Types<
+  grppi::parallel_execution_native
+
+#ifdef GRPPI_TBB
+  ,
+  grppi::parallel_execution_tbb
+#endif
+>;
+
+template <typename T>
+class memoized_divideconquer_test : public ::testing::Test {
+public:
+  T execution_{};
+
+  // Variables
+  long out{};
+
+  // Invocation counter
+  std::atomic<int> invocations_divide{0};
+  std::atomic<int> invocations_base{0};
+
+  template <typename E>
+  auto run_fibonacci(const E & e, int n) {
+    return grppi::memoized_divide_conquer(e, n,
+      // Key
+      [](int x) { return x; },
+      // Divide
+      [this](int x) { 
+        invocations_divide++;
+        return std::vector<int>{x-1, x-2}; 
+      },
+      // Predicate
+      [](int x) { return x<2; },
+      // Solve base case
+      [this](int x) -> long { 
+        invocations_base++;
+        return x; 
+      },
+      // Combine
+      [](long x, long y) { return x + y; });
+  }
+
+  template <typename E>
+  auto run_grid_paths(const E & e, int rows, int cols) {
+    return grppi::memoized_divide_conquer(e, make_pair(rows,cols),
+      // Key
+      [](const auto & p) { return p.first * 1000 + p.second; },
+      // Divide
+      [this](const auto & p) { 
+        invocations_divide++;
+        return std::vector<pair<int,int>>{
+            {p.first-1, p.second}, {p.first, p.second-1}}; 
+      },
+      // Predicate
+      [](const auto & p) { return p.first == 0 || p.second == 0; },
+      // Solve base case
+      [this](const auto &) -> long { 
+        invocations_base++;
+        return 1; 
+      },
+      // Combine (in place)
+      [](long & x, long y) { x += y; });
+  }
+
+  // Result without default constructor
+  struct total {
+    explicit total(long v) : value{v} {}
+    long value;
+  };
+
+  template <typename E>
+  auto run_undivided(const E & e, int n) {
+    return grppi::memoized_divide_conquer(e, n,
+      // Key
+      [](int x) { return x; },
+      // Divide, multiples of 5 are not divided
+      [this](int x) {
+        invocations_divide++;
+        if (x % 5 == 0) { return std::vector<int>{}; }
+        return std::vector<int>{x-1, x-2};
+      },
+      // Predicate
+      [](int x) { return x<2; },
+      // Solve base case
+      [this](int x) {
+        invocations_base++;
+        return total{x};
+      },
+      // Combine
+      [](total x, total y) { return total{x.value + y.value}; }).value;
+  }
+
+  static long expected_undivided(int x) {
+    if (x < 2 || x % 5 == 0) { return x; }
+    return expected_undivided(x-1) + expected_undivided(x-2);
+  }
+
+  void check_fibonacci() {
+    EXPECT_EQ(102334155, out);
+    EXPECT_EQ(39, invocations_divide);
+    EXPECT_EQ(2, invocations_base);
+  }
+
+  void check_grid_paths() {
+    EXPECT_EQ(184756, out);
+    EXPECT_EQ(100, invocations_divide);
+    EXPECT_EQ(20, invocations_base);
+  }
+};
+
+TYPED_TEST_SUITE(memoized_divideconquer_test, memoized_executions,);
+
+TYPED_TEST(memoized_divideconquer_test, static_fibonacci) //NOLINT
+{
+  this->out = this->run_fibonacci(this->execution_, 40);
+  this->check_fibonacci();
+}
+
+TYPED_TEST(memoized_divideconquer_test, static_fibonacci_single_thread) //NOLINT
+{
+  this->execution_.set_concurrency_degree(1);
+  this->out = this->run_fibonacci(this->execution_, 40);
+  this->check_fibonacci();
+}
+
+TYPED_TEST(memoized_divideconquer_test, static_fibonacci_eight_threads) //NOLINT
+{
+  this->execution_.set_concurrency_degree(8);
+  this->out = this->run_fibonacci(this->execution_, 40);
+  this->check_fibonacci();
+}
+
+TYPED_TEST(memoized_divideconquer_test, static_grid_paths) //NOLINT
+{
+  this->execution_.set_concurrency_degree(4);
+  this->out = this->run_grid_paths(this->execution_, 10, 10);
+  this->check_grid_paths();
+}
+
+TYPED_TEST(memoized_divideconquer_test, static_undivided) //NOLINT
+{
+  this->execution_.set_concurrency_degree(4);
+  this->out = this->run_undivided(this->execution_, 23);
+  EXPECT_EQ(this->expected_undivided(23), this->out);
+}
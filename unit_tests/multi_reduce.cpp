@@ -0,0 +1,204 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include "grppi/reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class multi_reduce_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Variables
+  tuple<int,int,long,int> output{};
+  string concatenation{};
+
+  // Vectors
+  vector<int> v{};
+  vector<string> words{};
+
+  template <typename E>
+  auto run_statistics(const E & e) {
+    return grppi::reduce(e, v,
+      grppi::reduction(numeric_limits<int>::max(),
+          [](int x, int y) { return std::min(x,y); }),
+      grppi::reduction(numeric_limits<int>::min(),
+          [](int x, int y) { return std::max(x,y); }),
+      grppi::reduction(0L,
+          [](long x, long y) { return x + y; }),
+      grppi::reduction(0,
+          [](int x) { return (x % 2 == 0) ? 1 : 0; },
+          [](int x, int y) { return x + y; })
+    );
+  }
+
+  template <typename E>
+  auto run_statistics_iterators(const E & e) {
+    return grppi::reduce(e, begin(v), end(v),
+      grppi::reduction(numeric_limits<int>::max(),
+          [](int x, int y) { return std::min(x,y); }),
+      grppi::reduction(numeric_limits<int>::min(),
+          [](int x, int y) { return std::max(x,y); }),
+      grppi::reduction(0L,
+          [](long x, long y) { return x + y; }),
+      grppi::reduction(0,
+          [](int x) { return (x % 2 == 0) ? 1 : 0; },
+          [](int x, int y) { return x + y; })
+    );
+  }
+
+  template <typename E>
+  auto run_concatenation(const E & e) {
+    return grppi::reduce(e, words,
+      grppi::reduction(string{},
+          [](const string & x, const string & y) { return x + y; }),
+      grppi::reduction(size_t{0},
+          [](const string & x) { return x.size(); },
+          [](size_t x, size_t y) { return x + y; })
+    );
+  }
+
+  void setup_empty() {
+  }
+
+  void check_empty() {
+    EXPECT_EQ(numeric_limits<int>::max(), get<0>(output));
+    EXPECT_EQ(numeric_limits<int>::min(), get<1>(output));
+    EXPECT_EQ(0, get<2>(output));
+    EXPECT_EQ(0, get<3>(output));
+  }
+
+  void setup_single() {
+    v = vector<int>{42};
+  }
+
+  void check_single() {
+    EXPECT_EQ(42, get<0>(output));
+    EXPECT_EQ(42, get<1>(output));
+    EXPECT_EQ(42, get<2>(output));
+    EXPECT_EQ(1, get<3>(output));
+  }
+
+  void setup_multiple() {
+    v.resize(1003);
+    iota(begin(v), end(v), -500);
+    std::reverse(begin(v), end(v));
+  }
+
+  void check_multiple() {
+    EXPECT_EQ(-500, get<0>(output));
+    EXPECT_EQ(502, get<1>(output));
+    EXPECT_EQ(1003, get<2>(output));
+    EXPECT_EQ(502, get<3>(output));
+  }
+
+  void setup_words() {
+    for (int i=0; i<100; ++i) { words.push_back(to_string(i)); }
+  }
+
+  void check_words(const tuple<string,size_t> & result) {
+    string expected;
+    for (auto & w : words) { expected += w; }
+    EXPECT_EQ(expected, get<0>(result));
+    EXPECT_EQ(expected.size(), get<1>(result));
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(multi_reduce_test, executions,);
+
+TYPED_TEST(multi_reduce_test, static_empty) //NOLINT
+{
+  this->setup_empty();
+  this->output = this->run_statistics(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(multi_reduce_test, dyn_empty) //NOLINT
+{
+  this->setup_empty();
+  this->output = this->run_statistics(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(multi_reduce_test, static_single) //NOLINT
+{
+  this->setup_single();
+  this->output = this->run_statistics(this->execution_);
+  this->check_single();
+}
+
+TYPED_TEST(multi_reduce_test, dyn_single) //NOLINT
+{
+  this->setup_single();
+  this->output = this->run_statistics(this->dyn_execution_);
+  this->check_single();
+}
+
+TYPED_TEST(multi_reduce_test, static_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_statistics(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(multi_reduce_test, dyn_multiple) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_statistics(this->dyn_execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(multi_reduce_test, static_multiple_iterators) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_statistics_iterators(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(multi_reduce_test, dyn_multiple_iterators) //NOLINT
+{
+  this->setup_multiple();
+  this->output = this->run_statistics_iterators(this->dyn_execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(multi_reduce_test, static_words) //NOLINT
+{
+  this->setup_words();
+  auto result = this->run_concatenation(this->execution_);
+  this->check_words(result);
+}
+
+TYPED_TEST(multi_reduce_test, dyn_words) //NOLINT
+{
+  this->setup_words();
+  auto result = this->run_concatenation(this->dyn_execution_);
+  this->check_words(result);
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/parallel_for.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class parallel_for_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Sizes
+  size_t rows{}, cols{}, depth{};
+
+  // Vectors
+  vector<int> hits{};
+
+  // Invocation counter
+  std::atomic<int> invocations_body{0};
+
+  template <typename E>
+  void run_1d(const E & e) {
+    grppi::parallel_for(e, grppi::make_index_space(rows), 
+      [this](size_t i) {
+        invocations_body++;
+        hits[i]++;
+      });
+  }
+
+  template <typename E>
+  void run_2d_static_tiles(const E & e) {
+    grppi::parallel_for(e, grppi::make_index_space(rows, cols),
+      grppi::static_tiles(3, 4),
+      [this](const grppi::tile<2> & t) {
+        invocations_body++;
+        EXPECT_GE(3u, t.extent(0));
+        EXPECT_GE(4u, t.extent(1));
+        for (auto i = t.begin(0); i < t.end(0); ++i) {
+          for (auto j = t.begin(1); j < t.end(1); ++j) {
+            hits[i*cols + j]++;
+          }
+        }
+      });
+  }
+
+  template <typename E>
+  void run_3d_dynamic_tiles(const E & e) {
+    grppi::parallel_for(e, grppi::make_index_space(rows, cols, depth),
+      grppi::dynamic_tiles(2, 0, 3),
+      [this](size_t i, size_t j, size_t k) {
+        invocations_body++;
+        hits[(i*cols + j)*depth + k]++;
+      });
+  }
+
+  template <typename E>
+  void run_offset_space(const E & e) {
+    grppi::parallel_for(e, 
+      grppi::index_space<2>{{1,2}, {rows-1, cols}},
+      grppi::dynamic_tiles(1, 2),
+      [this](size_t i, size_t j) {
+        invocations_body++;
+        hits[i*cols + j]++;
+      });
+  }
+
+  void setup_empty() {
+    rows = 0; cols = 0; depth = 0;
+  }
+
+  void check_empty() {
+    EXPECT_EQ(0, invocations_body);
+  }
+
+  void setup_1d() {
+    rows = 1000;
+    hits = vector<int>(rows);
+  }
+
+  void check_1d() {
+    EXPECT_EQ(1000, invocations_body);
+    EXPECT_EQ(vector<int>(rows, 1), hits);
+  }
+
+  void setup_2d() {
+    rows = 10; cols = 15;
+    hits = vector<int>(rows * cols);
+  }
+
+  void check_2d_static_tiles() {
+    EXPECT_EQ(4*4, invocations_body);
+    EXPECT_EQ(vector<int>(rows*cols, 1), hits);
+  }
+
+  void check_offset_space() {
+    EXPECT_EQ(8*13, invocations_body);
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        const bool inside = i >= 1 && i < rows-1 && j >= 2;
+        EXPECT_EQ(inside ? 1 : 0, hits[i*cols + j]);
+      }
+    }
+  }
+
+  void setup_3d() {
+    rows = 5; cols = 6; depth = 7;
+    hits = vector<int>(rows * cols * depth);
+  }
+
+  void check_3d_dynamic_tiles() {
+    EXPECT_EQ(5*6*7, invocations_body);
+    EXPECT_EQ(vector<int>(rows*cols*depth, 1), hits);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(parallel_for_test, executions,);
+
+TYPED_TEST(parallel_for_test, static_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_1d(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(parallel_for_test, dyn_empty) //NOLINT
+{
+  this->setup_empty();
+  this->run_1d(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(parallel_for_test, static_1d) //NOLINT
+{
+  this->setup_1d();
+  this->run_1d(this->execution_);
+  this->check_1d();
+}
+
+TYPED_TEST(parallel_for_test, dyn_1d) //NOLINT
+{
+  this->setup_1d();
+  this->run_1d(this->dyn_execution_);
+  this->check_1d();
+}
+
+TYPED_TEST(parallel_for_test, static_2d_static_tiles) //NOLINT
+{
+  this->setup_2d();
+  this->run_2d_static_tiles(this->execution_);
+  this->check_2d_static_tiles();
+}
+
+TYPED_TEST(parallel_for_test, dyn_2d_static_tiles) //NOLINT
+{
+  this->setup_2d();
+  this->run_2d_static_tiles(this->dyn_execution_);
+  this->check_2d_static_tiles();
+}
+
+TYPED_TEST(parallel_for_test, static_2d_offset_space) //NOLINT
+{
+  this->setup_2d();
+  this->run_offset_space(this->execution_);
+  this->check_offset_space();
+}
+
+TYPED_TEST(parallel_for_test, dyn_2d_offset_space) //NOLINT
+{
+  this->setup_2d();
+  this->run_offset_space(this->dyn_execution_);
+  this->check_offset_space();
+}
+
+TYPED_TEST(parallel_for_test, static_3d_dynamic_tiles) //NOLINT
+{
+  this->setup_3d();
+  this->run_3d_dynamic_tiles(this->execution_);
+  this->check_3d_dynamic_tiles();
+}
+
+TYPED_TEST(parallel_for_test, dyn_3d_dynamic_tiles) //NOLINT
+{
+  this->setup_3d();
+  this->run_3d_dynamic_tiles(this->dyn_execution_);
+  this->check_3d_dynamic_tiles();
+}
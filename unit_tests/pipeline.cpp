@@ -220,6 +220,26 @@ public:
     EXPECT_EQ(60, out);
   }
 
+  template <typename E>
+  void run_cancelled(const E & e) {
+    cancellation_token token;
+    grppi::pipeline(e,
+      grppi::cancellable(token, [this,i=0]() mutable -> grppi::optional<int> {
+        invocations_init++;
+        return ++i;
+      }),
+      [this,token](int x) {
+        invocations_last++;
+        if (x >= 10) { token.cancel(); }
+      });
+  }
+
+  void check_cancelled() {
+    EXPECT_LE(10, invocations_init);
+    EXPECT_LE(10, invocations_last);
+    EXPECT_EQ(invocations_init, invocations_last);
+  }
+
 };
 
 // Test for execution policies defined in supported_executions.h
@@ -293,4 +313,15 @@ TYPED_TEST(pipeline_test, static_composed_piecewise) //NOLINT
   this->setup_composed();
   this->run_composed_piecewise(this->execution_);
   this->check_composed();
-}
\ No newline at end of file
+}
+TYPED_TEST(pipeline_test, static_cancelled) //NOLINT
+{
+  this->run_cancelled(this->execution_);
+  this->check_cancelled();
+}
+
+TYPED_TEST(pipeline_test, dyn_cancelled) //NOLINT
+{
+  this->run_cancelled(this->dyn_execution_);
+  this->check_cancelled();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/pipeline_plan.h"
+#include "grppi/stream_filter.h"
+#include "grppi/stream_reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class pipeline_plan_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> w{};
+
+  // Invocation counter
+  std::atomic<int> invocations_op{0};
+  std::atomic<int> invocations_sk{0};
+
+  template <typename E>
+  void run_many(const E & e) {
+    auto plan = grppi::make_pipeline_plan(e,
+      [this](int x) {
+        invocations_op++;
+        return x * 2;
+      },
+      grppi::keep([](int x) { return x % 3 != 0; }),
+      [this](int x) {
+        invocations_sk++;
+        w.push_back(x);
+      });
+
+    for (int run=0; run<10; ++run) {
+      int idx = 0;
+      plan.run([&]() -> grppi::optional<int> {
+        if (idx < run) { return idx++; }
+        return {};
+      });
+    }
+  }
+
+  void check_many() {
+    EXPECT_EQ(45, invocations_op);
+    vector<int> expected;
+    for (int run=0; run<10; ++run) {
+      for (int i=0; i<run; ++i) {
+        if ((i*2) % 3 != 0) { expected.push_back(i*2); }
+      }
+    }
+    EXPECT_EQ(static_cast<int>(expected.size()), invocations_sk);
+    EXPECT_EQ(expected, w);
+  }
+
+  template <typename E>
+  void run_reduce(const E & e) {
+    auto plan = grppi::make_pipeline_plan(e,
+      grppi::reduce(4, 4, 0, [](int x, int y) { return x + y; }),
+      [this](int x) {
+        invocations_sk++;
+        w.push_back(x);
+      });
+
+    for (int run=0; run<3; ++run) {
+      int idx = 0;
+      plan.run([&]() -> grppi::optional<int> {
+        if (idx < 6) { return idx++; }
+        return {};
+      });
+    }
+  }
+
+  void check_reduce() {
+    // Every run starts with empty windows
+    EXPECT_EQ(3, invocations_sk);
+    EXPECT_EQ((vector<int>{6,6,6}), w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(pipeline_plan_test, executions,);
+
+TYPED_TEST(pipeline_plan_test, static_many) //NOLINT
+{
+  this->run_many(this->execution_);
+  this->check_many();
+}
+
+TYPED_TEST(pipeline_plan_test, dyn_many) //NOLINT
+{
+  this->run_many(this->dyn_execution_);
+  this->check_many();
+}
+
+TYPED_TEST(pipeline_plan_test, static_reduce) //NOLINT
+{
+  this->run_reduce(this->execution_);
+  this->check_reduce();
+}
+
+TYPED_TEST(pipeline_plan_test, dyn_reduce) //NOLINT
+{
+  this->run_reduce(this->dyn_execution_);
+  this->check_reduce();
+}
+
+TEST(pipeline_plan_native, reuses_threads) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  vector<int> w;
+  auto plan = grppi::make_pipeline_plan(ex,
+    grppi::farm(4, [](int x) { return x + 1; }),
+    [&](int x) { w.push_back(x); });
+
+  auto run = [&]() {
+    int idx = 0;
+    plan.run([&]() -> grppi::optional<int> {
+      if (idx < 10) { return idx++; }
+      return {};
+    });
+  };
+
+  for (int i=0; i<101; ++i) { run(); }
+
+  // Generator and farm replicas never need more than 5 threads
+  ASSERT_NE(nullptr, plan.execution().cached_threads());
+  EXPECT_LE(plan.execution().cached_threads()->size(), 5u);
+
+  vector<int> expected;
+  for (int i=0; i<101; ++i) {
+    for (int x=1; x<=10; ++x) { expected.push_back(x); }
+  }
+  EXPECT_EQ(expected, w);
+}
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include "grppi/reduce.h"
@@ -32,8 +34,11 @@ public:
   // Variables
   int out{};
 
+  string text{};
+
   // Vectors
   vector<int> v{};
+  vector<string> words{};
 
   template <typename E>
   void run_unary(const E & e) {
@@ -56,6 +61,13 @@ public:
     );
   }
 
+  template <typename E>
+  void run_in_place(const E & e) {
+    text = grppi::reduce(e, words, string{},
+     [](string & acc, const string & x) { acc += x; }
+    );
+  }
+
   void setup_single() {
     out = 0;
     v = vector<int>{1};
@@ -74,6 +86,16 @@ public:
     EXPECT_EQ(15, out); 
   }
 
+  void setup_words() {
+    for (int i=0; i<50; ++i) { words.push_back(to_string(i)); }
+  }
+
+  void check_words() {
+    string expected;
+    for (auto & w : words) { expected += w; }
+    EXPECT_EQ(expected, text);
+  }
+
 };
 
 // Test for execution policies defined in supported_executions.h
@@ -162,3 +184,17 @@ TYPED_TEST(reduce_test, dyn_multiple_range) //NOLINT
   this->run_unary_range(this->dyn_execution_);
   this->check_multiple();
 }
+
+TYPED_TEST(reduce_test, static_in_place) //NOLINT
+{
+  this->setup_words();
+  this->run_in_place(this->execution_);
+  this->check_words();
+}
+
+TYPED_TEST(reduce_test, dyn_in_place) //NOLINT
+{
+  this->setup_words();
+  this->run_in_place(this->dyn_execution_);
+  this->check_words();
+}
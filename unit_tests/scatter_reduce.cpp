@@ -0,0 +1,155 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/scatter_reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class scatter_reduce_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<string> words{};
+  vector<size_t> counts{};
+  vector<string> bins{};
+
+  template <typename E>
+  void run_histogram(const E & e) {
+    counts = grppi::histogram(e, v, 10,
+      [](int x) { return static_cast<size_t>(x % 10); });
+  }
+
+  template <typename E>
+  void run_histogram_iterators(const E & e) {
+    counts = grppi::histogram(e, begin(v), end(v), 10,
+      [](int x) { return static_cast<size_t>(x % 10); });
+  }
+
+  template <typename E>
+  void run_scatter_words(const E & e) {
+    bins = grppi::scatter_reduce(e, words, 3, string{},
+      [](const string & w) { return w.size() - 1; },
+      [](const string & w) { return w.substr(0,1); },
+      [](const string & x, const string & y) { return x + y; });
+  }
+
+  void setup_empty() {}
+
+  void check_empty() {
+    EXPECT_EQ(vector<size_t>(10,0), counts);
+  }
+
+  void setup_multiple() {
+    for (int i = 0; i < 1005; ++i) { v.push_back(i); }
+  }
+
+  void check_multiple() {
+    vector<size_t> expected(10, 100);
+    for (int i = 0; i < 5; ++i) { expected[i]++; }
+    EXPECT_EQ(expected, counts);
+  }
+
+  void setup_words() {
+    words = vector<string>{"a", "bb", "ccc", "d", "ee", "f", "ggg"};
+  }
+
+  void check_words() {
+    EXPECT_EQ((vector<string>{"adf", "be", "cg"}), bins);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(scatter_reduce_test, executions,);
+
+TYPED_TEST(scatter_reduce_test, static_empty_histogram) //NOLINT
+{
+  this->setup_empty();
+  this->run_histogram(this->execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(scatter_reduce_test, dyn_empty_histogram) //NOLINT
+{
+  this->setup_empty();
+  this->run_histogram(this->dyn_execution_);
+  this->check_empty();
+}
+
+TYPED_TEST(scatter_reduce_test, static_multiple_histogram) //NOLINT
+{
+  this->setup_multiple();
+  this->run_histogram(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(scatter_reduce_test, dyn_multiple_histogram) //NOLINT
+{
+  this->setup_multiple();
+  this->run_histogram(this->dyn_execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(scatter_reduce_test, static_multiple_histogram_iterators) //NOLINT
+{
+  this->setup_multiple();
+  this->run_histogram_iterators(this->execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(scatter_reduce_test, dyn_multiple_histogram_iterators) //NOLINT
+{
+  this->setup_multiple();
+  this->run_histogram_iterators(this->dyn_execution_);
+  this->check_multiple();
+}
+
+TYPED_TEST(scatter_reduce_test, static_words) //NOLINT
+{
+  this->setup_words();
+  this->run_scatter_words(this->execution_);
+  this->check_words();
+}
+
+TYPED_TEST(scatter_reduce_test, dyn_words) //NOLINT
+{
+  this->setup_words();
+  this->run_scatter_words(this->dyn_execution_);
+  this->check_words();
+}
+
+// Number of bins forcing shared atomic bins with 4 workers
+TEST(scatter_reduce_native, shared_bins_histogram) //NOLINT
+{
+  parallel_execution_native ex{4};
+  const size_t num_bins = (size_t{1} << 20) + 1;
+  vector<size_t> v(2 * num_bins);
+  for (size_t i = 0; i < v.size(); ++i) { v[i] = i; }
+  auto counts = grppi::histogram(ex, v, num_bins,
+    [num_bins](size_t x) { return x % num_bins; });
+  EXPECT_EQ(vector<size_t>(num_bins, 2), counts);
+}
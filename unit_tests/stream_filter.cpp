@@ -13,11 +13,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <atomic>
 
 #include <gtest/gtest.h>
 
 #include "grppi/stream_filter.h"
+#include "grppi/farm.h"
+#include "grppi/common/sequence_tracker.h"
 #include "grppi/pipeline.h"
 #include "grppi/dyn/dynamic_execution.h"
 
@@ -213,6 +216,48 @@ public:
     EXPECT_TRUE(equal(begin(expected_odd), end(expected_odd), begin(w)));
   }
 
+  void setup_sparse() {
+    for (int i=0; i<1000; ++i) { v.push_back(i); }
+    for (int i=0; i<1000; i+=100) { expected_even.push_back(i); }
+  }
+
+  // Items reach the filter out of order through a farm, and most of them
+  // are discarded
+  template <typename E>
+  void run_discard_sparse(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_in++;
+        if (idx_in < v.size()) return v[idx_in++];
+        else return {};
+      },
+      grppi::farm(4, [](int x) { return x; }),
+      grppi::discard(
+        [this](int x) {
+        invocations_op++;
+        return x % 100 != 0;
+      }),
+      [this](int x) {
+        invocations_out++;
+        w.push_back(x);
+      });
+  }
+
+  void check_ordered_discard_sparse() {
+    EXPECT_EQ(1001, invocations_in);
+    EXPECT_EQ(1000, invocations_op);
+    EXPECT_EQ(10, invocations_out);
+    EXPECT_EQ(expected_even, w);
+  }
+
+  void check_unordered_discard_sparse() {
+    EXPECT_EQ(1001, invocations_in);
+    EXPECT_EQ(1000, invocations_op);
+    EXPECT_EQ(10, invocations_out);
+    sort(begin(w), end(w));
+    EXPECT_EQ(expected_even, w);
+  }
+
 };
 
 // Test for execution policies defined in supported_executions.h
@@ -309,4 +354,48 @@ TYPED_TEST(stream_filter_test, dyn_discard_multiple) //NOLINT
   this->setup_multiple();
   this->run_discard_multiple(this->dyn_execution_);
   this->check_discard_multiple();
-}
\ No newline at end of file
+}
+
+TYPED_TEST(stream_filter_test, static_ordered_discard_sparse) //NOLINT
+{
+  this->setup_sparse();
+  this->execution_.enable_ordering();
+  this->run_discard_sparse(this->execution_);
+  this->check_ordered_discard_sparse();
+}
+
+TYPED_TEST(stream_filter_test, static_unordered_discard_sparse) //NOLINT
+{
+  this->setup_sparse();
+  this->execution_.disable_ordering();
+  this->run_discard_sparse(this->execution_);
+  this->check_unordered_discard_sparse();
+}
+
+TYPED_TEST(stream_filter_test, dyn_discard_sparse) //NOLINT
+{
+  this->setup_sparse();
+  this->run_discard_sparse(this->dyn_execution_);
+  this->check_ordered_discard_sparse();
+}
+
+TEST(sequence_tracker, skipped_ranges) //NOLINT
+{
+  internal::sequence_tracker<char> tracker;
+  vector<pair<char,long>> out;
+  auto emit = [&](char c, long order) { out.emplace_back(c, order); };
+
+  tracker.skip(3, emit);
+  tracker.keep(5, 'f', emit);
+  tracker.skip(2, emit);
+  tracker.skip(4, emit);
+  tracker.keep(1, 'b', emit);
+  EXPECT_TRUE(out.empty());
+
+  tracker.skip(0, emit);
+  EXPECT_EQ((vector<pair<char,long>>{{'b',0}, {'f',1}}), out);
+
+  tracker.keep(6, 'g', emit);
+  EXPECT_EQ((vector<pair<char,long>>{{'b',0}, {'f',1}, {'g',2}}), out);
+  EXPECT_EQ(3, tracker.released());
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/stream_graph.h"
+#include "grppi/stream_filter.h"
+#include "grppi/farm.h"
+#include "grppi/pipeline.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class stream_graph_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> w{};
+  vector<int> archived{};
+  vector<int> analyzed{};
+  vector<pair<int,string>> pairs{};
+  vector<int> branch_counts{};
+
+  // entry counter
+  size_t idx_in = 0;
+
+  // Invocation counter
+  std::atomic<int> invocations_in{0};
+  std::atomic<int> invocations_sk{0};
+
+  void setup_stream() {
+    for (int i=0; i<12; ++i) { v.push_back(i); }
+  }
+
+  auto generator() {
+    return [this]() -> grppi::optional<int> {
+      invocations_in++;
+      if (idx_in < v.size()) { return v[idx_in++]; }
+      return {};
+    };
+  }
+
+  template <typename E>
+  void run_split(const E & e) {
+    grppi::pipeline(e,
+      generator(),
+      grppi::split([](int x) { return x % 2 == 0; },
+        [](int x) { return x * 10; },
+        grppi::pipeline(
+          [](int x) { return x + 1; },
+          [](int x) { return -x; })),
+      [this](int x) {
+        invocations_sk++;
+        w.push_back(x);
+      });
+  }
+
+  void check_split() {
+    EXPECT_EQ(13, invocations_in);
+    EXPECT_EQ(12, invocations_sk);
+    sort(w.begin(), w.end());
+    EXPECT_EQ((vector<int>{-12,-10,-8,-6,-4,-2,0,20,40,60,80,100}), w);
+  }
+
+  template <typename E>
+  void run_round_robin(const E & e) {
+    branch_counts = vector<int>(3, 0);
+    grppi::pipeline(e,
+      generator(),
+      grppi::split(grppi::round_robin(),
+        [](int) { return 0; },
+        [](int) { return 1; },
+        [](int) { return 2; }),
+      [this](int b) {
+        invocations_sk++;
+        branch_counts[b]++;
+      });
+  }
+
+  void check_round_robin() {
+    EXPECT_EQ(13, invocations_in);
+    EXPECT_EQ(12, invocations_sk);
+    EXPECT_EQ((vector<int>{4,4,4}), branch_counts);
+  }
+
+  template <typename E>
+  void run_broadcast(const E & e) {
+    grppi::pipeline(e,
+      generator(),
+      [](int x) { return x * 2; },
+      grppi::broadcast(
+        [this](int x) { archived.push_back(x); },
+        [this](int x) { analyzed.push_back(x); }));
+  }
+
+  void check_broadcast() {
+    EXPECT_EQ(13, invocations_in);
+    vector<int> expected;
+    for (int x : v) { expected.push_back(2*x); }
+    sort(archived.begin(), archived.end());
+    sort(analyzed.begin(), analyzed.end());
+    EXPECT_EQ(expected, archived);
+    EXPECT_EQ(expected, analyzed);
+  }
+
+  template <typename E>
+  void run_merge(const E & e) {
+    grppi::pipeline(e,
+      generator(),
+      grppi::broadcast(
+        [](int x) { return x; },
+        grppi::keep([](int x) { return x < 4; })),
+      [this](int x) {
+        invocations_sk++;
+        w.push_back(x);
+      });
+  }
+
+  void check_merge() {
+    EXPECT_EQ(13, invocations_in);
+    EXPECT_EQ(16, invocations_sk);
+    sort(w.begin(), w.end());
+    EXPECT_EQ((vector<int>{0,0,1,1,2,2,3,3,4,5,6,7,8,9,10,11}), w);
+  }
+
+  template <typename E>
+  void run_zip(const E & e) {
+    grppi::pipeline(e,
+      generator(),
+      grppi::zip(
+        [](int x) { return x * 2; },
+        [](int x) { return to_string(x); }),
+      [this](pair<int,string> p) {
+        invocations_sk++;
+        pairs.push_back(p);
+      });
+  }
+
+  void check_zip() {
+    EXPECT_EQ(13, invocations_in);
+    EXPECT_EQ(12, invocations_sk);
+    vector<pair<int,string>> expected;
+    for (int x : v) { expected.emplace_back(2*x, to_string(x)); }
+    sort(pairs.begin(), pairs.end());
+    sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, pairs);
+  }
+
+  template <typename E>
+  void run_join(const E & e) {
+    grppi::pipeline(e,
+      generator(),
+      grppi::join([](int x) { return x; },
+        grppi::keep([](int x) { return x % 2 == 0; }),
+        grppi::keep([](int x) { return x % 3 == 0; })),
+      [this](pair<int,int> p) {
+        invocations_sk++;
+        EXPECT_EQ(p.first, p.second);
+        w.push_back(p.first);
+      });
+  }
+
+  void check_join() {
+    EXPECT_EQ(13, invocations_in);
+    EXPECT_EQ(2, invocations_sk);
+    sort(w.begin(), w.end());
+    EXPECT_EQ((vector<int>{0,6}), w);
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(stream_graph_test, executions,);
+
+TYPED_TEST(stream_graph_test, static_split) //NOLINT
+{
+  this->setup_stream();
+  this->run_split(this->execution_);
+  this->check_split();
+}
+
+TYPED_TEST(stream_graph_test, dyn_split) //NOLINT
+{
+  this->setup_stream();
+  this->run_split(this->dyn_execution_);
+  this->check_split();
+}
+
+TYPED_TEST(stream_graph_test, static_round_robin) //NOLINT
+{
+  this->setup_stream();
+  this->run_round_robin(this->execution_);
+  this->check_round_robin();
+}
+
+TYPED_TEST(stream_graph_test, dyn_round_robin) //NOLINT
+{
+  this->setup_stream();
+  this->run_round_robin(this->dyn_execution_);
+  this->check_round_robin();
+}
+
+TYPED_TEST(stream_graph_test, static_broadcast) //NOLINT
+{
+  this->setup_stream();
+  this->run_broadcast(this->execution_);
+  this->check_broadcast();
+}
+
+TYPED_TEST(stream_graph_test, dyn_broadcast) //NOLINT
+{
+  this->setup_stream();
+  this->run_broadcast(this->dyn_execution_);
+  this->check_broadcast();
+}
+
+TYPED_TEST(stream_graph_test, static_merge) //NOLINT
+{
+  this->setup_stream();
+  this->run_merge(this->execution_);
+  this->check_merge();
+}
+
+TYPED_TEST(stream_graph_test, dyn_merge) //NOLINT
+{
+  this->setup_stream();
+  this->run_merge(this->dyn_execution_);
+  this->check_merge();
+}
+
+TYPED_TEST(stream_graph_test, static_zip) //NOLINT
+{
+  this->setup_stream();
+  this->run_zip(this->execution_);
+  this->check_zip();
+}
+
+TYPED_TEST(stream_graph_test, dyn_zip) //NOLINT
+{
+  this->setup_stream();
+  this->run_zip(this->dyn_execution_);
+  this->check_zip();
+}
+
+TYPED_TEST(stream_graph_test, static_join) //NOLINT
+{
+  this->setup_stream();
+  this->run_join(this->execution_);
+  this->check_join();
+}
+
+TYPED_TEST(stream_graph_test, dyn_join) //NOLINT
+{
+  this->setup_stream();
+  this->run_join(this->dyn_execution_);
+  this->check_join();
+}
+
+TEST(stream_graph_native, ordered_branches) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  vector<int> evens;
+  vector<int> odds;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      if (idx < 200) { return idx++; }
+      return {};
+    },
+    grppi::split([](int x) { return x % 2 == 0; },
+      grppi::farm(4, [](int x) { return x; }),
+      grppi::pipeline(
+        grppi::farm(4, [](int x) { return x; }),
+        grppi::keep([](int x) { return x % 3 != 0; }))),
+    [&](int x) {
+      if (x % 2 == 0) { evens.push_back(x); }
+      else { odds.push_back(x); }
+    });
+
+  vector<int> expected_evens;
+  vector<int> expected_odds;
+  for (int x=0; x<200; ++x) {
+    if (x % 2 == 0) { expected_evens.push_back(x); }
+    else if (x % 3 != 0) { expected_odds.push_back(x); }
+  }
+  EXPECT_EQ(expected_evens, evens);
+  EXPECT_EQ(expected_odds, odds);
+}
+
+TEST(stream_graph_native, ordered_zip) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  vector<pair<int,int>> pairs;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      if (idx < 200) { return idx++; }
+      return {};
+    },
+    grppi::zip(
+      grppi::farm(4, [](int x) { return x; }),
+      grppi::farm(4, [](int x) { return -x; })),
+    [&](pair<int,int> p) { pairs.push_back(p); });
+
+  vector<pair<int,int>> expected;
+  for (int x=0; x<200; ++x) { expected.emplace_back(x, -x); }
+  EXPECT_EQ(expected, pairs);
+}
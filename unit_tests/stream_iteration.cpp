@@ -13,13 +13,19 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "grppi/pipeline.h"
 #include "grppi/farm.h"
 #include "grppi/stream_iteration.h"
+#include "grppi/stream_reduce.h"
 #include "grppi/dyn/dynamic_execution.h"
 
 #include "supported_executions.h"
@@ -47,6 +53,8 @@ public:
   std::atomic<int> invocations_stage1{0};
   std::atomic<int> invocations_stage2{0};
 
+  vector<pair<int,int>> results{};
+
   template <typename E>
   void run_nested_iteration(const E & e) {
     grppi::pipeline(e,
@@ -106,6 +114,48 @@ public:
     });
   }
 
+  // Items are (id, value) pairs iterated id+1 times, so that replicas
+  // finish them out of order
+  template <typename E>
+  void run_farmed_iteration(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<pair<int,int>> {
+        invocations_gen++;
+        if (count < n) { return pair<int,int>{count++, 0}; }
+        else return {};
+      },
+      grppi::farm(4,
+        grppi::repeat_until(
+          [this](pair<int,int> x) {
+            invocations_oper++;
+            return pair<int,int>{x.first, x.second+1};
+          },
+          [this](pair<int,int> x) {
+            invocations_pred++;
+            return x.second > x.first;
+          })),
+      [this](pair<int,int> x) {
+        invocations_cons++;
+        results.push_back(x);
+      });
+  }
+
+  void setup_farmed() {
+    n = 50;
+    count = 0;
+  }
+
+  void check_farmed() {
+    EXPECT_EQ(51, invocations_gen);
+    EXPECT_EQ(1275, invocations_oper);
+    EXPECT_EQ(1275, invocations_pred);
+    EXPECT_EQ(50, invocations_cons);
+    sort(results.begin(), results.end());
+    for (int i=0; i<n; ++i) {
+      EXPECT_EQ((pair<int,int>{i,i+1}), results[i]);
+    }
+  }
+
   void setup_no_composed() {
     out = 0;
     n = 5;
@@ -166,7 +216,6 @@ TYPED_TEST(stream_iteration_test, dyn_no_composed) //NOLINT
   this->check_no_composed();
 }
 
-/*
 TYPED_TEST(stream_iteration_test, static_composed_pipeline) //NOLINT
 {
   this->setup_composed_pipeline();
@@ -179,9 +228,23 @@ TYPED_TEST(stream_iteration_test, dyn_composed_pipeline) //NOLINT
   this->setup_composed_pipeline();
   this->run_nested_iteration_pipeline(this->dyn_execution_);
   this->check_composed_pipeline();
+}
+
+TYPED_TEST(stream_iteration_test, static_farmed) //NOLINT
+{
+  this->setup_farmed();
+  this->run_farmed_iteration(this->execution_);
+  this->check_farmed();
+}
 
+TYPED_TEST(stream_iteration_test, dyn_farmed) //NOLINT
+{
+  this->setup_farmed();
+  this->run_farmed_iteration(this->dyn_execution_);
+  this->check_farmed();
 }
 
+/*
 TYPED_TEST(stream_iteration_test, static_composed_farm) //NOLINT
 {
   this->setup_composed_farm();
@@ -243,3 +306,66 @@ TYPED_TEST(stream_iteration_test, dyn_composed_farm) //NOLINT
 }
 */
 
+TEST(stream_iteration_native, ordered_farmed) //NOLINT
+{
+  parallel_execution_native ex{4, true};
+  vector<int> w;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      if (idx < 100) { return idx++; }
+      else return {};
+    },
+    grppi::farm(4,
+      grppi::repeat_until(
+        [](int x) { return x + 1000; },
+        [](int x) { return x / 1000 > (x % 1000) % 7; })),
+    [&](int x) { w.push_back(x); });
+
+  ASSERT_EQ(100u, w.size());
+  for (int i=0; i<100; ++i) {
+    EXPECT_EQ(i + 1000 * (i % 7 + 1), w[i]);
+  }
+}
+
+template <typename E>
+void check_farmed_windows(const E & ex) {
+  vector<int> w;
+  int idx = 0;
+  grppi::pipeline(ex,
+    [&]() -> grppi::optional<int> {
+      if (idx < 40) { return idx++; }
+      else return {};
+    },
+    grppi::farm(4,
+      grppi::repeat_until(
+        [](int x) {
+          // Uneven work so that replicas finish out of order
+          std::this_thread::sleep_for(std::chrono::microseconds{
+              (x % 1000) % 5 * 300});
+          return x + 1000;
+        },
+        [](int x) { return x / 1000 > (x % 1000) % 7; })),
+    // Windows depend on the order of their items
+    grppi::reduce(2, 2, 0, [](int x, int y) { return x * 2 + y; }),
+    [&](int x) { w.push_back(x); });
+
+  ASSERT_EQ(20u, w.size());
+  for (int i=0; i<20; ++i) {
+    auto a = 2*i + 1000 * ((2*i) % 7 + 1);
+    auto b = 2*i + 1 + 1000 * ((2*i + 1) % 7 + 1);
+    EXPECT_EQ((0 * 2 + a) * 2 + b, w[i]);
+  }
+}
+
+TEST(stream_iteration_native, ordered_farmed_windows) //NOLINT
+{
+  check_farmed_windows(parallel_execution_native{4, true});
+}
+
+#ifdef GRPPI_OMP
+TEST(stream_iteration_omp, ordered_farmed_windows) //NOLINT
+{
+  check_farmed_windows(parallel_execution_omp{4, true});
+}
+#endif
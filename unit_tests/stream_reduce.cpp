@@ -13,11 +13,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "grppi/pipeline.h"
+#include "grppi/farm.h"
 #include "grppi/stream_reduce.h"
 #include "grppi/dyn/dynamic_execution.h"
 
@@ -26,6 +32,11 @@
 using namespace std;
 using namespace grppi;
 
+struct reading {
+  chrono::milliseconds time;
+  int count;
+};
+
 template <typename T>
 class stream_reduce_test : public ::testing::Test {
 public:
@@ -36,6 +47,11 @@ public:
   int out{};
   int window{};
   int offset{};
+  vector<string> words{};
+  chrono::milliseconds time_window{};
+  chrono::milliseconds time_slide{};
+  chrono::milliseconds lateness{};
+  vector<int> counts{};
 
   // Vectors
   vector<int> v{};
@@ -65,6 +81,179 @@ public:
     });
   }
 
+  template <typename E>
+  void run_reduction_add_sub(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return problem;
+      }
+      else return {};
+    },
+    grppi::reduce(window, offset, 0,
+      [](int x, int y) { return x+y; },
+      [](int x, int y) { return x-y; }),
+    [this](int x) { 
+      invocations_reduce++;
+      out += x;
+    });
+  }
+
+  template <typename E>
+  void run_reduction_max(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return problem;
+      }
+      else return {};
+    },
+    grppi::reduce(window, offset, 0,
+      [](int x, int y) { return std::max(x,y); }),
+    [this](int x) { 
+      invocations_reduce++;
+      out += x;
+    });
+  }
+
+  template <typename E>
+  void run_reduction_concat(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<string> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return string(1, 'a' + problem);
+      }
+      else return {};
+    },
+    grppi::reduce(window, offset, string{},
+      [](string x, const string & y) { return x+y; }),
+    [this](string x) { 
+      invocations_reduce++;
+      words.push_back(x);
+    });
+  }
+
+  template <typename E>
+  void run_farmed_reduction_add(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return problem;
+      }
+      else return {};
+    },
+    grppi::farm(3, grppi::reduce(window, offset, 0,
+      [](int x, int y) { return x+y; })),
+    [this](int x) { 
+      invocations_reduce++;
+      out += x;
+    });
+  }
+
+  template <typename E>
+  void run_farmed_reduction_concat(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<string> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return string(1, 'a' + problem);
+      }
+      else return {};
+    },
+    grppi::farm(3, grppi::reduce(window, offset, string{},
+      [](string x, const string & y) { return x+y; })),
+    [this](string x) { 
+      invocations_reduce++;
+      words.push_back(x);
+    });
+  }
+
+  template <typename E>
+  void run_farmed_reduction_chain(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<int> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return problem;
+      }
+      else return {};
+    },
+    // Uneven costs make replicas finish windows out of order
+    grppi::farm(4, grppi::reduce(window, offset, 0,
+      [](int x, int y) {
+        this_thread::sleep_for(chrono::microseconds{(y % 3) * 300});
+        return x+y; 
+      })),
+    grppi::reduce(2, 2, 0, [](int x, int y) { return x*1000 + y; }),
+    [this](int x) { 
+      invocations_reduce++;
+      counts.push_back(x);
+    });
+  }
+
+  template <typename E>
+  void run_time_reduction(const E & e) {
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<reading> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return reading{chrono::milliseconds{problem}, 1};
+      }
+      else return {};
+    },
+    grppi::time_reduce(time_window, time_slide, lateness, reading{},
+      [](reading x, const reading & y) { 
+        return reading{x.time, x.count + y.count}; 
+      },
+      [](const reading & x) { return x.time; }),
+    [this](reading x) { 
+      invocations_reduce++;
+      counts.push_back(x.count);
+    });
+  }
+
+  template <typename E>
+  void run_time_point_reduction(const E & e) {
+    using time_point = chrono::steady_clock::time_point;
+    grppi::pipeline(e,
+      [this]() -> grppi::optional<reading> {
+        invocations_gen++; 
+        if(v.size() > 0){
+          auto problem = v.back();
+          v.pop_back();
+          return reading{chrono::milliseconds{problem}, 1};
+      }
+      else return {};
+    },
+    grppi::time_reduce(time_window, time_slide, lateness, reading{},
+      [](reading x, const reading & y) { 
+        return reading{x.time, x.count + y.count}; 
+      },
+      [](const reading & x) { return time_point{x.time}; }),
+    [this](reading x) { 
+      invocations_reduce++;
+      counts.push_back(x.count);
+    });
+  }
+
   void setup_empty() {
     window = 3;
     offset = 3;
@@ -128,6 +317,91 @@ public:
     EXPECT_EQ(3, invocations_reduce);
     EXPECT_EQ(33, this->out);
   }
+
+  void setup_sliding() {
+    out = 0;
+    v = vector<int>{1,2,3,4,5,6,7,8,9,10};
+    window = 3;
+    offset = 1;
+  }
+
+  void check_sliding_sum() {
+    EXPECT_EQ(11, invocations_gen);
+    EXPECT_EQ(8, invocations_reduce);
+    EXPECT_EQ(132, this->out);
+  }
+
+  void check_sliding_max() {
+    EXPECT_EQ(11, invocations_gen);
+    EXPECT_EQ(8, invocations_reduce);
+    EXPECT_EQ(52, this->out);
+  }
+
+  void setup_concat() {
+    v = vector<int>{7,6,5,4,3,2,1,0};
+    window = 3;
+    offset = 2;
+  }
+
+  void check_concat() {
+    EXPECT_EQ(9, invocations_gen);
+    EXPECT_EQ(3, invocations_reduce);
+    sort(words.begin(), words.end());
+    EXPECT_EQ((vector<string>{"abc", "cde", "efg"}), words);
+  }
+
+  void setup_farmed_concat() {
+    v = vector<int>{11,10,9,8,7,6,5,4,3,2,1,0};
+    window = 3;
+    offset = 2;
+  }
+
+  void check_farmed_concat() {
+    EXPECT_EQ(13, invocations_gen);
+    EXPECT_EQ(5, invocations_reduce);
+    EXPECT_EQ((vector<string>{"abc", "cde", "efg", "ghi", "ijk"}), words);
+  }
+
+  void setup_farmed_chain() {
+    v.resize(40);
+    for (int i=0; i<40; ++i) { v[i] = 39-i; }
+    window = 2;
+    offset = 2;
+  }
+
+  void check_farmed_chain() {
+    EXPECT_EQ(41, invocations_gen);
+    ASSERT_EQ(10u, counts.size());
+    for (int i=0; i<10; ++i) {
+      EXPECT_EQ((8*i+1)*1000 + (8*i+5), counts[i]);
+    }
+  }
+
+  void setup_tumbling_time() {
+    v = vector<int>{31,27,15,12,9,4,1};
+    time_window = chrono::milliseconds{10};
+    time_slide = chrono::milliseconds{10};
+    lateness = chrono::milliseconds{0};
+  }
+
+  void check_tumbling_time() {
+    EXPECT_EQ(8, invocations_gen);
+    EXPECT_EQ(4, invocations_reduce);
+    EXPECT_EQ((vector<int>{3,2,1,1}), counts);
+  }
+
+  void setup_sliding_time() {
+    v = vector<int>{1,25,9,15,4,12,6,7,3,1};
+    time_window = chrono::milliseconds{10};
+    time_slide = chrono::milliseconds{5};
+    lateness = chrono::milliseconds{2};
+  }
+
+  void check_sliding_time() {
+    EXPECT_EQ(11, invocations_gen);
+    EXPECT_EQ(7, invocations_reduce);
+    EXPECT_EQ((vector<int>{2,4,4,2,1,1,1}), counts);
+  }
 };
 
 // Test for execution policies defined in supported_executions.h
@@ -207,3 +481,129 @@ TYPED_TEST(stream_reduce_test, dyn_offset_window) //NOLINT
   this->run_reduction_add(this->dyn_execution_);
   this->check_offset_window();
 }
+
+TYPED_TEST(stream_reduce_test, static_sliding_inverse) //NOLINT
+{
+  this->setup_sliding();
+  this->run_reduction_add_sub(this->execution_);
+  this->check_sliding_sum();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_sliding_inverse) //NOLINT
+{
+  this->setup_sliding();
+  this->run_reduction_add_sub(this->dyn_execution_);
+  this->check_sliding_sum();
+}
+
+TYPED_TEST(stream_reduce_test, static_sliding_max) //NOLINT
+{
+  this->setup_sliding();
+  this->run_reduction_max(this->execution_);
+  this->check_sliding_max();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_sliding_max) //NOLINT
+{
+  this->setup_sliding();
+  this->run_reduction_max(this->dyn_execution_);
+  this->check_sliding_max();
+}
+
+TYPED_TEST(stream_reduce_test, static_sliding_concat) //NOLINT
+{
+  this->setup_concat();
+  this->run_reduction_concat(this->execution_);
+  this->check_concat();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_sliding_concat) //NOLINT
+{
+  this->setup_concat();
+  this->run_reduction_concat(this->dyn_execution_);
+  this->check_concat();
+}
+
+TYPED_TEST(stream_reduce_test, static_farmed_sliding) //NOLINT
+{
+  this->setup_sliding();
+  this->run_farmed_reduction_add(this->execution_);
+  this->check_sliding_sum();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_farmed_sliding) //NOLINT
+{
+  this->setup_sliding();
+  this->run_farmed_reduction_add(this->dyn_execution_);
+  this->check_sliding_sum();
+}
+
+TYPED_TEST(stream_reduce_test, static_farmed_offset_window) //NOLINT
+{
+  this->setup_offset_window();
+  this->run_farmed_reduction_add(this->execution_);
+  this->check_offset_window();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_farmed_offset_window) //NOLINT
+{
+  this->setup_offset_window();
+  this->run_farmed_reduction_add(this->dyn_execution_);
+  this->check_offset_window();
+}
+
+TYPED_TEST(stream_reduce_test, static_farmed_ordered_concat) //NOLINT
+{
+  this->setup_farmed_concat();
+  this->run_farmed_reduction_concat(this->execution_);
+  this->check_farmed_concat();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_farmed_ordered_concat) //NOLINT
+{
+  this->setup_farmed_concat();
+  this->run_farmed_reduction_concat(this->dyn_execution_);
+  this->check_farmed_concat();
+}
+
+TYPED_TEST(stream_reduce_test, static_farmed_ordered_chain) //NOLINT
+{
+  this->setup_farmed_chain();
+  this->run_farmed_reduction_chain(this->execution_);
+  this->check_farmed_chain();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_farmed_ordered_chain) //NOLINT
+{
+  this->setup_farmed_chain();
+  this->run_farmed_reduction_chain(this->dyn_execution_);
+  this->check_farmed_chain();
+}
+
+TYPED_TEST(stream_reduce_test, static_tumbling_time) //NOLINT
+{
+  this->setup_tumbling_time();
+  this->run_time_reduction(this->execution_);
+  this->check_tumbling_time();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_tumbling_time) //NOLINT
+{
+  this->setup_tumbling_time();
+  this->run_time_reduction(this->dyn_execution_);
+  this->check_tumbling_time();
+}
+
+TYPED_TEST(stream_reduce_test, static_sliding_time) //NOLINT
+{
+  this->setup_sliding_time();
+  this->run_time_point_reduction(this->execution_);
+  this->check_sliding_time();
+}
+
+TYPED_TEST(stream_reduce_test, dyn_sliding_time) //NOLINT
+{
+  this->setup_sliding_time();
+  this->run_time_point_reduction(this->dyn_execution_);
+  this->check_sliding_time();
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+#include "grppi/seq/sequential_execution.h"
+#include "grppi/native/parallel_execution_native.h"
+#include "grppi/pipeline.h"
+#include "grppi/farm.h"
+#include "grppi/reduce.h"
+#include "grppi/mapreduce.h"
+
+using namespace std;
+using namespace grppi;
+
+namespace {
+
+// Builds a fake sysfs tree with 2 sockets, each with 2 L3 caches of 2 CPUs
+class fake_sysfs {
+public:
+  fake_sysfs() {
+    char pattern[] = "/tmp/grppi_topologyXXXXXX";
+    root_ = ::mkdtemp(pattern);
+    for (int cpu = 0; cpu < 8; ++cpu) {
+      const auto dir = root_ + "/cpu" + to_string(cpu);
+      make_dir(dir);
+      make_dir(dir + "/topology");
+      make_dir(dir + "/cache");
+      make_dir(dir + "/cache/index3");
+      // Sockets are interleaved, as found in many two socket systems
+      ofstream{dir + "/topology/physical_package_id"} << cpu % 2 << "\n";
+      const int first = (cpu % 4 < 2) ? cpu % 2 : cpu % 2 + 2;
+      ofstream{dir + "/cache/index3/shared_cpu_list"} 
+          << first << "," << first + 4 << "\n";
+    }
+  }
+
+  ~fake_sysfs() {
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  const string & root() const { return root_; }
+
+private:
+  static void make_dir(const string & path) { ::mkdir(path.c_str(), 0700); }
+
+  string root_;
+};
+
+}
+
+TEST(topology, discovery) //NOLINT
+{
+  fake_sysfs sysfs;
+  internal::cpu_topology topology{sysfs.root(), {0,1,2,3,4,5,6,7}};
+  ASSERT_EQ(4, topology.domain_count());
+  EXPECT_EQ((vector<int>{0,4}), topology.domain(0));
+  EXPECT_EQ((vector<int>{2,6}), topology.domain(1));
+  EXPECT_EQ((vector<int>{1,5}), topology.domain(2));
+  EXPECT_EQ((vector<int>{3,7}), topology.domain(3));
+}
+
+TEST(topology, discovery_subset) //NOLINT
+{
+  fake_sysfs sysfs;
+  internal::cpu_topology topology{sysfs.root(), {0,2,4}};
+  ASSERT_EQ(2, topology.domain_count());
+  EXPECT_EQ((vector<int>{0,4}), topology.domain(0));
+  EXPECT_EQ((vector<int>{2}), topology.domain(1));
+}
+
+TEST(topology, discovery_missing) //NOLINT
+{
+  internal::cpu_topology topology{"/nonexistent", {0,1,2}};
+  ASSERT_EQ(1, topology.domain_count());
+  EXPECT_EQ((vector<int>{0,1,2}), topology.domain(0));
+
+  internal::cpu_topology empty{"/nonexistent", {}};
+  ASSERT_EQ(1, empty.domain_count());
+  EXPECT_EQ((vector<int>{0,1}), empty.worker_groups(1));
+  EXPECT_TRUE(empty.worker_cpus(4).empty());
+}
+
+TEST(topology, worker_groups) //NOLINT
+{
+  fake_sysfs sysfs;
+  internal::cpu_topology topology{sysfs.root(), {0,1,2,3,4,5,6,7}};
+  EXPECT_EQ((vector<int>{0,2,4,6,8}), topology.worker_groups(8));
+  EXPECT_EQ((vector<int>{0,4,8,12,16}), topology.worker_groups(16));
+  EXPECT_EQ((vector<int>{0,0,1,2,3}), topology.worker_groups(3));
+  EXPECT_EQ(2, internal::worker_group(topology.worker_groups(8), 5));
+  EXPECT_EQ(1, internal::worker_group(topology.worker_groups(3), 0));
+
+  EXPECT_EQ((vector<int>{0,4,2,6,1,5,3,7}), topology.worker_cpus(8));
+  EXPECT_EQ((vector<int>{2,1,3}), topology.worker_cpus(3));
+  EXPECT_EQ((vector<int>{0,4,0,2,6,2,1,5,1,3,7,3}), 
+      topology.worker_cpus(12));
+}
+
+TEST(topology, domain_combiner_order) //NOLINT
+{
+  vector<string> partials{"a","b","c","d","e","f","g","h"};
+  auto combine = [](string x, const string & y) { return x + y; };
+  auto combiner = internal::make_domain_combiner(partials, 
+      vector<int>{0,3,3,8}, combine);
+
+  vector<thread> workers;
+  for (int i = 7; i >= 0; --i) {
+    workers.emplace_back([&combiner,i]() { combiner.done(i); });
+  }
+  for (auto & w : workers) { w.join(); }
+
+  EXPECT_EQ("abc", partials[0]);
+  EXPECT_EQ("defgh", partials[3]);
+  EXPECT_EQ("abcdefgh", combiner.result());
+}
+
+TEST(topology, domain_combiner_single_group) //NOLINT
+{
+  vector<int> partials{1,2,3,4};
+  auto combine = [](int x, int y) { return x + y; };
+  auto combiner = internal::make_domain_combiner(partials, 
+      vector<int>{0,4}, combine);
+  for (int i = 0; i < 4; ++i) { combiner.done(i); }
+  EXPECT_EQ((vector<int>{1,2,3,4}), partials);
+  EXPECT_EQ(10, combiner.result());
+}
+
+TEST(topology, native_reduce) //NOLINT
+{
+  parallel_execution_native ex{6};
+  EXPECT_FALSE(ex.is_topology_aware());
+  ex.enable_topology_awareness();
+  auto copy = ex;
+  EXPECT_TRUE(copy.is_topology_aware());
+
+  vector<string> v(100);
+  for (int i = 0; i < 100; ++i) { v[i] = to_string(i % 10); }
+  auto result = grppi::reduce(ex, v, string{},
+      [](string x, const string & y) { return x + y; });
+  EXPECT_EQ(accumulate(v.begin(), v.end(), string{}), result);
+
+  vector<int> w(1000);
+  iota(w.begin(), w.end(), 0);
+  auto sum = grppi::map_reduce(ex, w, 0L,
+      [](int x) { return 2L*x; },
+      [](long x, long y) { return x + y; });
+  EXPECT_EQ(999L*1000L, sum);
+}
+
+TEST(topology, native_farm) //NOLINT
+{
+  parallel_execution_native ex{4};
+  ex.enable_topology_awareness();
+
+  int produced = 0;
+  vector<int> output;
+  grppi::pipeline(ex,
+      [&produced]() -> grppi::optional<int> {
+        if (produced < 100) return produced++;
+        return {};
+      },
+      grppi::farm(6, [](int x) { return 2*x; }),
+      [&output](int x) { output.push_back(x); });
+  ASSERT_EQ(100u, output.size());
+  for (int i = 0; i < 100; ++i) { EXPECT_EQ(2*i, output[i]); }
+
+  produced = 0;
+  atomic<long> total{0};
+  grppi::pipeline(ex,
+      [&produced]() -> grppi::optional<int> {
+        if (produced < 100) return produced++;
+        return {};
+      },
+      grppi::farm(6, [&total](int x) { total += x; }));
+  EXPECT_EQ(99L*100L/2, total);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2018 Universidad Carlos III de Madrid
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "grppi/worker_local.h"
+#include "grppi/map.h"
+#include "grppi/reduce.h"
+#include "grppi/dyn/dynamic_execution.h"
+
+#include "supported_executions.h"
+
+using namespace std;
+using namespace grppi;
+
+template <typename T>
+class worker_local_test : public ::testing::Test {
+public:
+  T execution_{};
+  dynamic_execution dyn_execution_{execution_};
+
+  // Vectors
+  vector<int> v{};
+  vector<int> w{};
+
+  // Invocation counter
+  std::atomic<int> invocations_init{0};
+
+  void setup_empty() {}
+
+  void setup_multiple() {
+    v = vector<int>(1000);
+    iota(v.begin(), v.end(), 0);
+    w = vector<int>(1000);
+  }
+
+  template <typename E>
+  void run_sum(const E & e) {
+    worker_local<long> sums{[this]() { invocations_init++; return 0L; }};
+    grppi::map(e, v, w, [&sums](int x) {
+      sums.local() += x;
+      return x;
+    });
+    EXPECT_EQ(static_cast<int>(sums.size()), invocations_init.load());
+    if (!v.empty()) { EXPECT_LE(1u, sums.size()); }
+    EXPECT_EQ(accumulate(v.begin(), v.end(), 0L), 
+        sums.combine([](long x, long y) { return x + y; }));
+  }
+
+  template <typename E>
+  void run_buffers(const E & e) {
+    worker_local<vector<int>> buffers;
+    grppi::map(e, v, w, [&buffers](int x) {
+      auto & buffer = buffers.local();
+      buffer.push_back(x);
+      return 2*x;
+    });
+
+    vector<int> seen;
+    buffers.for_each([&seen](const vector<int> & b) {
+      seen.insert(seen.end(), b.begin(), b.end());
+    });
+    sort(seen.begin(), seen.end());
+    EXPECT_EQ(v, seen);
+    for (std::size_t i = 0; i < v.size(); ++i) { EXPECT_EQ(2*v[i], w[i]); }
+  }
+
+  template <typename E>
+  void run_clear(const E & e) {
+    worker_local<int> counts{[this]() { invocations_init++; return 0; }};
+    for (int round = 0; round < 2; ++round) {
+      grppi::map(e, v, w, [&counts](int x) {
+        counts.local()++;
+        return x;
+      });
+      EXPECT_EQ(static_cast<int>(v.size()), 
+          counts.combine([](int x, int y) { return x + y; }));
+      counts.clear();
+      EXPECT_EQ(0u, counts.size());
+    }
+  }
+};
+
+// Test for execution policies defined in supported_executions.h
+TYPED_TEST_SUITE(worker_local_test, executions,);
+
+TYPED_TEST(worker_local_test, static_empty_sum) //NOLINT
+{
+  this->setup_empty();
+  this->run_sum(this->execution_);
+}
+
+TYPED_TEST(worker_local_test, dyn_empty_sum) //NOLINT
+{
+  this->setup_empty();
+  this->run_sum(this->dyn_execution_);
+}
+
+TYPED_TEST(worker_local_test, static_multiple_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sum(this->execution_);
+}
+
+TYPED_TEST(worker_local_test, dyn_multiple_sum) //NOLINT
+{
+  this->setup_multiple();
+  this->run_sum(this->dyn_execution_);
+}
+
+TYPED_TEST(worker_local_test, static_multiple_buffers) //NOLINT
+{
+  this->setup_multiple();
+  this->run_buffers(this->execution_);
+}
+
+TYPED_TEST(worker_local_test, dyn_multiple_buffers) //NOLINT
+{
+  this->setup_multiple();
+  this->run_buffers(this->dyn_execution_);
+}
+
+TYPED_TEST(worker_local_test, static_multiple_clear) //NOLINT
+{
+  this->setup_multiple();
+  this->run_clear(this->execution_);
+}
+
+TYPED_TEST(worker_local_test, dyn_multiple_clear) //NOLINT
+{
+  this->setup_multiple();
+  this->run_clear(this->dyn_execution_);
+}
+
+TEST(worker_local, threads) //NOLINT
+{
+  worker_local<int> ids{[]() { return -1; }};
+  vector<thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&ids,i]() {
+      EXPECT_EQ(-1, ids.local());
+      ids.local() = i;
+      EXPECT_EQ(i, ids.local());
+    });
+  }
+  for (auto & t : threads) { t.join(); }
+  EXPECT_EQ(4u, ids.size());
+  vector<int> values;
+  ids.for_each([&values](int x) { values.push_back(x); });
+  sort(values.begin(), values.end());
+  EXPECT_EQ((vector<int>{0,1,2,3}), values);
+
+  worker_local<int> a, b;
+  a.local() = 1;
+  b.local() = 2;
+  EXPECT_EQ(1, a.local());
+  EXPECT_EQ(2, b.local());
+}